@@ -0,0 +1,397 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Generator.h"
+#include "GraphFile.h"
+#include "ThreadPool.h"
+
+using namespace generator;
+using graph::Edge;
+using graph::Vertex;
+using graph::GraphFormat;
+
+// blocks in flight per thread while writing
+static constexpr size_t BLOCKS_PER_THREAD = 4;
+
+// bytes of vertex names gathered before they're written out
+static constexpr size_t JSON_FLUSH_BYTES = 1ull << 20;
+
+// R-MAT cells drawn for one edge before giving up, only a tiny b + c gets anywhere near it
+static constexpr uint64_t RMAT_MAX_DRAWS = 1ull << 16;
+
+static const Model NAMED_MODELS[] = { Model::ErdosRenyi, Model::RMat, Model::LayeredDag, Model::PlantedCycles };
+
+namespace
+{
+	// SplitMix64, tiny state and good enough for graphs
+	struct Random
+	{
+		uint64_t state;
+
+		uint64_t next()
+		{
+			uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31);
+		}
+
+		// [0, bound) for bound up to 2^32, by multiplying instead of dividing
+		uint64_t below(uint64_t bound) { return ((next() >> 32) * bound) >> 32; }
+
+		// [0, 1)
+		double unit() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+	};
+
+	// vertex indices of the layers, [begin(l), begin(l + 1)) all hold at least one vertex
+	struct Layers
+	{
+		uint64_t vertices, count;
+
+		uint64_t begin(uint64_t layer) const { return layer * vertices / count; }
+
+		uint64_t of(uint64_t v) const
+		{
+			uint64_t layer = v * count / vertices;
+			while (begin(layer + 1) <= v)
+				layer++;
+			while (begin(layer) > v)
+				layer--;
+
+			return layer;
+		}
+	};
+}
+
+const char* generator::modelName(Model model)
+{
+	switch (model)
+	{
+	case Model::ErdosRenyi: return "erdos-renyi";
+	case Model::RMat: return "rmat";
+	case Model::LayeredDag: return "layered-dag";
+	case Model::PlantedCycles: return "planted-cycles";
+	default: return "unknown";
+	}
+}
+
+bool generator::parseModel(const char* name, Model& model)
+{
+	for (Model candidate : NAMED_MODELS)
+	{
+		if (std::strcmp(name, modelName(candidate)) == 0)
+		{
+			model = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void generator::validate(const Parameters& params)
+{
+	if (params.vertices < 2 || params.vertices > std::numeric_limits<Vertex>::max())
+		throw std::invalid_argument("Invalid argument: Vertex count has to be in [2, 2^32 - 1]");
+
+	switch (params.model)
+	{
+	case Model::RMat:
+		if (params.a < 0 || params.b < 0 || params.c < 0 || params.a + params.b + params.c > 1)
+			throw std::invalid_argument("Invalid argument: R-MAT probabilities have to be non-negative and add up to at most 1");
+
+		// a and d keep both endpoints in the same half, with nothing else every cell is a self loop
+		if (params.b + params.c <= 0)
+			throw std::invalid_argument("Invalid argument: R-MAT needs b or c above 0 to make edges between distinct vertices");
+		break;
+	case Model::LayeredDag:
+		if (params.layers < 2 || params.layers > params.vertices)
+			throw std::invalid_argument("Invalid argument: Layer count has to be in [2, vertex count]");
+		break;
+	case Model::PlantedCycles:
+		if (params.cycleLength < 2 || params.cycles > params.vertices / params.cycleLength)
+			throw std::invalid_argument("Invalid argument: Cycles need at least 2 vertices each and can't share them");
+		break;
+	default:
+		break;
+	}
+}
+
+static uint64_t cycleEdgeCount(const Parameters& params)
+{
+	return params.model == Model::PlantedCycles ? params.cycles * params.cycleLength : 0;
+}
+
+uint64_t generator::edgeCount(const Parameters& params)
+{
+	return params.edges + cycleEdgeCount(params);
+}
+
+uint64_t generator::blockCount(const Parameters& params)
+{
+	return (edgeCount(params) + BLOCK_EDGES - 1) / BLOCK_EDGES;
+}
+
+// quadrant by quadrant down to a single cell, cells outside the graph are drawn again
+static Edge rmatEdge(const Parameters& params, unsigned scale, Random& random)
+{
+	for (uint64_t draw = 0; draw < RMAT_MAX_DRAWS; draw++)
+	{
+		uint64_t from = 0, to = 0;
+		for (unsigned bit = 0; bit < scale; bit++)
+		{
+			double r = random.unit();
+			from <<= 1;
+			to <<= 1;
+
+			if (r >= params.a + params.b + params.c)
+			{
+				from |= 1;
+				to |= 1;
+			}
+			else if (r >= params.a + params.b)
+				from |= 1;
+			else if (r >= params.a)
+				to |= 1;
+		}
+
+		if (from < params.vertices && to < params.vertices && from != to)
+			return { static_cast<Vertex>(from), static_cast<Vertex>(to) };
+	}
+
+	throw std::runtime_error("R-MAT keeps drawing self loops, b and c are too small");
+}
+
+// from a lower vertex to a higher one
+static Edge forwardEdge(const Parameters& params, Random& random)
+{
+	while (true)
+	{
+		uint64_t from = random.below(params.vertices), to = random.below(params.vertices);
+		if (from != to)
+			return { static_cast<Vertex>(std::min(from, to)), static_cast<Vertex>(std::max(from, to)) };
+	}
+}
+
+void generator::generateBlock(const Parameters& params, uint64_t block, std::vector<Edge>& out)
+{
+	uint64_t begin = block * BLOCK_EDGES;
+	uint64_t end = std::min(edgeCount(params), begin + BLOCK_EDGES);
+	out.clear();
+
+	Random seeder{ params.seed ^ (block * 0xd1b54a32d192ed03ull) };
+	Random random{ seeder.next() };
+
+	unsigned scale = static_cast<unsigned>(std::bit_width(params.vertices - 1));
+	Layers layers{ params.vertices, params.layers };
+	uint64_t cycleEdges = cycleEdgeCount(params);
+
+	for (uint64_t e = begin; e < end; e++)
+	{
+		switch (params.model)
+		{
+		case Model::ErdosRenyi:
+		{
+			// the target skips the source, so there are no self loops to draw again
+			uint64_t from = random.below(params.vertices);
+			uint64_t to = random.below(params.vertices - 1);
+			out.push_back({ static_cast<Vertex>(from), static_cast<Vertex>(to + (to >= from)) });
+			break;
+		}
+		case Model::RMat:
+			out.push_back(rmatEdge(params, scale, random));
+			break;
+		case Model::LayeredDag:
+		{
+			uint64_t from = random.below(layers.begin(params.layers - 1));
+			uint64_t targets = layers.begin(layers.of(from) + 1);
+			out.push_back({ static_cast<Vertex>(from), static_cast<Vertex>(targets + random.below(params.vertices - targets)) });
+			break;
+		}
+		case Model::PlantedCycles:
+		{
+			// the closing edge of a cycle is the only one leading to a lower vertex,
+			// so every other edge stays out of cycles
+			if (e < cycleEdges)
+			{
+				uint64_t first = e - e % params.cycleLength;
+				uint64_t next = e + 1 == first + params.cycleLength ? first : e + 1;
+				out.push_back({ static_cast<Vertex>(e), static_cast<Vertex>(next) });
+			}
+			else
+				out.push_back(forwardEdge(params, random));
+			break;
+		}
+		}
+	}
+}
+
+static void appendNumber(std::string& text, uint64_t value)
+{
+	char digits[20];
+	auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+	text.append(digits, end);
+}
+
+static void formatBlock(GraphFormat format, uint64_t block, const std::vector<Edge>& edges, std::string& text)
+{
+	text.clear();
+
+	for (size_t i = 0; i < edges.size(); i++)
+	{
+		const Edge& edge = edges[i];
+
+		switch (format)
+		{
+		case GraphFormat::Json:
+			text.append(block == 0 && i == 0 ? "\n\t\t{ \"from\": \"" : ",\n\t\t{ \"from\": \"");
+			appendNumber(text, edge.from);
+			text.append("\", \"to\": \"");
+			appendNumber(text, edge.to);
+			text.append("\" }");
+			break;
+		case GraphFormat::MatrixMarket:
+			appendNumber(text, uint64_t(edge.from) + 1);
+			text.push_back(' ');
+			appendNumber(text, uint64_t(edge.to) + 1);
+			text.push_back('\n');
+			break;
+		default:
+			appendNumber(text, edge.from);
+			text.push_back(format == GraphFormat::Csv ? ',' : format == GraphFormat::Tsv ? '\t' : ' ');
+			appendNumber(text, edge.to);
+			text.push_back('\n');
+			break;
+		}
+	}
+}
+
+// calls emit(block, edges) for every block in order, making a round of them in parallel at a time
+template <typename Make, typename Emit>
+static void forEachBlockRound(const Parameters& params, Make&& make, Emit&& emit)
+{
+	uint64_t blocks = blockCount(params);
+	size_t round = std::max<size_t>(linear_algebra::getThreadCount() * BLOCKS_PER_THREAD, 1);
+
+	for (uint64_t first = 0; first < blocks; first += round)
+	{
+		size_t count = static_cast<size_t>(std::min<uint64_t>(round, blocks - first));
+		linear_algebra::forEachRowBlock(count, 1, count > 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				make(i, first + i);
+		});
+
+		for (size_t i = 0; i < count; i++)
+			emit(i);
+	}
+}
+
+void generator::writeGraph(const Parameters& params, GraphFormat format, std::ostream& output)
+{
+	validate(params);
+
+	if (format == GraphFormat::Binary || format == GraphFormat::Auto)
+		throw std::invalid_argument("Invalid argument: Only text formats can be streamed");
+
+	if (format == GraphFormat::MatrixMarket)
+		output << "%%MatrixMarket matrix coordinate pattern general\n" << params.vertices << ' ' << params.vertices << ' ' << edgeCount(params) << '\n';
+
+	if (format == GraphFormat::Json)
+	{
+		std::string names = "{\n\t\"vertices\": [";
+		for (uint64_t v = 0; v < params.vertices; v++)
+		{
+			names.append(v ? ", \"" : " \"");
+			appendNumber(names, v);
+			names.push_back('"');
+
+			if (names.size() >= JSON_FLUSH_BYTES)
+			{
+				output << names;
+				names.clear();
+			}
+		}
+
+		output << names << " ],\n\t\"edges\": [";
+	}
+
+	size_t round = std::max<size_t>(linear_algebra::getThreadCount() * BLOCKS_PER_THREAD, 1);
+	std::vector<std::vector<Edge>> edges(round);
+	std::vector<std::string> texts(round);
+
+	forEachBlockRound(params, [&](size_t slot, uint64_t block)
+	{
+		generateBlock(params, block, edges[slot]);
+		formatBlock(format, block, edges[slot], texts[slot]);
+	}, [&](size_t slot)
+	{
+		output << texts[slot];
+	});
+
+	if (format == GraphFormat::Json)
+		output << "\n\t]\n}\n";
+
+	output.flush();
+	if (!output)
+		throw std::runtime_error("Couldn't write the graph");
+}
+
+void generator::writeGraph(const Parameters& params, GraphFormat format, const std::string& path)
+{
+	validate(params);
+
+	if (format != GraphFormat::Binary)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file)
+			throw std::runtime_error(std::string("Couldn't create ").append(path));
+
+		writeGraph(params, format, file);
+		return;
+	}
+
+	if (params.vertices >= graph::VertexTable::EMPTY_SLOT)
+		throw std::invalid_argument("Invalid argument: Too many vertices for the binary format");
+
+	size_t round = std::max<size_t>(linear_algebra::getThreadCount() * BLOCKS_PER_THREAD, 1);
+	std::vector<std::vector<Edge>> blocks(round);
+	std::vector<Edge> edges;
+	edges.reserve(edgeCount(params));
+
+	forEachBlockRound(params, [&](size_t slot, uint64_t block)
+	{
+		generateBlock(params, block, blocks[slot]);
+	}, [&](size_t slot)
+	{
+		edges.insert(edges.end(), blocks[slot].begin(), blocks[slot].end());
+	});
+
+	graph::CSRGraph csr = graph::CSRGraph::FromEdges(params.vertices, edges);
+	edges = {};
+
+	std::vector<std::string> names(params.vertices);
+	for (uint64_t v = 0; v < params.vertices; v++)
+		names[v] = std::to_string(v);
+
+	graph::saveBinaryGraph(path, graph::VertexTable::Build(names), csr);
+}
\ No newline at end of file
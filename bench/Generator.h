@@ -0,0 +1,81 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "GraphLoader.h"
+
+namespace generator
+{
+	enum class Model
+	{
+		ErdosRenyi,		// uniformly random edges
+		RMat,			// power-law degrees, recursive matrix (Kronecker) quadrants
+		LayeredDag,		// every edge leads into a later layer, so the graph is acyclic
+		PlantedCycles	// a random DAG plus disjoint cycles, its only cyclic components
+	};
+
+	const char* modelName(Model model);
+	bool parseModel(const char* name, Model& model);
+
+	struct Parameters
+	{
+		Model model = Model::ErdosRenyi;
+		uint64_t vertices = 0;
+
+		// random edges, planted cycles come on top of them. Edges may repeat
+		// (the loaders drop duplicates), there are never self loops
+		uint64_t edges = 0;
+		uint64_t seed = 1;
+
+		// quadrant probabilities of R-MAT, the fourth one is what's left of 1. b + c has to be
+		// above 0, a and the fourth quadrant only make self loops on their own
+		double a = 0.57, b = 0.19, c = 0.19;
+
+		uint64_t layers = 16;
+
+		// cycle i goes through vertices [i * cycleLength, (i + 1) * cycleLength) in order
+		uint64_t cycles = 1;
+		uint64_t cycleLength = 3;
+	};
+
+	// edges are made BLOCK_EDGES at a time, every block from its own generator seeded by the
+	// seed and the block index, so blocks can be made in any order, on any thread, and the
+	// graph depends on nothing but the parameters
+	inline constexpr uint64_t BLOCK_EDGES = 1ull << 16;
+
+	// throws std::invalid_argument when the parameters don't describe a graph
+	void validate(const Parameters& params);
+
+	uint64_t edgeCount(const Parameters& params);
+	uint64_t blockCount(const Parameters& params);
+
+	// replaces out with the edges of one block
+	void generateBlock(const Parameters& params, uint64_t block, std::vector<graph::Edge>& out);
+
+	// Writes the graph in one of the loader formats, a few blocks per thread at a time, so
+	// any number of edges streams out in a few MiB of memory. Vertices are named by their
+	// indices (1-based in Matrix Market). The binary format needs the whole graph in memory
+	// to build its adjacency and goes to a file only
+	void writeGraph(const Parameters& params, graph::GraphFormat format, std::ostream& output);
+	void writeGraph(const Parameters& params, graph::GraphFormat format, const std::string& path);
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Harness.h"
+#include <chrono>
+#include <cmath>
+
+using namespace bench;
+using Clock = std::chrono::steady_clock;
+
+// nearest rank of sorted samples
+static double percentile(const std::vector<double>& sorted, double fraction)
+{
+	size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+	return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+static double median(const std::vector<double>& sorted)
+{
+	size_t half = sorted.size() / 2;
+	return sorted.size() % 2 ? sorted[half] : (sorted[half - 1] + sorted[half]) / 2;
+}
+
+// units per second at the median, null when the case doesn't say how much it does
+static nlohmann::json rate(double amount, double seconds)
+{
+	if (amount <= 0 || seconds <= 0)
+		return nullptr;
+
+	return amount / seconds / 1e9;
+}
+
+bool Harness::wants(std::string_view name) const
+{
+	return m_filter.empty() || name.find(m_filter) != std::string_view::npos;
+}
+
+void Harness::run(std::string_view name, nlohmann::json params, Work work,
+	const std::function<void()>& body, const std::function<void()>& setup)
+{
+	if (!wants(name))
+		return;
+
+	auto timed = [&]
+	{
+		if (setup)
+			setup();
+
+		Clock::time_point start = Clock::now();
+		body();
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	};
+
+	for (size_t i = 0; i < m_options.warmup; i++)
+	{
+		if (timed() >= m_options.minSeconds)
+			break;
+	}
+
+	std::vector<double> samples;
+	double total = 0;
+	while (samples.size() < std::max<size_t>(m_options.maxRepetitions, 1))
+	{
+		samples.push_back(timed());
+		total += samples.back();
+
+		if (samples.size() >= m_options.minRepetitions && total >= m_options.minSeconds)
+			break;
+	}
+
+	std::sort(samples.begin(), samples.end());
+	double middle = median(samples);
+
+	// progress on stderr, so the report can go to stdout
+	fmt::print(stderr, "{} {}: {:.6f} s\n", name, params.dump(), middle);
+
+	m_results.push_back({
+		{ "name", name },
+		{ "params", std::move(params) },
+		{ "repetitions", samples.size() },
+		{ "seconds", {
+			{ "min", samples.front() },
+			{ "median", middle },
+			{ "p99", percentile(samples, 0.99) },
+			{ "max", samples.back() },
+			{ "mean", total / static_cast<double>(samples.size()) },
+		} },
+		{ "gflops", rate(work.flops, middle) },
+		{ "gbps", rate(work.bytes, middle) },
+	});
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+namespace bench
+{
+	struct Options
+	{
+		// runs before the timed ones, the first one being slow enough counts as all of them
+		size_t warmup = 2;
+
+		// a case keeps repeating until it took this long in total and ran at least minRepetitions
+		// times, or it ran maxRepetitions times
+		double minSeconds = 0.5;
+		size_t minRepetitions = 3;
+		size_t maxRepetitions = 100;
+	};
+
+	// what one run of a case does, for the throughput figures. Zero when it has no meaning
+	struct Work
+	{
+		double flops = 0;
+		double bytes = 0;
+	};
+
+	// keeps the compiler from dropping work whose result is never read: an empty asm statement
+	// counts as reading the value (and any memory), so it has to be computed in full
+	template <typename T>
+	void keep(T& value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		static const void* volatile sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*))
+			asm volatile("" : : "r,m"(value) : "memory");
+		else
+			asm volatile("" : : "m"(value) : "memory");
+#endif
+	}
+
+	class Harness
+	{
+	public:
+		// only cases whose name contains the filter run, an empty one runs all of them
+		Harness(Options options, std::string filter)
+			: m_options(options), m_filter(std::move(filter))
+		{ }
+
+		bool wants(std::string_view name) const;
+
+		// times body over and over, setup runs before every repetition (untimed)
+		// for cases that have to start from the same state each time
+		void run(std::string_view name, nlohmann::json params, Work work,
+			const std::function<void()>& body, const std::function<void()>& setup = {});
+
+		const nlohmann::json& results() const { return m_results; }
+
+	private:
+		Options m_options;
+		std::string m_filter;
+		nlohmann::json m_results = nlohmann::json::array();
+	};
+}
\ No newline at end of file
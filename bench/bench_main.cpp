@@ -0,0 +1,321 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Harness.h"
+#include "Generator.h"
+#include "Digraph.h"
+#include "CountMatrix.h"
+#include "ThreadPool.h"
+#include "Kernels.h"
+#include <random>
+
+namespace fs = std::filesystem;
+using linear_algebra::SIMDMatrix;
+
+// sizes grow 4x from the smallest, up to --max-size
+static constexpr size_t MIN_SIZE = 8;
+static constexpr size_t SIZE_STEP = 4;
+
+// fraction of the n^2 possible edges the generated graphs have
+static constexpr double GRAPH_DENSITIES[] = { 0.001, 0.01, 0.1 };
+
+static constexpr uint64_t POW_EXPONENT = 10;
+static constexpr uint64_t COUNT_MODULUS = 1000000007;
+static constexpr uint64_t WALK_LENGTHS[] = { 2, 6 };
+
+// multiplications of square-and-multiply, the way pow does it
+static double powMultiplications(uint64_t exponent)
+{
+	return static_cast<double>(std::bit_width(exponent) - 1 + std::popcount(exponent) - 1);
+}
+
+static SIMDMatrix randomMatrix(size_t size, std::mt19937& twister)
+{
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	SIMDMatrix result(size);
+	for (size_t i = 0; i < size; i++)
+	for (size_t j = 0; j < size; j++)
+		result.set(i, j, dist(twister));
+
+	return result;
+}
+
+static linear_algebra::CountMatrix randomResidues(size_t size, std::mt19937& twister)
+{
+	std::uniform_int_distribution<uint64_t> dist(0, COUNT_MODULUS - 1);
+
+	linear_algebra::CountMatrix result(size);
+	for (size_t i = 0; i < size; i++)
+	for (size_t j = 0; j < size; j++)
+		result.set(i, j, dist(twister));
+
+	return result;
+}
+
+// modular count products once with the classic kernel and once with Strassen-Winograd at
+// the default cutoff, below which both are the same product
+static void benchCountProducts(bench::Harness& harness, size_t size, std::mt19937& twister)
+{
+	if (!harness.wants("matrix.count_multiply_mod"))
+		return;
+
+	linear_algebra::CountMatrix lhs = randomResidues(size, twister);
+	linear_algebra::CountMatrix rhs = randomResidues(size, twister);
+	linear_algebra::CountMatrix result;
+
+	double n = static_cast<double>(size);
+	double matrixBytes = n * n * sizeof(uint64_t);
+	size_t previousCutoff = linear_algebra::getStrassenCutoff();
+
+	for (size_t cutoff : { size_t(0), linear_algebra::DEFAULT_STRASSEN_CUTOFF })
+	{
+		linear_algebra::setStrassenCutoff(cutoff);
+		harness.run("matrix.count_multiply_mod", { { "n", size }, { "strassen_cutoff", cutoff } }, { 2 * n * n * n, 3 * matrixBytes }, [&]
+		{
+			linear_algebra::multiplyInto(lhs, rhs, result, { COUNT_MODULUS });
+			bench::keep(result);
+		});
+	}
+
+	linear_algebra::setStrassenCutoff(previousCutoff);
+}
+
+static void benchMatrices(bench::Harness& harness, size_t size, std::mt19937& twister)
+{
+	if (!harness.wants("matrix."))
+		return;
+
+	SIMDMatrix lhs = randomMatrix(size, twister);
+	SIMDMatrix rhs = randomMatrix(size, twister);
+	SIMDMatrix result;
+
+	double n = static_cast<double>(size);
+	double matrixBytes = n * n * sizeof(float);
+	nlohmann::json params = { { "n", size } };
+
+	harness.run("matrix.multiply", params, { 2 * n * n * n, 3 * matrixBytes }, [&]
+	{
+		result = lhs * rhs;
+		bench::keep(result);
+	});
+
+	harness.run("matrix.add", params, { n * n, 3 * matrixBytes }, [&]
+	{
+		result = lhs + rhs;
+		bench::keep(result);
+	});
+
+	harness.run("matrix.scale", params, { n * n, 2 * matrixBytes }, [&]
+	{
+		result = lhs * 0.5f;
+		bench::keep(result);
+	});
+
+	// entries of magnitude up to 1 grow about sqrt(n) times a step, 10 steps stay finite
+	double multiplications = powMultiplications(POW_EXPONENT);
+	harness.run("matrix.pow", { { "n", size }, { "exponent", POW_EXPONENT } },
+		{ multiplications * 2 * n * n * n, multiplications * 3 * matrixBytes }, [&]
+	{
+		result = linear_algebra::pow(lhs, POW_EXPONENT);
+		bench::keep(result);
+	});
+}
+
+// an edge list with about density * size^2 random edges, all of them leading
+// from a lower to a higher vertex when acyclic is set
+static fs::path writeGraph(const fs::path& directory, size_t size, double density, bool acyclic, uint64_t seed)
+{
+	generator::Parameters params;
+	params.model = acyclic ? generator::Model::LayeredDag : generator::Model::ErdosRenyi;
+	params.vertices = size;
+	params.edges = std::max<uint64_t>(1, static_cast<uint64_t>(density * static_cast<double>(size * size)));
+	params.layers = size;
+	params.seed = seed;
+
+	fs::path path = directory / fmt::format("{}_{}_{}.txt", acyclic ? "dag" : "random", size, density);
+	generator::writeGraph(params, graph::GraphFormat::EdgeList, path.string());
+	return path;
+}
+
+static void benchGraphs(bench::Harness& harness, size_t size, const fs::path& directory, uint64_t seed)
+{
+	if (!harness.wants("digraph."))
+		return;
+
+	for (double density : GRAPH_DENSITIES)
+	{
+		fs::path randomPath = writeGraph(directory, size, density, false, seed);
+		fs::path dagPath = writeGraph(directory, size, density, true, seed);
+
+		// queries cache what they find, so every repetition asks a fresh copy
+		// of a graph that was never queried
+		const Digraph random = Digraph::fromFile(randomPath.string());
+		const Digraph dag = Digraph::fromFile(dagPath.string());
+		Digraph subject;
+
+		double fileBytes = static_cast<double>(fs::file_size(randomPath));
+		auto csrBytes = [](const Digraph& g)
+		{
+			return static_cast<double>((g.getVertexCount() + 1) * sizeof(uint64_t) + g.getEdgeCount() * sizeof(graph::Vertex));
+		};
+
+		auto params = [&](const Digraph& g)
+		{
+			return nlohmann::json{ { "n", size }, { "density", density }, { "vertices", g.getVertexCount() }, { "edges", g.getEdgeCount() } };
+		};
+
+		harness.run("digraph.from_file", params(random), { 0, fileBytes }, [&]
+		{
+			Digraph loaded = Digraph::fromFile(randomPath.string());
+			bench::keep(loaded);
+		});
+
+		for (const Digraph* g : { &random, &dag })
+		{
+			nlohmann::json shape = params(*g);
+			shape["acyclic"] = g == &dag;
+
+			harness.run("digraph.is_acyclic", shape, { 0, csrBytes(*g) }, [&]
+			{
+				bool acyclic = subject.isAcyclic();
+				bench::keep(acyclic);
+			}, [&] { subject = *g; });
+		}
+
+		// the walk counting of findAllPathsWithLength, without printing every pair
+		for (uint64_t length : WALK_LENGTHS)
+		{
+			nlohmann::json shape = params(random);
+			shape["length"] = length;
+
+			harness.run("digraph.find_all_paths", shape, {}, [&]
+			{
+				size_t pairs = 0;
+				subject.forEachWalk(length, [&](size_t, size_t, uint64_t) { pairs++; });
+				bench::keep(pairs);
+			}, [&] { subject = random; });
+		}
+
+		fs::remove(randomPath);
+		fs::remove(dagPath);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	argparse::ArgumentParser program("digraph_bench", "1.0");
+	program.add_argument("-o", "--output")
+		.help("Write the JSON report to this file instead of stdout");
+	program.add_argument("--filter")
+		.help("Only run the cases whose name contains this (matrix.multiply, digraph. ...)")
+		.default_value(std::string());
+	program.add_argument("--max-size")
+		.help("Largest matrix and graph size, sizes go 8, 32, 128 ... up to it")
+		.default_value(size_t(8192))
+		.scan<'u', size_t>();
+	program.add_argument("--min-time")
+		.help("Seconds every case keeps repeating for")
+		.default_value(0.5)
+		.scan<'g', double>();
+	program.add_argument("--warmup")
+		.help("Untimed runs before the timed ones")
+		.default_value(size_t(2))
+		.scan<'u', size_t>();
+	program.add_argument("--max-repetitions")
+		.default_value(size_t(100))
+		.scan<'u', size_t>();
+	program.add_argument("-t", "--threads")
+		.help("Number of threads used for matrix operations, 0 uses every hardware thread")
+		.default_value(size_t(0))
+		.scan<'u', size_t>();
+	program.add_argument("--seed")
+		.help("Seed of the random matrices and graphs")
+		.default_value(size_t(1))
+		.scan<'u', size_t>();
+
+	try
+	{
+		program.parse_args(argc, argv);
+	}
+	catch (const std::exception& e)
+	{
+		fmt::print(stderr, "{}\n{}\n", e.what(), program.help().str());
+		return 1;
+	}
+
+	linear_algebra::setThreadCount(program.get<size_t>("--threads"));
+
+	bench::Options options;
+	options.minSeconds = program.get<double>("--min-time");
+	options.warmup = program.get<size_t>("--warmup");
+	options.maxRepetitions = program.get<size_t>("--max-repetitions");
+
+	bench::Harness harness(options, program.get<std::string>("--filter"));
+	std::mt19937 twister(static_cast<std::mt19937::result_type>(program.get<size_t>("--seed")));
+
+	fs::path directory = fs::temp_directory_path() / fmt::format("digraph_bench_{}", program.get<size_t>("--seed"));
+	size_t maxSize = program.get<size_t>("--max-size");
+
+	try
+	{
+		fs::create_directories(directory);
+
+		for (size_t size = MIN_SIZE; size <= maxSize; size *= SIZE_STEP)
+		{
+			benchMatrices(harness, size, twister);
+			benchCountProducts(harness, size, twister);
+			benchGraphs(harness, size, directory, program.get<size_t>("--seed"));
+		}
+
+		fs::remove_all(directory);
+	}
+	catch (const std::exception& e)
+	{
+		fmt::print(stderr, "{}\n", e.what());
+		fs::remove_all(directory);
+		return 1;
+	}
+
+	nlohmann::json report = {
+		{ "isa", linear_algebra::kernels::isaName(linear_algebra::kernels::active().isa) },
+		{ "threads", linear_algebra::getThreadCount() },
+		{ "min_time", options.minSeconds },
+		{ "results", harness.results() },
+	};
+
+	std::string text = report.dump(1, '\t');
+	if (auto output = program.present("--output"))
+	{
+		std::ofstream file(*output);
+		file << text << '\n';
+		if (!file)
+		{
+			fmt::print(stderr, "Couldn't write {}\n", *output);
+			return 1;
+		}
+	}
+	else
+		fmt::print("{}\n", text);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Generator.h"
+#include "ThreadPool.h"
+
+int main(int argc, char** argv)
+{
+	argparse::ArgumentParser program("digraph_gen", "1.0");
+	program.add_argument("model")
+		.help("erdos-renyi, rmat, layered-dag or planted-cycles")
+		.required();
+	program.add_argument("-n", "--vertices")
+		.help("Number of vertices")
+		.required()
+		.scan<'u', uint64_t>();
+	program.add_argument("-e", "--edges")
+		.help("Number of random edges (planted cycles come on top of them)")
+		.required()
+		.scan<'u', uint64_t>();
+	program.add_argument("-s", "--seed")
+		.help("The same seed (and parameters) always give the same graph")
+		.default_value(uint64_t(1))
+		.scan<'u', uint64_t>();
+	program.add_argument("-o", "--output")
+		.help("File to write the graph to, - writes it to stdout")
+		.default_value(std::string("-"));
+	program.add_argument("-f", "--format")
+		.help("edges, csv, tsv, mtx, json or binary. By default it's picked from the output extension (edges for stdout)");
+	program.add_argument("--rmat")
+		.help("Probabilities of the top left, top right and bottom left R-MAT quadrants")
+		.nargs(3)
+		.default_value(std::vector<double>{ 0.57, 0.19, 0.19 })
+		.scan<'g', double>();
+	program.add_argument("--layers")
+		.help("Number of layers of a layered DAG")
+		.default_value(uint64_t(16))
+		.scan<'u', uint64_t>();
+	program.add_argument("--cycles")
+		.help("Number of planted cycles")
+		.default_value(uint64_t(1))
+		.scan<'u', uint64_t>();
+	program.add_argument("--cycle-length")
+		.help("Vertices of every planted cycle")
+		.default_value(uint64_t(3))
+		.scan<'u', uint64_t>();
+	program.add_argument("-t", "--threads")
+		.help("Number of threads generating edges, 0 uses every hardware thread")
+		.default_value(size_t(0))
+		.scan<'u', size_t>();
+
+	try
+	{
+		program.parse_args(argc, argv);
+	}
+	catch (const std::exception& e)
+	{
+		fmt::print(stderr, "{}\n{}\n", e.what(), program.help().str());
+		return 1;
+	}
+
+	linear_algebra::setThreadCount(program.get<size_t>("--threads"));
+
+	generator::Parameters params;
+	std::string modelName = program.get<std::string>("model");
+	if (!generator::parseModel(modelName.c_str(), params.model))
+	{
+		fmt::print(stderr, "Unknown model \"{}\"\n", modelName);
+		return 1;
+	}
+
+	std::vector<double> quadrants = program.get<std::vector<double>>("--rmat");
+	params.vertices = program.get<uint64_t>("--vertices");
+	params.edges = program.get<uint64_t>("--edges");
+	params.seed = program.get<uint64_t>("--seed");
+	params.a = quadrants[0];
+	params.b = quadrants[1];
+	params.c = quadrants[2];
+	params.layers = program.get<uint64_t>("--layers");
+	params.cycles = program.get<uint64_t>("--cycles");
+	params.cycleLength = program.get<uint64_t>("--cycle-length");
+
+	std::string output = program.get<std::string>("--output");
+	graph::GraphFormat format = output == "-" ? graph::GraphFormat::EdgeList : graph::detectGraphFormat(output);
+	if (auto formatName = program.present("--format"))
+	{
+		if (!graph::parseGraphFormat(formatName->c_str(), format) || format == graph::GraphFormat::Auto)
+		{
+			fmt::print(stderr, "Unknown format \"{}\"\n", *formatName);
+			return 1;
+		}
+	}
+
+	try
+	{
+		if (output == "-")
+		{
+			std::ios::sync_with_stdio(false);
+			generator::writeGraph(params, format, std::cout);
+		}
+		else
+		{
+			generator::writeGraph(params, format, output);
+			fmt::print(stderr, "Wrote {} vertices and {} edges to {}\n", params.vertices, generator::edgeCount(params), output);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		fmt::print(stderr, "{}\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,644 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "BatchQueries.h"
+#include "Profiler.h"
+
+// listed walks are written to the output this many bytes at a time
+static constexpr size_t RESULT_CHUNK_BYTES = 1ull << 20;
+
+using namespace batch;
+
+namespace
+{
+	enum class QueryType { Paths, PathsFrom, PathsBetween, Acyclic, Components, Leads, Reaches, InsertEdge, RemoveEdge, Invalid };
+
+	bool isEdit(QueryType type)
+	{
+		return type == QueryType::InsertEdge || type == QueryType::RemoveEdge;
+	}
+
+	struct Query
+	{
+		size_t line = 0;
+		QueryType type = QueryType::Invalid;
+		std::vector<uint64_t> lengths;
+		std::string from, to;
+		std::string error;
+	};
+
+}
+
+const char* batch::outputFormatName(OutputFormat format)
+{
+	switch (format)
+	{
+	case OutputFormat::Csv: return "csv";
+	default: return "json";
+	}
+}
+
+bool batch::parseOutputFormat(const char* name, OutputFormat& format)
+{
+	for (OutputFormat candidate : { OutputFormat::Json, OutputFormat::Csv })
+	{
+		if (std::strcmp(name, outputFormatName(candidate)) == 0)
+		{
+			format = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// whitespace separated words, "quoted" ones may hold spaces
+static std::vector<std::string> tokenize(std::string_view line)
+{
+	std::vector<std::string> tokens;
+	size_t i = 0;
+
+	while (true)
+	{
+		while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i])))
+			i++;
+
+		if (i == line.size())
+			break;
+
+		if (line[i] == '"')
+		{
+			size_t end = line.find('"', i + 1);
+			if (end == std::string_view::npos)
+				throw std::runtime_error("Unterminated quoted name");
+
+			tokens.emplace_back(line.substr(i + 1, end - i - 1));
+			i = end + 1;
+		}
+		else
+		{
+			size_t begin = i;
+			while (i < line.size() && !std::isspace(static_cast<unsigned char>(line[i])))
+				i++;
+
+			tokens.emplace_back(line.substr(begin, i - begin));
+		}
+	}
+
+	return tokens;
+}
+
+// tokens from first on are the lengths
+static std::vector<uint64_t> parseLengths(const std::vector<std::string>& tokens, size_t first)
+{
+	if (tokens.size() <= first)
+		throw std::runtime_error("Expected at least one length");
+
+	std::vector<uint64_t> lengths;
+	for (size_t i = first; i < tokens.size(); i++)
+	{
+		uint64_t length;
+		auto [end, error] = std::from_chars(tokens[i].data(), tokens[i].data() + tokens[i].size(), length);
+		if (error != std::errc() || end != tokens[i].data() + tokens[i].size())
+			throw std::runtime_error(fmt::format("Invalid length \"{}\"", tokens[i]));
+
+		lengths.push_back(length);
+	}
+
+	return lengths;
+}
+
+static Query parseQuery(size_t lineNumber, std::string_view line)
+{
+	Query query;
+	query.line = lineNumber;
+
+	try
+	{
+		std::vector<std::string> tokens = tokenize(line);
+		if (tokens.empty())
+			throw std::runtime_error("Expected a query");
+
+		if (tokens[0] == "paths")
+		{
+			query.lengths = parseLengths(tokens, 1);
+			query.type = QueryType::Paths;
+		}
+		else if (tokens[0] == "paths-from")
+		{
+			if (tokens.size() < 2)
+				throw std::runtime_error("Expected a vertex");
+
+			query.from = tokens[1];
+			query.lengths = parseLengths(tokens, 2);
+			query.type = QueryType::PathsFrom;
+		}
+		else if (tokens[0] == "paths-between")
+		{
+			if (tokens.size() < 3)
+				throw std::runtime_error("Expected two vertices");
+
+			query.from = tokens[1];
+			query.to = tokens[2];
+			query.lengths = parseLengths(tokens, 3);
+			query.type = QueryType::PathsBetween;
+		}
+		else if (tokens[0] == "acyclic")
+		{
+			if (tokens.size() != 1)
+				throw std::runtime_error("Expected no arguments");
+
+			query.type = QueryType::Acyclic;
+		}
+		else if (tokens[0] == "components")
+		{
+			if (tokens.size() != 1)
+				throw std::runtime_error("Expected no arguments");
+
+			query.type = QueryType::Components;
+		}
+		else if (tokens[0] == "leads")
+		{
+			if (tokens.size() != 3)
+				throw std::runtime_error("Expected two vertices");
+
+			query.from = std::move(tokens[1]);
+			query.to = std::move(tokens[2]);
+			query.type = QueryType::Leads;
+		}
+		else if (tokens[0] == "insert" || tokens[0] == "remove")
+		{
+			if (tokens.size() != 3)
+				throw std::runtime_error("Expected two vertices");
+
+			query.type = tokens[0] == "insert" ? QueryType::InsertEdge : QueryType::RemoveEdge;
+			query.from = std::move(tokens[1]);
+			query.to = std::move(tokens[2]);
+		}
+		else if (tokens[0] == "reaches")
+		{
+			if (tokens.size() != 3)
+				throw std::runtime_error("Expected two vertices");
+
+			query.from = std::move(tokens[1]);
+			query.to = std::move(tokens[2]);
+			query.type = QueryType::Reaches;
+		}
+		else
+			throw std::runtime_error(fmt::format("Unknown query \"{}\"", tokens[0]));
+	}
+	catch (const std::runtime_error& e)
+	{
+		query.type = QueryType::Invalid;
+		query.error = e.what();
+	}
+
+	return query;
+}
+
+static std::string jsonString(std::string_view text)
+{
+	std::string result = "\"";
+	for (char c : text)
+	{
+		switch (c)
+		{
+		case '"': result += "\\\""; break;
+		case '\\': result += "\\\\"; break;
+		case '\n': result += "\\n"; break;
+		case '\r': result += "\\r"; break;
+		case '\t': result += "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+				result += fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+			else
+				result += c;
+		}
+	}
+
+	return result + "\"";
+}
+
+static std::string csvField(std::string_view text)
+{
+	if (text.find_first_of(",\"\r\n") == std::string_view::npos)
+		return std::string(text);
+
+	std::string result = "\"";
+	for (char c : text)
+	{
+		if (c == '"')
+			result += '"';
+		result += c;
+	}
+
+	return result + "\"";
+}
+
+namespace
+{
+	// prints the results one by one, so the JSON array separators are tracked here
+	class ResultWriter
+	{
+	public:
+		ResultWriter(const Digraph& digraph, std::ostream& output, OutputFormat format, bool countsOnly)
+			: m_digraph(digraph), m_output(output), m_format(format), m_countsOnly(countsOnly)
+		{
+			if (m_format == OutputFormat::Json)
+			{
+				m_output << fmt::format("{{\"vertices\":{},\"edges\":{},\"modulus\":{},\"results\":[",
+					digraph.getVertexCount(), digraph.getEdgeCount(), digraph.getWalkCountModulus());
+			}
+			else
+				m_output << "line,query,length,from,to,value\n";
+		}
+
+		~ResultWriter()
+		{
+			if (m_format == OutputFormat::Json)
+				m_output << "\n]}\n";
+		}
+
+		// the walks of one length are streamed between beginPaths and endPaths, a chunk at a time,
+		// so the number of connected pairs only comes after them
+		void beginPaths(size_t line, std::string_view query, uint64_t length)
+		{
+			m_pathsLine = line;
+			m_pathsQuery = query;
+			m_pathsLength = length;
+			m_pairs = 0;
+
+			if (m_format == OutputFormat::Csv)
+				return;
+
+			begin(line, query);
+			m_output << fmt::format(",\"length\":{}", length);
+			if (!m_countsOnly)
+				m_output << ",\"walks\":[";
+		}
+
+		void walk(size_t from, size_t to, uint64_t count)
+		{
+			m_pairs++;
+			if (m_countsOnly)
+				return;
+
+			if (m_format == OutputFormat::Csv)
+			{
+				fmt::format_to(std::back_inserter(m_buffer), "{},{},{},{},{},{}\n", m_pathsLine, m_pathsQuery, m_pathsLength, name(from), name(to), count);
+				lineDone();
+				return;
+			}
+
+			fmt::format_to(std::back_inserter(m_buffer), "{}{{\"from\":{},\"to\":{},\"count\":{}", m_pairs > 1 ? "," : "",
+				name(from), name(to), count);
+
+			// counts past 64 bits saturate
+			if (!m_digraph.getWalkCountModulus() && count == linear_algebra::COUNT_SATURATED)
+				fmt::format_to(std::back_inserter(m_buffer), ",\"saturated\":true");
+
+			m_buffer.push_back('}');
+			lineDone();
+		}
+
+		void endPaths()
+		{
+			flush();
+
+			if (m_format == OutputFormat::Csv)
+			{
+				// the row without vertices holds the number of connected pairs
+				m_output << fmt::format("{},{},{},,,{}\n", m_pathsLine, m_pathsQuery, m_pathsLength, m_pairs);
+				return;
+			}
+
+			m_output << fmt::format("{},\"pairs\":{}}}", m_countsOnly ? "" : "]", m_pairs);
+		}
+
+		// count is empty when no walk connects the vertices
+		void pathsBetween(size_t line, const Query& query, uint64_t length, std::optional<uint64_t> count)
+		{
+			if (m_format == OutputFormat::Csv)
+			{
+				m_output << fmt::format("{},paths-between,{},{},{},{}\n", line, length, csvField(query.from), csvField(query.to),
+					count ? fmt::format("{}", *count) : "");
+				return;
+			}
+
+			begin(line, "paths-between");
+			m_output << fmt::format(",\"from\":{},\"to\":{},\"length\":{},\"connected\":{},\"count\":{}}}",
+				jsonString(query.from), jsonString(query.to), length, count.has_value(), count.value_or(0));
+		}
+
+		void acyclic(size_t line, const graph::TopologicalOrder& order)
+		{
+			if (m_format == OutputFormat::Csv)
+			{
+				m_output << fmt::format("{},acyclic,,,,{}\n", line, order.acyclic);
+				return;
+			}
+
+			begin(line, "acyclic");
+			m_output << fmt::format(",\"acyclic\":{}", order.acyclic);
+
+			if (!order.acyclic)
+			{
+				m_output << ",\"cycle\":[";
+				for (size_t i = 0; i < order.cycle.size(); i++)
+					m_output << (i ? "," : "") << name(order.cycle[i]);
+
+				m_output << "]";
+			}
+
+			m_output << "}";
+		}
+
+		// the components with cycles, each with its members and one of its cycles
+		void components(size_t line)
+		{
+			const graph::StronglyConnectedComponents& components = m_digraph.components();
+
+			if (m_format == OutputFormat::Csv)
+			{
+				// the row without a vertex holds the component count, the others the size of
+				// the component with cycles their vertex belongs to
+				m_output << fmt::format("{},components,,,,{}\n", line, components.getComponentCount());
+				for (uint32_t c = 0; c < components.getComponentCount(); c++)
+				{
+					if (components.cyclic[c])
+						m_output << fmt::format("{},components,,{},,{}\n", line, name(components.componentMembers(c).front()), components.componentMembers(c).size());
+				}
+
+				return;
+			}
+
+			begin(line, "components");
+			m_output << fmt::format(",\"components\":{},\"condensationEdges\":{},\"cyclic\":[",
+				components.getComponentCount(), m_digraph.condensation().getEdgeCount());
+
+			bool first = true;
+			for (uint32_t c = 0; c < components.getComponentCount(); c++)
+			{
+				if (!components.cyclic[c])
+					continue;
+
+				m_output << (first ? "" : ",") << "{\"members\":[";
+				first = false;
+
+				std::span<const graph::Vertex> members = components.componentMembers(c);
+				for (size_t i = 0; i < members.size(); i++)
+					m_output << (i ? "," : "") << name(members[i]);
+
+				m_output << "],\"cycle\":[";
+
+				std::vector<graph::Vertex> cycle = m_digraph.componentCycle(c);
+				for (size_t i = 0; i < cycle.size(); i++)
+					m_output << (i ? "," : "") << name(cycle[i]);
+
+				m_output << "]}";
+			}
+
+			m_output << "]}";
+		}
+
+		void leads(size_t line, const Query& query, bool leads)
+		{
+			if (m_format == OutputFormat::Csv)
+			{
+				m_output << fmt::format("{},leads,,{},{},{}\n", line, csvField(query.from), csvField(query.to), leads);
+				return;
+			}
+
+			begin(line, "leads");
+			m_output << fmt::format(",\"from\":{},\"to\":{},\"leads\":{}}}", jsonString(query.from), jsonString(query.to), leads);
+		}
+
+		void reaches(size_t line, const Query& query, bool reaches)
+		{
+			if (m_format == OutputFormat::Csv)
+			{
+				m_output << fmt::format("{},reaches,,{},{},{}\n", line, csvField(query.from), csvField(query.to), reaches);
+				return;
+			}
+
+			begin(line, "reaches");
+			m_output << fmt::format(",\"from\":{},\"to\":{},\"reaches\":{}}}", jsonString(query.from), jsonString(query.to), reaches);
+		}
+
+		// changed is false when the edge was already there (or not there)
+		void edit(size_t line, std::string_view query, const Query& edit, bool changed)
+		{
+			if (m_format == OutputFormat::Csv)
+			{
+				m_output << fmt::format("{},{},,{},{},{}\n", line, query, csvField(edit.from), csvField(edit.to), changed);
+				return;
+			}
+
+			begin(line, query);
+			m_output << fmt::format(",\"from\":{},\"to\":{},\"changed\":{}}}", jsonString(edit.from), jsonString(edit.to), changed);
+		}
+
+		void error(size_t line, const std::string& message)
+		{
+			if (m_format == OutputFormat::Csv)
+			{
+				m_output << fmt::format("{},error,,,,{}\n", line, csvField(message));
+				return;
+			}
+
+			begin(line, "error");
+			m_output << fmt::format(",\"error\":{}}}", jsonString(message));
+		}
+
+	private:
+		// the walks of a result are formatted into memory and written a chunk at a time
+		void lineDone()
+		{
+			if (m_buffer.size() >= RESULT_CHUNK_BYTES)
+				flush();
+		}
+
+		void flush()
+		{
+			m_output.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+			m_buffer.clear();
+		}
+
+		void begin(size_t line, std::string_view query)
+		{
+			m_output << (m_first ? "\n" : ",\n") << fmt::format("{{\"line\":{},\"query\":\"{}\"", line, query);
+			m_first = false;
+		}
+
+		std::string name(size_t vertex) const
+		{
+			std::string_view vertexName = m_digraph.getVertexName(vertex);
+			return m_format == OutputFormat::Json ? jsonString(vertexName) : csvField(vertexName);
+		}
+
+	private:
+		const Digraph& m_digraph;
+		std::ostream& m_output;
+		OutputFormat m_format;
+		bool m_countsOnly;
+		bool m_first = true;
+		fmt::memory_buffer m_buffer;
+
+		// the paths result being streamed
+		size_t m_pathsLine = 0;
+		std::string_view m_pathsQuery;
+		uint64_t m_pathsLength = 0;
+		size_t m_pairs = 0;
+	};
+}
+
+// answers one query that doesn't change the graph. Walks go straight to the writer, so
+// nothing is kept of them; lengths close to earlier ones come from the cached walk matrices
+static void answer(const Query& query, const Digraph& digraph, ResultWriter& writer, std::optional<graph::TopologicalOrder>& order)
+{
+	switch (query.type)
+	{
+	case QueryType::Paths:
+		for (uint64_t length : query.lengths)
+		{
+			writer.beginPaths(query.line, "paths", length);
+			digraph.forEachWalk(length, [&](size_t i, size_t j, uint64_t count) { writer.walk(i, j, count); });
+			writer.endPaths();
+		}
+		break;
+	case QueryType::PathsFrom:
+	{
+		std::optional<size_t> source = digraph.findVertex(query.from);
+		if (!source)
+		{
+			writer.error(query.line, "Nonexistent vertex specified in a query");
+			break;
+		}
+
+		for (uint64_t length : query.lengths)
+		{
+			writer.beginPaths(query.line, "paths-from", length);
+			digraph.forEachWalkFrom(*source, length, [&](size_t j, uint64_t count)
+			{
+				if (j != *source)
+					writer.walk(*source, j, count);
+			});
+			writer.endPaths();
+		}
+		break;
+	}
+	case QueryType::PathsBetween:
+	{
+		std::optional<size_t> from = digraph.findVertex(query.from);
+		std::optional<size_t> to = digraph.findVertex(query.to);
+		if (!from || !to)
+		{
+			writer.error(query.line, "Nonexistent vertex specified in a query");
+			break;
+		}
+
+		for (uint64_t length : query.lengths)
+			writer.pathsBetween(query.line, query, length, digraph.countWalksBetween(*from, *to, length));
+		break;
+	}
+	case QueryType::Acyclic:
+		if (!order)
+			order = digraph.topologicalOrder();
+
+		writer.acyclic(query.line, *order);
+		break;
+	case QueryType::Components:
+		writer.components(query.line);
+		break;
+	case QueryType::Leads:
+		if (!digraph.findVertex(query.from) || !digraph.findVertex(query.to))
+			writer.error(query.line, "Nonexistent vertex specified in a query");
+		else
+			writer.leads(query.line, query, digraph.isLeadingTo(query.from, query.to));
+		break;
+	case QueryType::Reaches:
+		if (!digraph.findVertex(query.from) || !digraph.findVertex(query.to))
+			writer.error(query.line, "Nonexistent vertex specified in a query");
+		else
+			writer.reaches(query.line, query, digraph.canReach(query.from, query.to));
+		break;
+	default:
+		writer.error(query.line, query.error);
+		break;
+	}
+}
+
+void batch::run(Digraph& digraph, std::istream& queries, std::ostream& output, OutputFormat format, bool countsOnly)
+{
+	std::vector<Query> parsed;
+
+	{
+		DIGRAPH_PROFILE_SCOPE("parse queries");
+
+		std::string line;
+		for (size_t lineNumber = 1; std::getline(queries, line); lineNumber++)
+		{
+			// the same whitespace tokenize skips, so every line that gets parsed has a token
+			size_t first = 0;
+			while (first < line.size() && std::isspace(static_cast<unsigned char>(line[first])))
+				first++;
+
+			if (first == line.size() || line[first] == '#')
+				continue;
+
+			parsed.push_back(parseQuery(lineNumber, line));
+		}
+	}
+
+	ResultWriter writer(digraph, output, format, countsOnly);
+
+	// edits split the batch into stretches answered against the same graph
+	for (size_t begin = 0; begin < parsed.size(); )
+	{
+		size_t end = begin;
+		while (end < parsed.size() && !isEdit(parsed[end].type))
+			end++;
+
+		// acyclicity doesn't change within a stretch either
+		std::optional<graph::TopologicalOrder> order;
+
+		{
+			DIGRAPH_PROFILE_SCOPE("answer queries");
+
+			for (size_t i = begin; i < end; i++)
+				answer(parsed[i], digraph, writer, order);
+		}
+
+		if (end == parsed.size())
+			break;
+
+		const Query& edit = parsed[end];
+		if (!digraph.findVertex(edit.from) || !digraph.findVertex(edit.to))
+			writer.error(edit.line, "Nonexistent vertex specified in a query");
+		else if (edit.type == QueryType::InsertEdge)
+			writer.edit(edit.line, "insert", edit, digraph.insertEdge(edit.from, edit.to));
+		else
+			writer.edit(edit.line, "remove", edit, digraph.removeEdge(edit.from, edit.to));
+
+		begin = end + 1;
+	}
+}
\ No newline at end of file
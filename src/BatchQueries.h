@@ -0,0 +1,52 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "Digraph.h"
+
+// Non-interactive queries, one per line:
+//	paths <length> [length...]	walks of every listed length between all pairs of vertices
+//	paths-from <from> <length> [length...]		walks from one vertex to all the others
+//	paths-between <from> <to> <length> [length...]	walks from one vertex to another
+//	acyclic						whether the graph is acyclic, with a cycle when it isn't
+//	components					strongly connected components with cycles, with one cycle each
+//	reaches <from> <to>			whether any walk leads from one vertex to the other
+//	leads <from> <to>			whether there is an edge from one vertex to the other
+//	insert <from> <to>			adds an edge, the queries after it see the changed graph
+//	remove <from> <to>			removes an edge the same way
+// Names with spaces go in double quotes, blank lines and ones starting with # are skipped.
+// Walks are written out as they are visited, in the order of the queries, and nothing is kept
+// of them. Walk matrices stay cached though (see Digraph::setWalkCacheBudget), so a length close
+// to an earlier one costs a multiplication or two. Queries from a single vertex take
+// vector-matrix products instead (see Digraph::forEachWalkFrom)
+namespace batch
+{
+	enum class OutputFormat { Json, Csv };
+
+	const char* outputFormatName(OutputFormat format);
+	bool parseOutputFormat(const char* name, OutputFormat& format);
+
+	// a query that can't be parsed gets an error result instead of stopping the batch. With
+	// countsOnly the path queries give only the number of connected pairs, no walks are kept
+	void run(Digraph& digraph, std::istream& queries, std::ostream& output, OutputFormat format, bool countsOnly = false);
+}
\ No newline at end of file
@@ -0,0 +1,349 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "BitMatrix.h"
+#include "AlignedAlloc.h"
+#include "ThreadPool.h"
+#include "Kernels.h"
+#include "Profiler.h"
+
+using namespace linear_algebra;
+
+static constexpr size_t WORDS_PER_VECTOR = 4;
+
+// smaller products (counted in bit multiply-adds) stay on the calling thread
+static constexpr size_t PARALLEL_BOOL_GEMM_MIN_WORK = 256ull * 256ull * 256ull;
+
+BitMatrix::BitMatrix(size_t rc)
+	: m_rows(rc), m_cols(rc)
+{
+	initialize();
+}
+
+BitMatrix::BitMatrix(size_t rows, size_t cols)
+	: m_rows(rows), m_cols(cols)
+{
+	initialize();
+}
+
+void BitMatrix::initialize()
+{
+	// rows padded to whole 256-bit vectors
+	m_wordsPerRow = (m_cols + 255) / 256 * WORDS_PER_VECTOR;
+
+	size_t bytes = m_rows * m_wordsPerRow * sizeof(uint64_t);
+	m_data = nullptr;
+
+	if (bytes == 0)
+		return;
+
+	m_data = (uint64_t*)alloc_aligned(bytes, SIMD_ALIGNMENT);
+
+	if (!m_data)
+		throw std::bad_alloc();
+
+	std::memset(m_data, 0, bytes);
+}
+
+BitMatrix::~BitMatrix()
+{
+	if (!m_data)
+		return;
+
+	free_aligned(m_data);
+	m_data = nullptr;
+}
+
+BitMatrix::BitMatrix(const BitMatrix& other)
+	: m_rows(other.m_rows), m_cols(other.m_cols), m_wordsPerRow(other.m_wordsPerRow), m_data(nullptr)
+{
+	size_t bytes = m_rows * m_wordsPerRow * sizeof(uint64_t);
+	if (bytes == 0)
+		return;
+
+	m_data = (uint64_t*)alloc_aligned(bytes, SIMD_ALIGNMENT);
+
+	if (!m_data)
+		throw std::bad_alloc();
+
+	std::memcpy(m_data, other.m_data, bytes);
+}
+
+BitMatrix& BitMatrix::operator=(const BitMatrix& other)
+{
+	if (this == &other)
+		return *this;
+
+	size_t neededBytes = other.m_rows * other.m_wordsPerRow * sizeof(uint64_t);
+	size_t currentBytes = m_rows * m_wordsPerRow * sizeof(uint64_t);
+
+	if (neededBytes != currentBytes)
+	{
+		if (m_data)
+			free_aligned(m_data);
+
+		m_data = neededBytes ? (uint64_t*)alloc_aligned(neededBytes, SIMD_ALIGNMENT) : nullptr;
+
+		if (neededBytes && !m_data)
+			throw std::bad_alloc();
+	}
+
+	m_rows = other.m_rows;
+	m_cols = other.m_cols;
+	m_wordsPerRow = other.m_wordsPerRow;
+
+	if (neededBytes)
+		std::memcpy(m_data, other.m_data, neededBytes);
+
+	return *this;
+}
+
+BitMatrix::BitMatrix(BitMatrix&& other) noexcept
+	: m_rows(other.m_rows),
+	m_cols(other.m_cols),
+	m_wordsPerRow(other.m_wordsPerRow),
+	m_data(other.m_data)
+{
+	other.m_data = nullptr;
+	other.m_rows = 0;
+	other.m_cols = 0;
+	other.m_wordsPerRow = 0;
+}
+
+BitMatrix& BitMatrix::operator=(BitMatrix&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	if (m_data)
+		free_aligned(m_data);
+
+	m_data = other.m_data;
+	m_rows = other.m_rows;
+	m_cols = other.m_cols;
+	m_wordsPerRow = other.m_wordsPerRow;
+
+	other.m_data = nullptr;
+	other.m_rows = 0;
+	other.m_cols = 0;
+	other.m_wordsPerRow = 0;
+	return *this;
+}
+
+bool BitMatrix::isZero() const
+{
+	size_t words = m_rows * m_wordsPerRow;
+
+	for (size_t w = 0; w < words; w += WORDS_PER_VECTOR)
+	{
+		if (m_data[w] | m_data[w + 1] | m_data[w + 2] | m_data[w + 3])
+			return false;
+	}
+
+	return true;
+}
+
+size_t BitMatrix::count() const
+{
+	size_t words = m_rows * m_wordsPerRow;
+	size_t result = 0;
+
+	for (size_t w = 0; w < words; w++)
+		result += std::popcount(m_data[w]);
+
+	return result;
+}
+
+bool BitMatrix::get(size_t row, size_t col) const
+{
+	if (row >= m_rows || col >= m_cols)
+		throw std::out_of_range("Matrix index out of bounds");
+
+	return (m_data[row * m_wordsPerRow + col / 64] >> (col % 64)) & 1;
+}
+
+void BitMatrix::set(size_t row, size_t col, bool value)
+{
+	if (row >= m_rows || col >= m_cols)
+		throw std::out_of_range("Matrix index out of bounds");
+
+	uint64_t& word = m_data[row * m_wordsPerRow + col / 64];
+	uint64_t mask = 1ull << (col % 64);
+
+	if (value)
+		word |= mask;
+	else
+		word &= ~mask;
+}
+
+BitMatrix& BitMatrix::operator|=(const BitMatrix& other)
+{
+	if (m_rows != other.m_rows || m_cols != other.m_cols)
+		throw std::invalid_argument("Invalid argument: Matrices must have the same shape");
+
+	if (m_data)
+		kernels::active().orWords(other.m_data, m_data, m_rows * m_wordsPerRow);
+
+	return *this;
+}
+
+BitMatrix BitMatrix::Identity(size_t size)
+{
+	BitMatrix mat(size);
+
+	for (size_t i = 0; i < size; i++)
+		mat.m_data[i * mat.m_wordsPerRow + i / 64] |= 1ull << (i % 64);
+
+	return mat;
+}
+
+BitMatrix linear_algebra::operator*(const BitMatrix& lhs, const BitMatrix& rhs)
+{
+	if (lhs.m_cols != rhs.m_rows)
+		throw std::invalid_argument("Invalid argument: Multiplied matrix column count must be equal to the row count of matrix multiplied by");
+
+	BitMatrix result(lhs.m_rows, rhs.m_cols);
+	multiplyInto(lhs, rhs, result);
+	return result;
+}
+
+// Four Russians: the output is processed in 256-bit wide column stripes. For every block of
+// 8 rhs rows a table holding all 256 ORs of those rows is built, after which every output
+// row needs a single table lookup (indexed by the matching 8 bits of lhs) and one OR per block
+void linear_algebra::multiplyInto(const BitMatrix& lhs, const BitMatrix& rhs, BitMatrix& out)
+{
+	if (lhs.m_cols != rhs.m_rows)
+		throw std::invalid_argument("Invalid argument: Multiplied matrix column count must be equal to the row count of matrix multiplied by");
+
+	if (&out == &lhs || &out == &rhs)
+		throw std::invalid_argument("Invalid argument: Output matrix cannot be one of the operands");
+
+	if (out.m_rows != lhs.m_rows || out.m_cols != rhs.m_cols)
+		out = BitMatrix(lhs.m_rows, rhs.m_cols);
+
+	DIGRAPH_PROFILE_SCOPE("boolean gemm");
+	DIGRAPH_PROFILE_COUNT(Multiplies, 1);
+
+	if (out.m_data)
+		std::memset(out.m_data, 0, out.m_rows * out.m_wordsPerRow * sizeof(uint64_t));
+
+	size_t inner = lhs.m_cols;
+	size_t stripes = out.m_wordsPerRow / WORDS_PER_VECTOR;
+
+	auto multiplyStripe = [&](size_t stripe)
+	{
+		// the stripe ORs are 4 independent words, which the compiler turns into
+		// vector code for whatever the baseline target is
+		alignas(SIMD_ALIGNMENT) uint64_t table[256 * WORDS_PER_VECTOR];
+		size_t wordOffset = stripe * WORDS_PER_VECTOR;
+
+		for (size_t kb = 0; kb < inner; kb += 8)
+		{
+			size_t blockRows = std::min<size_t>(8, inner - kb);
+
+			// table[x] = table[x without its lowest bit] | rhs row of that bit
+			std::memset(table, 0, WORDS_PER_VECTOR * sizeof(uint64_t));
+			for (size_t x = 1; x < 256; x++)
+			{
+				size_t low = std::countr_zero(x);
+				const uint64_t* prev = &table[(x & (x - 1)) * WORDS_PER_VECTOR];
+				uint64_t* entry = &table[x * WORDS_PER_VECTOR];
+
+				if (low < blockRows)
+				{
+					const uint64_t* row = &rhs.m_data[(kb + low) * rhs.m_wordsPerRow + wordOffset];
+					for (size_t w = 0; w < WORDS_PER_VECTOR; w++)
+						entry[w] = prev[w] | row[w];
+				}
+				else
+					std::memcpy(entry, prev, WORDS_PER_VECTOR * sizeof(uint64_t));
+			}
+
+			for (size_t i = 0; i < lhs.m_rows; i++)
+			{
+				size_t bits = (lhs.m_data[i * lhs.m_wordsPerRow + kb / 64] >> (kb % 64)) & 0xFF;
+				if (!bits)
+					continue;
+
+				uint64_t* dst = &out.m_data[i * out.m_wordsPerRow + wordOffset];
+				const uint64_t* entry = &table[bits * WORDS_PER_VECTOR];
+				for (size_t w = 0; w < WORDS_PER_VECTOR; w++)
+					dst[w] |= entry[w];
+			}
+		}
+	};
+
+	if (lhs.m_rows * inner * out.m_cols >= PARALLEL_BOOL_GEMM_MIN_WORK)
+		ThreadPool::Global().parallelFor(stripes, multiplyStripe);
+	else
+	{
+		for (size_t stripe = 0; stripe < stripes; stripe++)
+			multiplyStripe(stripe);
+	}
+}
+
+BitMatrix linear_algebra::pow(const BitMatrix& mat, uint64_t pow)
+{
+	if (pow == 0 && !mat.isSquare())
+		throw std::invalid_argument("Bringing non-square matrix to the power of 0 is undefined");
+	else if (pow == 0)
+		return BitMatrix::Identity(mat.getRowCount());
+
+	if (pow == 1)
+		return mat;
+
+	if (!mat.isSquare())
+		throw std::invalid_argument("Invalid argument: Only square matrices can be raised to a power");
+
+	// same buffer ping-ponging as the SIMDMatrix overload
+	size_t size = mat.getRowCount();
+	BitMatrix base = mat;
+	BitMatrix result(size);
+	BitMatrix scratch(size);
+	bool resultSet = false;
+
+	while (true)
+	{
+		if (pow & 1)
+		{
+			if (!resultSet)
+			{
+				result = base;
+				resultSet = true;
+			}
+			else
+			{
+				multiplyInto(result, base, scratch);
+				swap(result, scratch);
+			}
+		}
+
+		pow >>= 1;
+		if (pow == 0)
+			break;
+
+		multiplyInto(base, base, scratch);
+		swap(base, scratch);
+	}
+
+	return result;
+}
\ No newline at end of file
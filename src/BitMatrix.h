@@ -0,0 +1,112 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+namespace linear_algebra
+{
+	// Boolean matrix storing 1 bit per entry. Rows are made of 64-bit words and
+	// padded to a multiple of 256 bits, so every row can be processed with whole AVX2 registers.
+	// Multiplication works over the boolean semiring (OR of ANDs).
+	class BitMatrix
+	{
+	public:
+		BitMatrix()
+			: m_rows(0), m_cols(0), m_wordsPerRow(0), m_data(nullptr)
+		{ }
+
+		BitMatrix(size_t rc);
+		BitMatrix(size_t rows, size_t cols);
+		~BitMatrix();
+
+		// copy ctors
+		BitMatrix(const BitMatrix& other);
+		BitMatrix& operator=(const BitMatrix& other);
+
+		// move ctors
+		BitMatrix(BitMatrix&& other) noexcept;
+		BitMatrix& operator=(BitMatrix&& other) noexcept;
+
+		bool isSquare() const { return m_cols == m_rows; }
+		bool isZero() const;
+
+		// number of set entries
+		size_t count() const;
+
+		bool get(size_t row, size_t col) const;
+		void set(size_t row, size_t col, bool value);
+
+		size_t getRowCount() const { return m_rows; }
+		size_t getColCount() const { return m_cols; }
+		size_t getByteSize() const { return m_rows * m_wordsPerRow * sizeof(uint64_t); }
+
+		// calls fn(row, col) for every set entry, in row-major order
+		template <typename Fn>
+		void forEachSetBit(Fn&& fn) const
+		{
+			for (size_t i = 0; i < m_rows; i++)
+			{
+				const uint64_t* row = &m_data[i * m_wordsPerRow];
+				for (size_t w = 0; w < m_wordsPerRow; w++)
+				{
+					uint64_t word = row[w];
+					while (word)
+					{
+						fn(i, w * 64 + std::countr_zero(word));
+						word &= word - 1;
+					}
+				}
+			}
+		}
+
+		// entrywise OR, both matrices need the same shape
+		BitMatrix& operator|=(const BitMatrix& other);
+
+		friend BitMatrix operator*(const BitMatrix& lhs, const BitMatrix& rhs);
+		friend void multiplyInto(const BitMatrix& lhs, const BitMatrix& rhs, BitMatrix& out);
+
+		static BitMatrix Identity(size_t size);
+
+		friend void swap(BitMatrix& lhs, BitMatrix& rhs) noexcept
+		{
+			std::swap(lhs.m_rows, rhs.m_rows);
+			std::swap(lhs.m_cols, rhs.m_cols);
+			std::swap(lhs.m_wordsPerRow, rhs.m_wordsPerRow);
+			std::swap(lhs.m_data, rhs.m_data);
+		}
+
+	private:
+		void initialize();
+
+	private:
+		size_t m_rows, m_cols, m_wordsPerRow;
+		uint64_t* m_data;
+	};
+
+	BitMatrix operator*(const BitMatrix& lhs, const BitMatrix& rhs);
+
+	// boolean product, same contract as the SIMDMatrix overload
+	void multiplyInto(const BitMatrix& lhs, const BitMatrix& rhs, BitMatrix& out);
+
+	// entry (i, j) is set when a walk of exactly pow steps leads from i to j
+	BitMatrix pow(const BitMatrix& mat, uint64_t pow);
+}
\ No newline at end of file
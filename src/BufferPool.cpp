@@ -0,0 +1,223 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "BufferPool.h"
+#include "AlignedAlloc.h"
+#include "Profiler.h"
+
+using namespace linear_algebra;
+
+// smallest size class, one cache line
+static constexpr size_t MIN_BLOCK_SIZE = BufferPool::POOL_ALIGNMENT;
+
+static void* systemAllocate(size_t capacity, bool& hugePages)
+{
+	hugePages = false;
+
+#ifdef __linux__
+	if (capacity >= BufferPool::HUGE_BLOCK_SIZE)
+	{
+		void* ptr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (ptr == MAP_FAILED)
+			return nullptr;
+
+		// transparent huge pages cut the TLB misses of walking a big matrix column-wise,
+		// the advice is only a hint and failing it costs nothing
+		hugePages = madvise(ptr, capacity, MADV_HUGEPAGE) == 0;
+		return ptr;
+	}
+#endif
+
+	return alloc_aligned(capacity, BufferPool::POOL_ALIGNMENT);
+}
+
+static void systemFree(void* ptr, size_t capacity)
+{
+#ifdef __linux__
+	if (capacity >= BufferPool::HUGE_BLOCK_SIZE)
+	{
+		munmap(ptr, capacity);
+		return;
+	}
+#endif
+
+	free_aligned(ptr);
+}
+
+BufferPool::BufferPool(size_t cacheLimit)
+	: m_cacheLimit(cacheLimit)
+{ }
+
+BufferPool::~BufferPool()
+{
+	trim();
+}
+
+size_t BufferPool::sizeClass(size_t bytes)
+{
+	if (bytes <= MIN_BLOCK_SIZE)
+		return MIN_BLOCK_SIZE;
+
+	// bytes in (2^k, 2^(k+1)] round up to a multiple of 2^(k-2), keeping every
+	// class a whole number of cache lines
+	size_t exponent = std::bit_width(bytes - 1) - 1;
+	size_t step = std::max(size_t(1) << (exponent - 2), MIN_BLOCK_SIZE);
+	return (bytes + step - 1) & ~(step - 1);
+}
+
+void* BufferPool::allocate(size_t bytes)
+{
+	if (bytes == 0)
+		return nullptr;
+
+	size_t capacity = sizeClass(bytes);
+	void* ptr = nullptr;
+	DIGRAPH_PROFILE_COUNT(BytesAllocated, capacity);
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_stats.allocations++;
+
+		auto it = m_freeLists.find(capacity);
+		if (it != m_freeLists.end() && !it->second.empty())
+		{
+			ptr = it->second.back();
+			it->second.pop_back();
+
+			m_stats.poolHits++;
+			m_stats.bytesCached -= capacity;
+			m_stats.bytesInUse += capacity;
+			m_stats.peakBytesInUse = std::max(m_stats.peakBytesInUse, m_stats.bytesInUse);
+			return ptr;
+		}
+	}
+
+	bool hugePages;
+	ptr = systemAllocate(capacity, hugePages);
+
+	if (!ptr)
+	{
+		// cached blocks of other classes may be all that stands in the way
+		trim();
+		ptr = systemAllocate(capacity, hugePages);
+
+		if (!ptr)
+			throw std::bad_alloc();
+	}
+
+	std::lock_guard lock(m_mutex);
+	m_stats.systemAllocations++;
+	m_stats.hugePageBlocks += hugePages;
+	m_stats.bytesInUse += capacity;
+	m_stats.peakBytesInUse = std::max(m_stats.peakBytesInUse, m_stats.bytesInUse);
+	return ptr;
+}
+
+void BufferPool::release(void* ptr, size_t bytes)
+{
+	if (!ptr)
+		return;
+
+	size_t capacity = sizeClass(bytes);
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_stats.releases++;
+		m_stats.bytesInUse -= capacity;
+
+		if (m_stats.bytesCached + capacity <= m_cacheLimit)
+		{
+			m_freeLists[capacity].push_back(ptr);
+			m_stats.bytesCached += capacity;
+			return;
+		}
+	}
+
+	systemFree(ptr, capacity);
+}
+
+void BufferPool::trimTo(size_t limit)
+{
+	std::vector<std::pair<void*, size_t>> evicted;
+
+	{
+		std::lock_guard lock(m_mutex);
+
+		// the biggest blocks go first, they are the least likely to be asked for again
+		for (auto it = m_freeLists.rbegin(); it != m_freeLists.rend() && m_stats.bytesCached > limit; ++it)
+		{
+			while (!it->second.empty() && m_stats.bytesCached > limit)
+			{
+				evicted.emplace_back(it->second.back(), it->first);
+				it->second.pop_back();
+				m_stats.bytesCached -= it->first;
+			}
+		}
+	}
+
+	for (auto [ptr, capacity] : evicted)
+		systemFree(ptr, capacity);
+}
+
+void BufferPool::trim()
+{
+	trimTo(0);
+}
+
+void BufferPool::setCacheLimit(size_t bytes)
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_cacheLimit = bytes;
+	}
+
+	trimTo(bytes);
+}
+
+size_t BufferPool::getCacheLimit() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_cacheLimit;
+}
+
+BufferPoolStats BufferPool::stats() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_stats;
+}
+
+void BufferPool::resetStats()
+{
+	std::lock_guard lock(m_mutex);
+	m_stats.allocations = 0;
+	m_stats.poolHits = 0;
+	m_stats.systemAllocations = 0;
+	m_stats.hugePageBlocks = 0;
+	m_stats.releases = 0;
+	m_stats.peakBytesInUse = m_stats.bytesInUse;
+}
+
+BufferPool& BufferPool::Global()
+{
+	static BufferPool pool;
+	return pool;
+}
\ No newline at end of file
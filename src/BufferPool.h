@@ -0,0 +1,95 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+namespace linear_algebra
+{
+	// counters of a BufferPool. The call counts only grow until resetStats,
+	// the byte counts describe the current state
+	struct BufferPoolStats
+	{
+		uint64_t allocations = 0;		// allocate() calls
+		uint64_t poolHits = 0;			// allocations served from a free list
+		uint64_t systemAllocations = 0;	// allocations that had to go to the system
+		uint64_t hugePageBlocks = 0;	// system allocations advised to use huge pages
+		uint64_t releases = 0;			// release() calls
+
+		size_t bytesInUse = 0;
+		size_t peakBytesInUse = 0;
+		size_t bytesCached = 0;			// free blocks kept for reuse
+	};
+
+	// Recycles matrix buffers. Requests are rounded up to a size class (four per power of
+	// two, so at most a quarter is wasted) and released blocks wait in the free list of
+	// their class for the next request of that class. Blocks are POOL_ALIGNMENT aligned,
+	// ones of at least HUGE_BLOCK_SIZE are mapped on their own and advised to use huge
+	// pages where the OS supports it. At most the cache limit worth of free blocks is kept,
+	// anything beyond that goes straight back to the system
+	class BufferPool
+	{
+	public:
+		static constexpr size_t POOL_ALIGNMENT = 64;
+		static constexpr size_t HUGE_BLOCK_SIZE = 2ull << 20;
+		static constexpr size_t DEFAULT_CACHE_LIMIT = 512ull << 20;
+
+		explicit BufferPool(size_t cacheLimit = DEFAULT_CACHE_LIMIT);
+		~BufferPool();
+
+		BufferPool(const BufferPool&) = delete;
+		BufferPool& operator=(const BufferPool&) = delete;
+
+		// returns nullptr for 0 bytes, throws std::bad_alloc when the system is out of memory.
+		// the contents of a recycled block are whatever its last user left there
+		void* allocate(size_t bytes);
+
+		// bytes has to be the size the block was allocated with
+		void release(void* ptr, size_t bytes);
+
+		// frees every cached block
+		void trim();
+
+		// a limit of 0 turns caching off, every release then frees its block right away
+		void setCacheLimit(size_t bytes);
+		size_t getCacheLimit() const;
+
+		BufferPoolStats stats() const;
+
+		// zeroes the call counts and restarts the peak from the current usage
+		void resetStats();
+
+		// pool used by every matrix of the library
+		static BufferPool& Global();
+
+		// bytes actually reserved for a request of the given size
+		static size_t sizeClass(size_t bytes);
+
+	private:
+		void trimTo(size_t limit);
+
+	private:
+		mutable std::mutex m_mutex;
+		std::map<size_t, std::vector<void*>> m_freeLists;
+		size_t m_cacheLimit;
+		BufferPoolStats m_stats;
+	};
+}
\ No newline at end of file
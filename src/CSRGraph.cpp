@@ -0,0 +1,313 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "CSRGraph.h"
+#include "Profiler.h"
+
+using namespace graph;
+
+namespace
+{
+	struct CSRArrays
+	{
+		std::vector<uint64_t> offsets;
+		std::vector<Vertex> targets;
+	};
+}
+
+static const uint64_t EMPTY_OFFSETS[1] = { 0 };
+
+CSRGraph::CSRGraph()
+	: m_offsets(EMPTY_OFFSETS)
+{ }
+
+CSRGraph CSRGraph::FromArrays(std::span<const uint64_t> offsets, std::span<const Vertex> targets, std::shared_ptr<const void> storage)
+{
+	if (offsets.empty() || offsets.front() != 0 || offsets.back() != targets.size())
+		throw std::invalid_argument("Invalid argument: Offsets don't describe the targets array");
+
+	if (offsets.size() - 1 > std::numeric_limits<Vertex>::max())
+		throw std::invalid_argument("Invalid argument: Too many vertices");
+
+	size_t verticesCount = offsets.size() - 1;
+	for (size_t v = 0; v < verticesCount; v++)
+	{
+		if (offsets[v] > offsets[v + 1])
+			throw std::invalid_argument("Invalid argument: Offsets don't describe the targets array");
+
+		// sorted without duplicates, which also keeps every target but the last below the next one
+		for (uint64_t ix = offsets[v]; ix < offsets[v + 1]; ix++)
+		{
+			if (targets[ix] >= verticesCount || (ix != offsets[v] && targets[ix - 1] >= targets[ix]))
+				throw std::invalid_argument("Invalid argument: Adjacency lists have to be sorted vertices of the graph");
+		}
+	}
+
+	CSRGraph csr;
+	csr.m_storage = std::move(storage);
+	csr.m_offsets = offsets;
+	csr.m_targets = targets;
+	return csr;
+}
+
+CSRGraph CSRGraph::FromEdges(size_t verticesCount, const std::vector<Edge>& edges)
+{
+	DIGRAPH_PROFILE_SCOPE("build adjacency");
+
+	if (verticesCount > std::numeric_limits<Vertex>::max())
+		throw std::invalid_argument("Invalid argument: Too many vertices");
+
+	auto arrays = std::make_shared<CSRArrays>();
+	std::vector<uint64_t>& offsets = arrays->offsets;
+	std::vector<Vertex>& targets = arrays->targets;
+	offsets.assign(verticesCount + 1, 0);
+
+	// counting sort by source vertex
+	for (const Edge& edge : edges)
+	{
+		if (edge.from >= verticesCount || edge.to >= verticesCount)
+			throw std::out_of_range("Edge endpoint out of range");
+
+		offsets[edge.from + 1]++;
+	}
+
+	for (size_t v = 0; v < verticesCount; v++)
+		offsets[v + 1] += offsets[v];
+
+	std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+	targets.resize(edges.size());
+
+	for (const Edge& edge : edges)
+		targets[cursor[edge.from]++] = edge.to;
+
+	// sort every adjacency list and squeeze out duplicates in place
+	uint64_t write = 0;
+	for (size_t v = 0; v < verticesCount; v++)
+	{
+		auto begin = targets.begin() + offsets[v];
+		auto end = targets.begin() + offsets[v + 1];
+		std::sort(begin, end);
+
+		offsets[v] = write;
+		for (auto it = begin; it != end; ++it)
+		{
+			if (it != begin && *it == *(it - 1))
+				continue;
+
+			targets[write++] = *it;
+		}
+	}
+
+	offsets[verticesCount] = write;
+	targets.resize(write);
+	targets.shrink_to_fit();
+
+	CSRGraph csr;
+	csr.m_offsets = offsets;
+	csr.m_targets = targets;
+	csr.m_storage = std::move(arrays);
+	return csr;
+}
+
+bool CSRGraph::hasEdge(Vertex from, Vertex to) const
+{
+	if (from >= getVertexCount() || to >= getVertexCount())
+		return false;
+
+	auto list = successors(from);
+	return std::binary_search(list.begin(), list.end(), to);
+}
+
+CSRGraph CSRGraph::withEdge(Vertex from, Vertex to) const
+{
+	if (from >= getVertexCount() || to >= getVertexCount())
+		throw std::out_of_range("Edge endpoint out of range");
+
+	if (hasEdge(from, to))
+		return *this;
+
+	auto arrays = std::make_shared<CSRArrays>();
+	arrays->offsets.assign(m_offsets.begin(), m_offsets.end());
+	for (size_t v = from + 1; v < arrays->offsets.size(); v++)
+		arrays->offsets[v]++;
+
+	// the new target goes where it keeps the list of from sorted
+	auto list = successors(from);
+	size_t at = m_offsets[from] + (std::lower_bound(list.begin(), list.end(), to) - list.begin());
+
+	arrays->targets.reserve(m_targets.size() + 1);
+	arrays->targets.insert(arrays->targets.end(), m_targets.begin(), m_targets.begin() + at);
+	arrays->targets.push_back(to);
+	arrays->targets.insert(arrays->targets.end(), m_targets.begin() + at, m_targets.end());
+
+	CSRGraph csr;
+	csr.m_offsets = arrays->offsets;
+	csr.m_targets = arrays->targets;
+	csr.m_storage = std::move(arrays);
+	return csr;
+}
+
+CSRGraph CSRGraph::withoutEdge(Vertex from, Vertex to) const
+{
+	if (!hasEdge(from, to))
+		return *this;
+
+	auto arrays = std::make_shared<CSRArrays>();
+	arrays->offsets.assign(m_offsets.begin(), m_offsets.end());
+	for (size_t v = from + 1; v < arrays->offsets.size(); v++)
+		arrays->offsets[v]--;
+
+	auto list = successors(from);
+	size_t at = m_offsets[from] + (std::lower_bound(list.begin(), list.end(), to) - list.begin());
+
+	arrays->targets.reserve(m_targets.size() - 1);
+	arrays->targets.insert(arrays->targets.end(), m_targets.begin(), m_targets.begin() + at);
+	arrays->targets.insert(arrays->targets.end(), m_targets.begin() + at + 1, m_targets.end());
+
+	CSRGraph csr;
+	csr.m_offsets = arrays->offsets;
+	csr.m_targets = arrays->targets;
+	csr.m_storage = std::move(arrays);
+	return csr;
+}
+
+// FNV-1a over whole elements instead of bytes
+template<typename T>
+static uint64_t hashElements(uint64_t hash, std::span<const T> elements)
+{
+	for (T element : elements)
+		hash = (hash ^ element) * 0x100000001b3ull;
+
+	return hash;
+}
+
+uint64_t CSRGraph::fingerprint() const
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	hash = (hash ^ getVertexCount()) * 0x100000001b3ull;
+	hash = hashElements(hash, m_offsets);
+	return hashElements(hash, m_targets);
+}
+
+// iterative DFS restricted to vertices not marked done, returns the first cycle it closes
+static std::vector<Vertex> findCycle(const CSRGraph& graph, std::vector<uint8_t>& state)
+{
+	enum : uint8_t { Unvisited = 0, OnStack = 1, Done = 2 };
+
+	struct Frame
+	{
+		Vertex vertex;
+		uint64_t next;
+	};
+
+	std::vector<Frame> stack;
+
+	for (Vertex root = 0; root < graph.getVertexCount(); root++)
+	{
+		if (state[root] != Unvisited)
+			continue;
+
+		state[root] = OnStack;
+		stack.push_back({ root, 0 });
+
+		while (!stack.empty())
+		{
+			Frame& frame = stack.back();
+			auto list = graph.successors(frame.vertex);
+
+			if (frame.next == list.size())
+			{
+				state[frame.vertex] = Done;
+				stack.pop_back();
+				continue;
+			}
+
+			Vertex w = list[frame.next++];
+
+			if (state[w] == Unvisited)
+			{
+				state[w] = OnStack;
+				stack.push_back({ w, 0 });
+			}
+			else if (state[w] == OnStack)
+			{
+				// back edge, the cycle is the stack from w upwards
+				auto start = std::find_if(stack.begin(), stack.end(), [w](const Frame& f) { return f.vertex == w; });
+
+				std::vector<Vertex> cycle;
+				cycle.reserve(std::distance(start, stack.end()));
+				for (auto it = start; it != stack.end(); ++it)
+					cycle.push_back(it->vertex);
+
+				return cycle;
+			}
+		}
+	}
+
+	return {};
+}
+
+TopologicalOrder graph::topologicalSort(const CSRGraph& graph)
+{
+	DIGRAPH_PROFILE_SCOPE("topological sort");
+
+	size_t n = graph.getVertexCount();
+
+	std::vector<uint32_t> inDegree(n, 0);
+	for (Vertex v = 0; v < n; v++)
+	{
+		for (Vertex w : graph.successors(v))
+			inDegree[w]++;
+	}
+
+	TopologicalOrder result;
+	result.order.reserve(n);
+
+	for (Vertex v = 0; v < n; v++)
+	{
+		if (inDegree[v] == 0)
+			result.order.push_back(v);
+	}
+
+	// the order vector doubles as the queue
+	for (size_t head = 0; head < result.order.size(); head++)
+	{
+		for (Vertex w : graph.successors(result.order[head]))
+		{
+			if (--inDegree[w] == 0)
+				result.order.push_back(w);
+		}
+	}
+
+	result.acyclic = result.order.size() == n;
+	if (result.acyclic)
+		return result;
+
+	// everything Kahn managed to remove can't be a part of a cycle
+	std::vector<uint8_t> state(n, 0);
+	for (Vertex v : result.order)
+		state[v] = 2;
+
+	result.cycle = findCycle(graph, state);
+	result.order.clear();
+	return result;
+}
\ No newline at end of file
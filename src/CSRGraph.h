@@ -0,0 +1,94 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+namespace graph
+{
+	using Vertex = uint32_t;
+
+	struct Edge
+	{
+		Vertex from, to;
+	};
+
+	// Compressed sparse row adjacency: the successors of v are
+	// m_targets[m_offsets[v] .. m_offsets[v + 1]), sorted and without duplicates.
+	// Memory is O(V + E), so it works for graphs a dense matrix could never hold.
+	// The arrays are immutable and shared between copies, m_storage keeps them alive
+	// whether they were built in memory or live in a mapped file
+	class CSRGraph
+	{
+	public:
+		CSRGraph();
+
+		// builds the graph in O(V + E) (plus sorting every adjacency list), duplicates are dropped
+		static CSRGraph FromEdges(size_t verticesCount, const std::vector<Edge>& edges);
+
+		// views arrays laid out as described above without copying them, storage owns their memory.
+		// Both are checked in one pass over them (offsets, targets and their order), so a damaged
+		// file can't send anything out of bounds
+		static CSRGraph FromArrays(std::span<const uint64_t> offsets, std::span<const Vertex> targets, std::shared_ptr<const void> storage);
+
+		size_t getVertexCount() const { return m_offsets.size() - 1; }
+		size_t getEdgeCount() const { return m_targets.size(); }
+
+		std::span<const Vertex> successors(Vertex v) const
+		{
+			return { m_targets.data() + m_offsets[v], m_targets.data() + m_offsets[v + 1] };
+		}
+
+		bool hasEdge(Vertex from, Vertex to) const;
+
+		// copies with one edge more or one less, O(V + E). A copy of this very graph when
+		// there is nothing to change
+		CSRGraph withEdge(Vertex from, Vertex to) const;
+		CSRGraph withoutEdge(Vertex from, Vertex to) const;
+
+		// hash of the vertex count and every edge, tells apart the graphs data derived from
+		// one of them (like a saved ReachabilityIndex) belongs to. Reads all the arrays
+		uint64_t fingerprint() const;
+
+		std::span<const uint64_t> offsets() const { return m_offsets; }
+		std::span<const Vertex> targets() const { return m_targets; }
+
+	private:
+		std::shared_ptr<const void> m_storage;
+		std::span<const uint64_t> m_offsets;
+		std::span<const Vertex> m_targets;
+	};
+
+	struct TopologicalOrder
+	{
+		bool acyclic;
+
+		// every vertex, each one placed before all of its successors. Only valid when acyclic
+		std::vector<Vertex> order;
+
+		// one cycle v0 -> v1 -> ... -> vk -> v0 when the graph is not acyclic
+		std::vector<Vertex> cycle;
+	};
+
+	// Kahn's algorithm, O(V + E). When it gets stuck, a depth first search over the
+	// leftover vertices (each of which still has a leftover predecessor) extracts a cycle
+	TopologicalOrder topologicalSort(const CSRGraph& graph);
+}
\ No newline at end of file
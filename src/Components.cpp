@@ -0,0 +1,183 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Components.h"
+#include "Profiler.h"
+
+using namespace graph;
+
+static constexpr uint32_t UNVISITED = std::numeric_limits<uint32_t>::max();
+
+size_t StronglyConnectedComponents::getCyclicCount() const
+{
+	return std::count(cyclic.begin(), cyclic.end(), uint8_t(1));
+}
+
+// the recursion of the textbook version becomes a stack of frames, each remembering how far
+// it got through the successors of its vertex. Visit order numbers double as "on the stack"
+// marks: once a component is complete its vertices get their component instead
+StronglyConnectedComponents graph::stronglyConnectedComponents(const CSRGraph& graph)
+{
+	DIGRAPH_PROFILE_SCOPE("strongly connected components");
+
+	size_t n = graph.getVertexCount();
+
+	struct Frame
+	{
+		Vertex vertex;
+		uint64_t next;
+	};
+
+	StronglyConnectedComponents result;
+	result.component.assign(n, UNVISITED);
+	result.memberOffsets.push_back(0);
+	result.members.reserve(n);
+
+	std::vector<uint32_t> order(n, UNVISITED);
+	std::vector<uint32_t> lowLink(n);
+	std::vector<Vertex> pending;
+	std::vector<Frame> frames;
+	uint32_t visited = 0;
+
+	for (Vertex root = 0; root < n; root++)
+	{
+		if (order[root] != UNVISITED)
+			continue;
+
+		order[root] = lowLink[root] = visited++;
+		pending.push_back(root);
+		frames.push_back({ root, 0 });
+
+		while (!frames.empty())
+		{
+			Frame& frame = frames.back();
+			Vertex v = frame.vertex;
+			auto list = graph.successors(v);
+
+			if (frame.next < list.size())
+			{
+				Vertex w = list[frame.next++];
+
+				if (order[w] == UNVISITED)
+				{
+					order[w] = lowLink[w] = visited++;
+					pending.push_back(w);
+					frames.push_back({ w, 0 });
+				}
+				else if (result.component[w] == UNVISITED)
+					lowLink[v] = std::min(lowLink[v], order[w]);
+
+				continue;
+			}
+
+			frames.pop_back();
+			if (!frames.empty())
+			{
+				Vertex parent = frames.back().vertex;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[v]);
+			}
+
+			if (lowLink[v] != order[v])
+				continue;
+
+			// v is the root of a component made of everything pending above it
+			uint32_t c = static_cast<uint32_t>(result.getComponentCount());
+			size_t first = result.members.size();
+			Vertex w;
+
+			do
+			{
+				w = pending.back();
+				pending.pop_back();
+				result.component[w] = c;
+				result.members.push_back(w);
+			} while (w != v);
+
+			// the root goes first
+			std::reverse(result.members.begin() + first, result.members.end());
+			result.memberOffsets.push_back(result.members.size());
+			result.cyclic.push_back(result.members.size() - first > 1 || graph.hasEdge(v, v));
+		}
+	}
+
+	return result;
+}
+
+std::vector<Vertex> graph::componentCycle(const CSRGraph& graph, const StronglyConnectedComponents& components, uint32_t c)
+{
+	if (!components.cyclic[c])
+		return {};
+
+	std::span<const Vertex> members = components.componentMembers(c);
+	Vertex start = members.front();
+
+	if (graph.hasEdge(start, start))
+		return { start };
+
+	// parents are kept per member only, the search never leaves the component
+	std::unordered_map<Vertex, Vertex> parent;
+	parent.reserve(members.size());
+	parent.emplace(start, start);
+
+	std::vector<Vertex> frontier = { start };
+	for (size_t head = 0; head < frontier.size(); head++)
+	{
+		Vertex v = frontier[head];
+
+		for (Vertex w : graph.successors(v))
+		{
+			if (w == start)
+			{
+				std::vector<Vertex> cycle;
+				for (Vertex u = v; u != start; u = parent[u])
+					cycle.push_back(u);
+
+				cycle.push_back(start);
+				std::reverse(cycle.begin(), cycle.end());
+				return cycle;
+			}
+
+			if (components.component[w] == c && parent.emplace(w, v).second)
+				frontier.push_back(w);
+		}
+	}
+
+	// unreachable, every member of a cyclic component leads back to its root
+	return {};
+}
+
+CSRGraph graph::condensation(const CSRGraph& graph, const StronglyConnectedComponents& components)
+{
+	std::vector<Edge> edges;
+
+	for (Vertex v = 0; v < graph.getVertexCount(); v++)
+	{
+		uint32_t from = components.component[v];
+		for (Vertex w : graph.successors(v))
+		{
+			if (components.component[w] != from)
+				edges.push_back({ from, components.component[w] });
+		}
+	}
+
+	return CSRGraph::FromEdges(components.getComponentCount(), edges);
+}
\ No newline at end of file
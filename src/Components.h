@@ -0,0 +1,63 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "CSRGraph.h"
+
+namespace graph
+{
+	// Strongly connected components, numbered in reverse topological order of the condensation:
+	// every edge u -> v has component[u] >= component[v], so sinks come first
+	struct StronglyConnectedComponents
+	{
+		// component of every vertex
+		std::vector<uint32_t> component;
+
+		// members of component c are members[memberOffsets[c] .. memberOffsets[c + 1]),
+		// the first one being the root of the search that found it
+		std::vector<uint64_t> memberOffsets;
+		std::vector<Vertex> members;
+
+		// whether a cycle goes through the component (more than one member or a self loop)
+		std::vector<uint8_t> cyclic;
+
+		size_t getComponentCount() const { return memberOffsets.size() - 1; }
+		size_t getCyclicCount() const;
+
+		std::span<const Vertex> componentMembers(uint32_t c) const
+		{
+			return { members.data() + memberOffsets[c], members.data() + memberOffsets[c + 1] };
+		}
+	};
+
+	// Tarjan's algorithm with an explicit stack, O(V + E) in a single pass over the edges,
+	// so neither deep chains nor multi-million edge graphs overflow the call stack
+	StronglyConnectedComponents stronglyConnectedComponents(const CSRGraph& graph);
+
+	// one cycle v0 -> v1 -> ... -> vk -> v0 through the first member of a cyclic component (a shortest
+	// one, found with a breadth first search inside the component), empty for an acyclic one
+	std::vector<Vertex> componentCycle(const CSRGraph& graph, const StronglyConnectedComponents& components, uint32_t c);
+
+	// the DAG with a vertex per component and an edge wherever an edge joins two of them
+	CSRGraph condensation(const CSRGraph& graph, const StronglyConnectedComponents& components);
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+namespace linear_algebra
+{
+	// value a saturated count sticks at
+	inline constexpr uint64_t COUNT_SATURATED = std::numeric_limits<uint64_t>::max();
+
+	// largest modulus the modular kernels accept, keeps every product below 2^62
+	inline constexpr uint64_t MAX_COUNT_MODULUS = (1ull << 31) - 1;
+
+	// How walk counts get combined. With modulus 0 counts are exact and stick at
+	// COUNT_SATURATED once they overflow, otherwise they are computed modulo modulus
+	struct CountArithmetic
+	{
+		uint64_t modulus = 0;
+
+		bool isModular() const { return modulus != 0; }
+	};
+
+	inline uint64_t saturatingAdd(uint64_t a, uint64_t b)
+	{
+		uint64_t sum = a + b;
+		return sum < a ? COUNT_SATURATED : sum;
+	}
+
+	inline uint64_t saturatingMul(uint64_t a, uint64_t b)
+	{
+#ifdef _MSC_VER
+		uint64_t high;
+		uint64_t low = _umul128(a, b, &high);
+		return high ? COUNT_SATURATED : low;
+#else
+		unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+		return (product >> 64) ? COUNT_SATURATED : static_cast<uint64_t>(product);
+#endif
+	}
+
+	namespace detail
+	{
+		// scalar multiply-add policies shared by the dense and sparse count kernels.
+		// mulAdd works on an unreduced accumulator, finish turns it into the final value
+		struct SaturatingOps
+		{
+			uint64_t mulAdd(uint64_t acc, uint64_t a, uint64_t b) const { return saturatingAdd(acc, saturatingMul(a, b)); }
+			uint64_t finish(uint64_t acc) const { return acc; }
+		};
+
+		// operands are below modulus, so a product stays below 2^62. the accumulator is kept
+		// below 2^63 by subtracting fold (the biggest multiple of modulus^2 not above 2^63)
+		// whenever it crosses it, and only gets reduced for real once at the end
+		struct ModularOps
+		{
+			uint64_t modulus;
+			uint64_t fold;
+
+			explicit ModularOps(uint64_t modulus)
+				: modulus(modulus), fold((1ull << 63) / (modulus * modulus) * (modulus * modulus))
+			{ }
+
+			uint64_t mulAdd(uint64_t acc, uint64_t a, uint64_t b) const
+			{
+				acc += a * b;
+				return (acc >> 63) ? acc - fold : acc;
+			}
+
+			uint64_t finish(uint64_t acc) const { return acc % modulus; }
+		};
+
+		// throws for moduli the kernels can't handle
+		void validateArithmetic(CountArithmetic arithmetic);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "CountMatrix.h"
+#include "ThreadPool.h"
+#include "Kernels.h"
+#include "Profiler.h"
+#include "Strassen.h"
+
+using namespace linear_algebra;
+
+// smaller products (counted in multiply-adds) stay on the calling thread
+static constexpr size_t PARALLEL_COUNT_GEMM_MIN_WORK = 128ull * 128ull * 128ull;
+static constexpr size_t COUNT_ROWS_PER_TASK = 16;
+
+void linear_algebra::detail::validateArithmetic(CountArithmetic arithmetic)
+{
+	if (arithmetic.isModular() && (arithmetic.modulus < 2 || arithmetic.modulus > MAX_COUNT_MODULUS))
+		throw std::invalid_argument("Invalid argument: Modulus has to be in [2, 2^31 - 1]");
+}
+
+// rows [rowBegin, rowEnd) of c (+)= a * b. Every row of c is built as a sum of the rows of b
+// scaled by the entries of a, so zero entries (most of an adjacency matrix) cost nothing.
+// n is the padded width, padding of b is zero so it stays zero in c. In modular mode the
+// accumulators stay unreduced (but below 2^63, see ModularOps) until the row is complete,
+// so a row costs one division per entry
+static void countRows(size_t rowBegin, size_t rowEnd, size_t n, size_t k, const uint64_t* a, size_t lda,
+	const uint64_t* b, size_t ldb, uint64_t* c, size_t ldc, const detail::ModularOps* modular, bool accumulate)
+{
+	const kernels::KernelTable& kernelTable = kernels::active();
+
+	for (size_t i = rowBegin; i < rowEnd; i++)
+	{
+		uint64_t* out = &c[i * ldc];
+		if (!accumulate)
+			std::memset(out, 0, n * sizeof(uint64_t));
+
+		for (size_t p = 0; p < k; p++)
+		{
+			uint64_t scalar = a[i * lda + p];
+			if (scalar == 0)
+				continue;
+
+			if (modular)
+				kernelTable.countAxpyModular(scalar, &b[p * ldb], out, n, modular->fold);
+			else
+				kernelTable.countAxpySaturating(scalar, &b[p * ldb], out, n);
+		}
+
+		if (modular)
+		{
+			for (size_t j = 0; j < n; j++)
+				out[j] = modular->finish(out[j]);
+		}
+	}
+}
+
+// rows [0, m) of c (+)= a * b, split into row blocks for the pool when big enough
+static void countProduct(size_t m, size_t n, size_t k, const uint64_t* a, size_t lda, const uint64_t* b, size_t ldb,
+	uint64_t* c, size_t ldc, CountArithmetic arithmetic, bool accumulate)
+{
+	DIGRAPH_PROFILE_SCOPE("count gemm");
+	DIGRAPH_PROFILE_COUNT(Multiplies, 1);
+	DIGRAPH_PROFILE_COUNT(Flops, 2 * m * n * k);
+
+	bool parallel = m * n * k >= PARALLEL_COUNT_GEMM_MIN_WORK;
+
+	std::optional<detail::ModularOps> modular;
+	if (arithmetic.isModular())
+		modular.emplace(arithmetic.modulus);
+
+	forEachRowBlock(m, COUNT_ROWS_PER_TASK, parallel, [&](size_t rowBegin, size_t rowEnd)
+	{
+		countRows(rowBegin, rowEnd, n, k, a, lda, b, ldb, c, ldc, modular ? &*modular : nullptr, accumulate);
+	});
+}
+
+// residues stay reduced through every sum and difference, as the modular kernel expects them
+struct ModularStrassenOps
+{
+	static constexpr size_t GROUP = CountMatrix::COLUMN_GROUP;
+	CountArithmetic arithmetic;
+
+	void multiply(size_t m, size_t n, size_t k, const uint64_t* a, size_t lda, const uint64_t* b, size_t ldb, uint64_t* c, size_t ldc, bool accumulate) const
+	{
+		countProduct(m, n, k, a, lda, b, ldb, c, ldc, arithmetic, accumulate);
+	}
+
+	void add(size_t rows, size_t cols, const uint64_t* a, size_t lda, const uint64_t* b, size_t ldb, uint64_t* out, size_t ldo) const
+	{
+		uint64_t modulus = arithmetic.modulus;
+		for (size_t i = 0; i < rows; i++)
+		for (size_t j = 0; j < cols; j++)
+		{
+			uint64_t sum = a[i * lda + j] + b[i * ldb + j];
+			out[i * ldo + j] = sum >= modulus ? sum - modulus : sum;
+		}
+	}
+
+	void sub(size_t rows, size_t cols, const uint64_t* a, size_t lda, const uint64_t* b, size_t ldb, uint64_t* out, size_t ldo) const
+	{
+		uint64_t modulus = arithmetic.modulus;
+		for (size_t i = 0; i < rows; i++)
+		for (size_t j = 0; j < cols; j++)
+		{
+			uint64_t x = a[i * lda + j], y = b[i * ldb + j];
+			out[i * ldo + j] = x >= y ? x - y : x + modulus - y;
+		}
+	}
+};
+
+void linear_algebra::multiplyInto(const CountMatrix& lhs, const CountMatrix& rhs, CountMatrix& out, CountArithmetic arithmetic)
+{
+	if (lhs.m_cols != rhs.m_rows)
+		throw std::invalid_argument("Invalid argument: Multiplied matrix column count must be equal to the row count of matrix multiplied by");
+
+	if (&out == &lhs || &out == &rhs)
+		throw std::invalid_argument("Invalid argument: Output matrix cannot be one of the operands");
+
+	detail::validateArithmetic(arithmetic);
+
+	if (out.m_rows != lhs.m_rows || out.m_cols != rhs.m_cols)
+		out = CountMatrix(lhs.m_rows, rhs.m_cols, Uninitialized);
+
+	// residues form a ring, saturated counts don't, so only modular products can subtract
+	size_t cutoff = getStrassenCutoff();
+	if (arithmetic.isModular() && cutoff != 0 && std::min({ lhs.m_rows, lhs.m_cols, rhs.m_cols }) >= cutoff)
+	{
+		DIGRAPH_PROFILE_SCOPE("strassen");
+
+		ModularStrassenOps ops{ arithmetic };
+		detail::StrassenWinograd<uint64_t, ModularStrassenOps>(ops, cutoff).multiply(out.m_strideRow, out.m_stride,
+			(lhs.m_cols + 3) & ~size_t(3), lhs.m_data, lhs.m_stride, rhs.m_data, rhs.m_stride, out.m_data, out.m_stride);
+		return;
+	}
+
+	countProduct(out.m_rows, out.m_stride, lhs.m_cols, lhs.m_data, lhs.m_stride, rhs.m_data, rhs.m_stride, out.m_data, out.m_stride, arithmetic, false);
+}
+
+void linear_algebra::multiplyAddInto(const CountMatrix& lhs, const CountMatrix& rhs, CountMatrix& out, CountArithmetic arithmetic)
+{
+	if (lhs.m_cols != rhs.m_rows)
+		throw std::invalid_argument("Invalid argument: Multiplied matrix column count must be equal to the row count of matrix multiplied by");
+
+	if (&out == &lhs || &out == &rhs)
+		throw std::invalid_argument("Invalid argument: Output matrix cannot be one of the operands");
+
+	if (out.m_rows != lhs.m_rows || out.m_cols != rhs.m_cols)
+		throw std::invalid_argument("Invalid argument: Accumulator must have the shape of the product");
+
+	detail::validateArithmetic(arithmetic);
+	countProduct(out.m_rows, out.m_stride, lhs.m_cols, lhs.m_data, lhs.m_stride, rhs.m_data, rhs.m_stride, out.m_data, out.m_stride, arithmetic, true);
+}
+
+CountMatrix linear_algebra::pow(const CountMatrix& mat, uint64_t pow, CountArithmetic arithmetic)
+{
+	detail::validateArithmetic(arithmetic);
+
+	if (pow == 0 && !mat.isSquare())
+		throw std::invalid_argument("Bringing non-square matrix to the power of 0 is undefined");
+	else if (pow == 0)
+		return CountMatrix::Identity(mat.getRowCount());
+
+	if (!mat.isSquare() && pow != 1)
+		throw std::invalid_argument("Invalid argument: Only square matrices can be raised to a power");
+
+	DIGRAPH_PROFILE_SCOPE("count pow");
+
+	size_t size = mat.getRowCount();
+	CountMatrix base = mat;
+
+	// the modular kernel expects reduced operands
+	if (arithmetic.isModular())
+	{
+		for (size_t i = 0; i < size; i++)
+		for (size_t j = 0; j < mat.getColCount(); j++)
+			base.set(i, j, base.get(i, j) % arithmetic.modulus);
+	}
+
+	if (pow == 1)
+		return base;
+
+	// same squaring over three preallocated buffers as the float overload
+	CountMatrix result(size, size, Uninitialized);
+	CountMatrix scratch(size, size, Uninitialized);
+	bool resultSet = false;
+
+	while (true)
+	{
+		if (pow & 1)
+		{
+			if (!resultSet)
+			{
+				result = base;
+				resultSet = true;
+			}
+			else
+			{
+				multiplyInto(result, base, scratch, arithmetic);
+				swap(result, scratch);
+			}
+		}
+
+		pow >>= 1;
+		if (pow == 0)
+			break;
+
+		multiplyInto(base, base, scratch, arithmetic);
+		swap(base, scratch);
+	}
+
+	return result;
+}
\ No newline at end of file
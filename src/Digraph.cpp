@@ -0,0 +1,1053 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Digraph.h"
+#include "Profiler.h"
+
+// graphs with a smaller fraction of edges than this count walks with sparse products,
+// which also switch over to dense ones once an intermediate result fills up past it
+static constexpr double SPARSE_DENSITY_LIMIT = 0.05;
+
+// dense walk matrices (and reachability indices) bigger than this are never allocated
+static constexpr size_t DENSE_MAX_BYTES = 1ull << 31;
+
+static bool fitsDense(size_t verticesCount)
+{
+	return verticesCount * verticesCount * sizeof(uint64_t) <= DENSE_MAX_BYTES;
+}
+
+static bool fitsClosure(size_t verticesCount)
+{
+	return verticesCount * graph::ReachabilityIndex::WordsPerRow(verticesCount) * sizeof(uint64_t) <= DENSE_MAX_BYTES;
+}
+
+// results are formatted into memory and written this many bytes at a time
+static constexpr size_t RESULT_CHUNK_BYTES = 1ull << 20;
+
+namespace
+{
+	// one fwrite per chunk instead of a (locking) print per line, which is what
+	// used to bound listing the millions of pairs of a dense graph
+	class ResultBuffer
+	{
+	public:
+		explicit ResultBuffer(std::FILE* file)
+			: m_file(file)
+		{ }
+
+		~ResultBuffer() { flush(); }
+
+		fmt::memory_buffer& buffer() { return m_buffer; }
+
+		// call after appending a line
+		void lineDone()
+		{
+			if (m_buffer.size() >= RESULT_CHUNK_BYTES)
+				flush();
+		}
+
+		void flush()
+		{
+			std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+			m_buffer.clear();
+		}
+
+	private:
+		std::FILE* m_file;
+		fmt::memory_buffer m_buffer;
+	};
+}
+
+bool Digraph::isLeadingTo(const std::string_view from, const std::string_view to) const
+{
+	std::optional<graph::Vertex> fv = m_vertices.find(from);
+	std::optional<graph::Vertex> tv = m_vertices.find(to);
+
+	if (!fv || !tv)
+		return false; // wrong vertex was specified
+
+	return m_graph.hasEdge(*fv, *tv);
+}
+
+bool Digraph::canReach(const std::string_view from, const std::string_view to) const
+{
+	std::optional<graph::Vertex> fv = m_vertices.find(from);
+	std::optional<graph::Vertex> tv = m_vertices.find(to);
+
+	if (!fv || !tv)
+		return false;
+
+	return canReach(*fv, *tv);
+}
+
+bool Digraph::canReach(size_t from, size_t to) const
+{
+	if (from >= m_verticesCount || to >= m_verticesCount)
+		throw std::out_of_range("Vertex index out of range");
+
+	if (const graph::ReachabilityIndex* index = reachability())
+		return index->reaches(static_cast<graph::Vertex>(from), static_cast<graph::Vertex>(to));
+
+	return searchReachable(from, to);
+}
+
+bool Digraph::searchReachable(size_t from, size_t to) const
+{
+	std::vector<bool> seen(m_verticesCount, false);
+	std::vector<graph::Vertex> frontier = { static_cast<graph::Vertex>(from) };
+
+	while (!frontier.empty())
+	{
+		graph::Vertex v = frontier.back();
+		frontier.pop_back();
+
+		for (graph::Vertex w : m_graph.successors(v))
+		{
+			if (w == to)
+				return true;
+
+			if (!seen[w])
+			{
+				seen[w] = true;
+				frontier.push_back(w);
+			}
+		}
+	}
+
+	return false;
+}
+
+bool Digraph::useReachabilityFile(const std::string_view filepath)
+{
+	const std::string path(filepath);
+
+	if (!fitsClosure(m_verticesCount))
+		throw std::runtime_error("The graph is too big for a reachability index");
+
+	// an index of another graph, or a damaged one, just gets replaced. Any other file is left alone
+	if (std::filesystem::exists(path))
+	{
+		if (!graph::isReachabilityFile(path))
+			throw std::runtime_error(fmt::format("{} is not a reachability index, not overwriting it", path));
+
+		try
+		{
+			if (std::optional<graph::ReachabilityIndex> loaded = graph::loadReachability(path, m_graph))
+			{
+				m_reach = std::move(loaded);
+				return true;
+			}
+		}
+		catch (const std::runtime_error&)
+		{ }
+	}
+
+	graph::saveReachability(path, *reachability(), m_graph);
+	return false;
+}
+
+const graph::ReachabilityIndex* Digraph::reachability() const
+{
+	if (!m_reach && fitsClosure(m_verticesCount))
+		m_reach = graph::ReachabilityIndex::Build(m_graph);
+
+	return m_reach ? &*m_reach : nullptr;
+}
+
+void Digraph::findAllPathsWithLength(uint64_t length) const
+{
+	DIGRAPH_PROFILE_SCOPE("find all paths");
+
+	ResultBuffer out(m_resultFile);
+	size_t pathCount = 0;
+	auto report = [&](size_t i, size_t j, uint64_t paths)
+	{
+		if (i == j)
+			return;
+
+		pathCount++;
+		if (m_countsOnly)
+			return;
+
+		fmt::format_to(std::back_inserter(out.buffer()), "There are ");
+		appendWalkCount(out.buffer(), paths);
+		fmt::format_to(std::back_inserter(out.buffer()), " paths of length {} from {} to {}\n", static_cast<uint32_t>(length), getVertexName(i), getVertexName(j));
+		out.lineDone();
+	};
+
+	forEachWalk(length, report);
+	fmt::format_to(std::back_inserter(out.buffer()), "{} paths of length {} were found!\n", pathCount, length);
+}
+
+void Digraph::findPathsFrom(const std::string_view from, uint64_t length) const
+{
+	DIGRAPH_PROFILE_SCOPE("find paths from");
+
+	ResultBuffer out(m_resultFile);
+	std::optional<size_t> source = findVertex(from);
+	if (!source)
+	{
+		fmt::format_to(std::back_inserter(out.buffer()), "There is no vertex {}\n", from);
+		return;
+	}
+
+	size_t pathCount = 0;
+	forEachWalkFrom(*source, length, [&](size_t j, uint64_t paths)
+	{
+		if (j == *source)
+			return;
+
+		pathCount++;
+		if (m_countsOnly)
+			return;
+
+		fmt::format_to(std::back_inserter(out.buffer()), "There are ");
+		appendWalkCount(out.buffer(), paths);
+		fmt::format_to(std::back_inserter(out.buffer()), " paths of length {} from {} to {}\n", length, from, getVertexName(j));
+		out.lineDone();
+	});
+
+	fmt::format_to(std::back_inserter(out.buffer()), "{} paths of length {} from {} were found!\n", pathCount, length, from);
+}
+
+void Digraph::findPathsBetween(const std::string_view from, const std::string_view to, uint64_t length) const
+{
+	DIGRAPH_PROFILE_SCOPE("find paths between");
+
+	ResultBuffer out(m_resultFile);
+	std::optional<size_t> source = findVertex(from);
+	std::optional<size_t> target = findVertex(to);
+	if (!source || !target)
+	{
+		fmt::format_to(std::back_inserter(out.buffer()), "There is no vertex {}\n", source ? to : from);
+		return;
+	}
+
+	std::optional<uint64_t> paths = countWalksBetween(*source, *target, length);
+
+	// a single pair is either connected or not, that's all there is to count
+	if (m_countsOnly)
+	{
+		fmt::format_to(std::back_inserter(out.buffer()), "{} is {}connected to {} by paths of length {}\n", from, paths ? "" : "not ", to, length);
+		return;
+	}
+
+	fmt::format_to(std::back_inserter(out.buffer()), "There are ");
+	if (paths)
+		appendWalkCount(out.buffer(), *paths);
+	else
+		fmt::format_to(std::back_inserter(out.buffer()), "no");
+
+	fmt::format_to(std::back_inserter(out.buffer()), " paths of length {} from {} to {}\n", length, from, to);
+}
+
+void Digraph::setResultOutput(std::FILE* file, bool countsOnly)
+{
+	m_resultFile = file;
+	m_countsOnly = countsOnly;
+}
+
+void Digraph::appendWalkCount(fmt::memory_buffer& out, uint64_t count) const
+{
+	if (m_walkArithmetic.isModular())
+		fmt::format_to(std::back_inserter(out), "{} (mod {})", count, m_walkArithmetic.modulus);
+	else if (count == linear_algebra::COUNT_SATURATED)
+		fmt::format_to(std::back_inserter(out), "at least {}", count);
+	else
+		fmt::format_to(std::back_inserter(out), "{}", count);
+}
+
+// x_(t+1) = x_t * A, starting from the unit row of the source. Dense steps skip the zero entries
+// of x, so while it's still small they are as cheap as sparse ones. Past the vertex count k
+// products cost more than squaring, the row of the (cached) full power is used instead
+void Digraph::forEachWalkFrom(size_t source, uint64_t length, const std::function<void(size_t, uint64_t)>& visitor) const
+{
+	if (source >= m_verticesCount)
+		throw std::out_of_range("Vertex index out of range");
+
+	if (length > m_verticesCount || m_walkCache.find(length))
+	{
+		visitWalkRow(*walksOfLength(length), source, visitor);
+		return;
+	}
+
+	if (prefersSparse())
+	{
+		const SparseCountMatrix& adjacency = adjacencySparse();
+		SparseCountMatrix row(1, m_verticesCount, { 0, 1 }, { static_cast<uint32_t>(source) }, { 1 });
+		SparseCountMatrix next;
+
+		for (uint64_t step = 0; step < length && row.getNonZeroCount() != 0; step++)
+		{
+			linear_algebra::multiplyInto(row, adjacency, next, m_walkArithmetic);
+			std::swap(row, next);
+		}
+
+		// every stored entry stands for at least one walk, even when its count is 0 mod p
+		auto cols = row.rowColumns(0);
+		auto values = row.rowValues(0);
+		for (size_t ix = 0; ix < cols.size(); ix++)
+			visitor(cols[ix], values[ix]);
+
+		return;
+	}
+
+	// the counts of the adjacency matrix are the first rung of the squaring ladder
+	WalksPtr adjacency = ladderWalks(0);
+	const CountMatrix& adjacencyCounts = std::get<CountMatrix>(adjacency->counts);
+
+	CountMatrix row(1, m_verticesCount);
+	CountMatrix next;
+	row.set(0, source, 1);
+
+	// exact counts never drop to zero, residues can, so only those need the boolean walk
+	bool modular = m_walkArithmetic.isModular();
+	BitMatrix reach(1, m_verticesCount);
+	BitMatrix nextReach;
+	reach.set(0, source, true);
+
+	for (uint64_t step = 0; step < length && !reach.isZero(); step++)
+	{
+		linear_algebra::multiplyInto(row, adjacencyCounts, next, m_walkArithmetic);
+		swap(row, next);
+
+		if (modular)
+		{
+			linear_algebra::multiplyInto(reach, adjacencyBits(), nextReach);
+			swap(reach, nextReach);
+		}
+		else if (row.isZero())
+			reach = BitMatrix(1, m_verticesCount);
+	}
+
+	if (!modular)
+	{
+		row.forEachNonZeroInRow(0, visitor);
+		return;
+	}
+
+	const uint64_t* counts = row.rowData(0);
+	for (size_t j = 0; j < m_verticesCount; j++)
+	{
+		if (reach.get(0, j))
+			visitor(j, counts[j]);
+	}
+}
+
+std::optional<uint64_t> Digraph::countWalksBetween(size_t from, size_t to, uint64_t length) const
+{
+	std::optional<uint64_t> result;
+	forEachWalkFrom(from, length, [&](size_t j, uint64_t count)
+	{
+		if (j == to)
+			result = count;
+	});
+
+	return result;
+}
+
+void Digraph::visitWalkRow(const Walks& walks, size_t row, const std::function<void(size_t, uint64_t)>& visitor) const
+{
+	if (walks.reach)
+	{
+		if (const CountMatrix* dense = std::get_if<CountMatrix>(&walks.counts))
+		{
+			for (size_t j = 0; j < m_verticesCount; j++)
+			{
+				if (walks.reach->get(row, j))
+					visitor(j, dense->rowData(row)[j]);
+			}
+		}
+
+		return;
+	}
+
+	if (const SparseCountMatrix* sparse = std::get_if<SparseCountMatrix>(&walks.counts))
+	{
+		auto cols = sparse->rowColumns(row);
+		auto values = sparse->rowValues(row);
+		for (size_t ix = 0; ix < cols.size(); ix++)
+			visitor(cols[ix], values[ix]);
+
+		return;
+	}
+
+	const CountMatrix& dense = std::get<CountMatrix>(walks.counts);
+	if (!m_walkArithmetic.isModular())
+	{
+		dense.forEachNonZeroInRow(row, visitor);
+		return;
+	}
+
+	BitMatrix reach = linear_algebra::pow(adjacencyBits(), walks.length);
+	const uint64_t* counts = dense.rowData(row);
+	for (size_t j = 0; j < m_verticesCount; j++)
+	{
+		if (reach.get(row, j))
+			visitor(j, counts[j]);
+	}
+}
+
+void Digraph::forEachWalk(uint64_t length, const WalkVisitor& visitor) const
+{
+	visitWalks(*walksOfLength(length), visitor);
+}
+
+// A^length is the longest cached power below it times the rungs of the
+// squaring ladder (A, A^2, A^4, ...) that make up the difference
+Digraph::WalksPtr Digraph::walksOfLength(uint64_t length) const
+{
+	if (WalksPtr cached = m_walkCache.find(length))
+		return cached;
+
+	DIGRAPH_PROFILE_SCOPE("walk matrices");
+
+	WalksPtr result;
+	if (length == 0)
+	{
+		Walks walks;
+		if (prefersSparse())
+			walks.counts = SparseCountMatrix::Identity(m_verticesCount);
+		else
+		{
+			walks.reach = BitMatrix::Identity(m_verticesCount);
+			walks.counts = CountMatrix::Identity(m_verticesCount);
+		}
+
+		result = std::make_shared<const Walks>(std::move(walks));
+	}
+	else
+	{
+		uint64_t baseLength = 0;
+		result = m_walkCache.findBelow(length, baseLength);
+
+		// no walks of some length means no longer ones either
+		if (result && result->reach && result->reach->isZero())
+		{
+			Walks walks;
+			walks.length = length;
+			walks.reach = BitMatrix(m_verticesCount);
+			result = std::make_shared<const Walks>(std::move(walks));
+		}
+		else
+		{
+			// every rung is squared from the previous one, which stays here even when the
+			// cache doesn't keep it, so the ladder never gets climbed again from A
+			uint64_t remaining = length - baseLength;
+			WalksPtr step;
+			for (unsigned rung = 0; remaining != 0; rung++, remaining >>= 1)
+			{
+				step = ladderWalks(rung, step);
+				if (remaining & 1)
+					result = result ? std::make_shared<const Walks>(combineWalks(*result, *step)) : step;
+			}
+		}
+	}
+
+	cacheWalks(result);
+	return result;
+}
+
+// A^(2^rung), every rung is the square of the one below, which is climbed
+// to when the caller doesn't have it
+Digraph::WalksPtr Digraph::ladderWalks(unsigned rung, WalksPtr below) const
+{
+	if (WalksPtr cached = m_walkCache.find(1ull << rung))
+		return cached;
+
+	Walks walks;
+	walks.length = 1ull << rung;
+
+	if (rung == 0)
+	{
+		if (prefersSparse())
+			walks.counts = adjacencySparse();
+		else
+		{
+			walks.reach = adjacencyBits();
+			walks.counts = CountMatrix(adjacencyMatrix());
+		}
+	}
+	else if (rung == 1 && !prefersSparse())
+	{
+		// the adjacency matrix is stored as bytes, its square comes out widened to counts
+		// straight away so only the higher rungs are squared on 64-bit operands
+		const ByteMatrix& adjacency = adjacencyMatrix();
+		walks.reach = adjacencyBits() * adjacencyBits();
+		walks.counts = linear_algebra::pow(adjacency * adjacency, 1, m_walkArithmetic);
+	}
+	else
+	{
+		if (!below)
+			below = ladderWalks(rung - 1);
+
+		walks = combineWalks(*below, *below);
+	}
+
+	WalksPtr result = std::make_shared<const Walks>(std::move(walks));
+	cacheWalks(result);
+	return result;
+}
+
+Digraph::Walks Digraph::combineWalks(const Walks& lhs, const Walks& rhs) const
+{
+	Walks walks;
+	walks.length = lhs.length + rhs.length;
+
+	if (!lhs.reach)
+	{
+		walks.counts = multiplyWalks(lhs.counts, rhs.counts);
+		return walks;
+	}
+
+	walks.reach = BitMatrix();
+	linear_algebra::multiplyInto(*lhs.reach, *rhs.reach, *walks.reach);
+
+	if (walks.reach->isZero())
+		return walks;
+
+	CountMatrix counts;
+	linear_algebra::multiplyInto(std::get<CountMatrix>(lhs.counts), std::get<CountMatrix>(rhs.counts), counts, m_walkArithmetic);
+	walks.counts = std::move(counts);
+	return walks;
+}
+
+void Digraph::cacheWalks(const WalksPtr& walks) const
+{
+	size_t bytes = std::visit([](const auto& counts) { return counts.getByteSize(); }, walks->counts);
+	if (walks->reach)
+		bytes += walks->reach->getByteSize();
+
+	m_walkCache.insert(walks->length, walks, bytes);
+}
+
+// A walk of length L over the new edge is a walk of length i ending in from, the edge and a walk
+// of length L - 1 - i starting in to, so with c_i = A^i e_from and r_j = (e_to^T A^j)^T
+//   A'^L = A^L + sum over i < L of c_i r_(L-1-i)^T
+// and the L columns and rows make the update one n x L x n product instead of a new power.
+// Sparse walk matrices (whose pattern would change), lengths past the vertex count (where
+// the product costs more than squaring) and ones whose update takes more memory than the
+// cache budget are dropped instead
+void Digraph::updateWalksForEdge(graph::Vertex from, graph::Vertex to)
+{
+	size_t n = m_verticesCount;
+	std::vector<WalksPtr> updated;
+	uint64_t maxLength = 0;
+
+	// the columns and rows (counts and reach bytes) up to the length, the n x length
+	// factors of the product and the new walk matrix, all on top of the cached one
+	auto updateBytes = [n](uint64_t length)
+	{
+		size_t vectors = 2 * n * length * (sizeof(uint64_t) + 1);
+		size_t factors = 2 * n * (length * sizeof(uint64_t) + length / 8 + sizeof(uint64_t));
+		return vectors + factors + n * n * sizeof(uint64_t) + n * n / 8;
+	};
+
+	for (uint64_t length : m_walkCache.exponents())
+	{
+		if (length == 0)
+			continue;
+
+		WalksPtr walks = m_walkCache.find(length);
+		if (!walks->reach || length > n || updateBytes(length) > m_walkCache.getBudget())
+		{
+			m_walkCache.erase(length);
+			continue;
+		}
+
+		updated.push_back(walks);
+		maxLength = std::max(maxLength, length);
+	}
+
+	if (updated.empty())
+		return;
+
+	auto add = [&](uint64_t a, uint64_t b)
+	{
+		return m_walkArithmetic.isModular() ? (a + b) % m_walkArithmetic.modulus : linear_algebra::saturatingAdd(a, b);
+	};
+
+	// counts and (since modular counts can come out as 0) whether there are any walks at all
+	std::vector<std::vector<uint64_t>> columns(maxLength), rows(maxLength);
+	std::vector<std::vector<uint8_t>> columnReach(maxLength), rowReach(maxLength);
+
+	columns[0].assign(n, 0);
+	columnReach[0].assign(n, 0);
+	columns[0][from] = 1;
+	columnReach[0][from] = 1;
+
+	rows[0].assign(n, 0);
+	rowReach[0].assign(n, 0);
+	rows[0][to] = 1;
+	rowReach[0][to] = 1;
+
+	for (uint64_t i = 1; i < maxLength; i++)
+	{
+		columns[i].assign(n, 0);
+		columnReach[i].assign(n, 0);
+		rows[i].assign(n, 0);
+		rowReach[i].assign(n, 0);
+
+		for (graph::Vertex x = 0; x < n; x++)
+		{
+			for (graph::Vertex w : m_graph.successors(x))
+			{
+				// walks from x go through a successor, walks to w come from a predecessor
+				columns[i][x] = add(columns[i][x], columns[i - 1][w]);
+				columnReach[i][x] |= columnReach[i - 1][w];
+				rows[i][w] = add(rows[i][w], rows[i - 1][x]);
+				rowReach[i][w] |= rowReach[i - 1][x];
+			}
+		}
+	}
+
+	for (const WalksPtr& walks : updated)
+	{
+		uint64_t length = walks->length;
+
+		CountMatrix lhs(n, length), rhs(length, n);
+		BitMatrix lhsBits(n, length), rhsBits(length, n);
+
+		for (uint64_t i = 0; i < length; i++)
+		{
+			const std::vector<uint64_t>& column = columns[i];
+			const std::vector<uint64_t>& row = rows[length - 1 - i];
+
+			for (size_t x = 0; x < n; x++)
+			{
+				lhs.set(x, i, column[x]);
+				rhs.set(i, x, row[x]);
+
+				if (columnReach[i][x])
+					lhsBits.set(x, i, true);
+				if (rowReach[length - 1 - i][x])
+					rhsBits.set(i, x, true);
+			}
+		}
+
+		Walks result;
+		result.length = length;
+		result.reach = *walks->reach;
+		*result.reach |= lhsBits * rhsBits;
+
+		// walk matrices found empty come without counts
+		const CountMatrix* counts = std::get_if<CountMatrix>(&walks->counts);
+		CountMatrix sum = counts ? *counts : CountMatrix(n, n);
+		linear_algebra::multiplyAddInto(lhs, rhs, sum, m_walkArithmetic);
+		result.counts = std::move(sum);
+
+		cacheWalks(std::make_shared<const Walks>(std::move(result)));
+	}
+}
+
+void Digraph::setWalkCacheBudget(size_t bytes)
+{
+	m_walkCache.setBudget(bytes);
+}
+
+// the visitor's time (printing the walks and all) included
+void Digraph::visitWalks(const Walks& walks, const WalkVisitor& visitor) const
+{
+	DIGRAPH_PROFILE_SCOPE("visit walks");
+
+	auto report = [&](size_t i, size_t j, uint64_t count)
+	{
+		if (i != j)
+			visitor(i, j, count);
+	};
+
+	if (walks.reach)
+	{
+		if (const CountMatrix* dense = std::get_if<CountMatrix>(&walks.counts))
+			walks.reach->forEachSetBit([&](size_t i, size_t j) { report(i, j, dense->rowData(i)[j]); });
+
+		return;
+	}
+
+	// every stored entry stands for at least one walk, even when its count is 0 mod p
+	if (const SparseCountMatrix* sparse = std::get_if<SparseCountMatrix>(&walks.counts))
+	{
+		sparse->forEachNonZero(report);
+		return;
+	}
+
+	const CountMatrix& dense = std::get<CountMatrix>(walks.counts);
+	if (m_walkArithmetic.isModular())
+	{
+		// a zero residue doesn't tell whether there are any walks at all
+		BitMatrix reachMatrix = linear_algebra::pow(adjacencyBits(), walks.length);
+		reachMatrix.forEachSetBit([&](size_t i, size_t j) { report(i, j, dense.rowData(i)[j]); });
+	}
+	else
+		dense.forEachNonZero(report);
+}
+
+void Digraph::setWalkCountModulus(uint64_t modulus)
+{
+	linear_algebra::CountArithmetic arithmetic{ modulus };
+	linear_algebra::detail::validateArithmetic(arithmetic);
+	m_walkArithmetic = arithmetic;
+
+	// every cached power was counted the old way
+	m_walkCache.clear();
+}
+
+bool Digraph::isAcyclic() const
+{
+	if (m_order)
+		return true;
+
+	if (!m_cycle.empty())
+		return false;
+
+	return topologicalOrder().acyclic;
+}
+
+// the order (or the cycle) is found once, insertEdge and removeEdge keep it up to date
+graph::TopologicalOrder Digraph::topologicalOrder() const
+{
+	if (!m_order && m_cycle.empty())
+	{
+		graph::TopologicalOrder order = graph::topologicalSort(m_graph);
+		if (!order.acyclic)
+		{
+			m_cycle = order.cycle;
+			return order;
+		}
+
+		m_order.emplace(std::move(order.order));
+	}
+
+	if (m_order)
+		return { true, m_order->order(), {} };
+
+	return { false, {}, m_cycle };
+}
+
+bool Digraph::insertEdge(const std::string_view from, const std::string_view to)
+{
+	std::optional<graph::Vertex> fv = m_vertices.find(from);
+	std::optional<graph::Vertex> tv = m_vertices.find(to);
+
+	return fv && tv && insertEdge(*fv, *tv);
+}
+
+bool Digraph::removeEdge(const std::string_view from, const std::string_view to)
+{
+	std::optional<graph::Vertex> fv = m_vertices.find(from);
+	std::optional<graph::Vertex> tv = m_vertices.find(to);
+
+	return fv && tv && removeEdge(*fv, *tv);
+}
+
+bool Digraph::insertEdge(size_t from, size_t to)
+{
+	DIGRAPH_PROFILE_SCOPE("insert edge");
+
+	if (from >= m_verticesCount || to >= m_verticesCount)
+		throw std::out_of_range("Vertex index out of range");
+
+	graph::Vertex u = static_cast<graph::Vertex>(from);
+	graph::Vertex v = static_cast<graph::Vertex>(to);
+
+	if (m_graph.hasEdge(u, v))
+		return false;
+
+	// whether the edge closes a cycle (to reaches from already), while it doesn't no walk
+	// can use it twice. Answered from whatever is at hand before the graph changes
+	std::optional<bool> closesCycle;
+	if (u == v)
+		closesCycle = true;
+	else if (m_reach)
+		closesCycle = m_reach->reaches(v, u);
+	else if (m_order && m_order->position(u) < m_order->position(v))
+		closesCycle = false;
+	else if (m_components && m_components->component[u] == m_components->component[v])
+		closesCycle = true;
+	else if (m_components && m_components->component[u] > m_components->component[v])
+		closesCycle = false;
+
+	bool wasSparse = prefersSparse();
+	m_graph = m_graph.withEdge(u, v);
+
+	if (m_adjMatrix)
+		m_adjMatrix->set(u, v, 1);
+	if (m_adjBits)
+		m_adjBits->set(u, v, true);
+	m_adjSparse.reset();
+
+	if (m_order)
+	{
+		std::vector<graph::Vertex> cycle = m_order->insertEdge(m_graph, u, v);
+		closesCycle = !cycle.empty();
+
+		if (*closesCycle)
+		{
+			m_cycle = std::move(cycle);
+			m_order.reset();
+		}
+	}
+
+	if (m_reach)
+		m_reach = m_reach->withEdge(u, v);
+
+	// components only merge when an edge goes against their (sinks first) numbering
+	if (m_components)
+	{
+		uint32_t cu = m_components->component[u];
+		uint32_t cv = m_components->component[v];
+
+		if (cu == cv)
+			m_components->cyclic[cu] = true;
+		else if (cu < cv)
+			m_components.reset();
+	}
+
+	if (wasSparse != prefersSparse())
+		m_walkCache.clear();
+	else if (m_walkCache.getEntryCount() != 0)
+	{
+		// to reaches from in the new graph exactly when it did in the old one
+		if (!closesCycle)
+			closesCycle = searchReachable(v, u);
+
+		if (*closesCycle)
+			m_walkCache.clear();
+		else
+			updateWalksForEdge(u, v);
+	}
+
+	return true;
+}
+
+bool Digraph::removeEdge(size_t from, size_t to)
+{
+	DIGRAPH_PROFILE_SCOPE("remove edge");
+
+	if (from >= m_verticesCount || to >= m_verticesCount)
+		throw std::out_of_range("Vertex index out of range");
+
+	graph::Vertex u = static_cast<graph::Vertex>(from);
+	graph::Vertex v = static_cast<graph::Vertex>(to);
+
+	if (!m_graph.hasEdge(u, v))
+		return false;
+
+	m_graph = m_graph.withoutEdge(u, v);
+
+	if (m_adjMatrix)
+		m_adjMatrix->set(u, v, 0);
+	if (m_adjBits)
+		m_adjBits->set(u, v, false);
+	m_adjSparse.reset();
+
+	// an order stays valid, a cycle only while the edge wasn't one of its steps
+	for (size_t i = 0; i < m_cycle.size(); i++)
+	{
+		if (m_cycle[i] == u && m_cycle[(i + 1) % m_cycle.size()] == v)
+		{
+			m_cycle.clear();
+			break;
+		}
+	}
+
+	// only an edge inside a component can split it
+	if (m_components && m_components->component[u] == m_components->component[v])
+		m_components.reset();
+
+	// reachability and walk counts only shrink, which takes recounting
+	m_reach.reset();
+	m_walkCache.clear();
+	return true;
+}
+
+const graph::StronglyConnectedComponents& Digraph::components() const
+{
+	if (!m_components)
+		m_components = graph::stronglyConnectedComponents(m_graph);
+
+	return *m_components;
+}
+
+std::vector<graph::Vertex> Digraph::componentCycle(uint32_t component) const
+{
+	if (component >= components().getComponentCount())
+		throw std::out_of_range("Component index out of range");
+
+	return graph::componentCycle(m_graph, components(), component);
+}
+
+graph::CSRGraph Digraph::condensation() const
+{
+	return graph::condensation(m_graph, components());
+}
+
+const linear_algebra::ByteMatrix& Digraph::adjacencyMatrix() const
+{
+	if (!m_adjMatrix)
+	{
+		ByteMatrix mat(m_verticesCount);
+		for (graph::Vertex v = 0; v < m_verticesCount; v++)
+		{
+			for (graph::Vertex w : m_graph.successors(v))
+				mat.set(v, w, 1);
+		}
+
+		m_adjMatrix = std::move(mat);
+	}
+
+	return *m_adjMatrix;
+}
+
+const linear_algebra::BitMatrix& Digraph::adjacencyBits() const
+{
+	if (!m_adjBits)
+	{
+		BitMatrix mat(m_verticesCount);
+		for (graph::Vertex v = 0; v < m_verticesCount; v++)
+		{
+			for (graph::Vertex w : m_graph.successors(v))
+				mat.set(v, w, true);
+		}
+
+		m_adjBits = std::move(mat);
+	}
+
+	return *m_adjBits;
+}
+
+const linear_algebra::SparseCountMatrix& Digraph::adjacencySparse() const
+{
+	if (!m_adjSparse)
+	{
+		std::vector<uint64_t> offsets(m_verticesCount + 1, 0);
+		std::vector<uint32_t> cols;
+		cols.reserve(m_graph.getEdgeCount());
+
+		for (graph::Vertex v = 0; v < m_verticesCount; v++)
+		{
+			auto successors = m_graph.successors(v);
+			cols.insert(cols.end(), successors.begin(), successors.end());
+			offsets[v + 1] = cols.size();
+		}
+
+		std::vector<uint64_t> values(cols.size(), 1);
+		m_adjSparse.emplace(m_verticesCount, m_verticesCount, std::move(offsets), std::move(cols), std::move(values));
+	}
+
+	return *m_adjSparse;
+}
+
+bool Digraph::prefersSparse() const
+{
+	if (!fitsDense(m_verticesCount))
+		return true;
+
+	double density = static_cast<double>(m_graph.getEdgeCount()) / (static_cast<double>(m_verticesCount) * m_verticesCount);
+	return density <= SPARSE_DENSITY_LIMIT;
+}
+
+// sparse products turn dense once they get too full (and a dense matrix fits in memory)
+Digraph::WalkMatrix Digraph::multiplyWalks(const WalkMatrix& lhs, const WalkMatrix& rhs) const
+{
+	const SparseCountMatrix* sparseLhs = std::get_if<SparseCountMatrix>(&lhs);
+	const SparseCountMatrix* sparseRhs = std::get_if<SparseCountMatrix>(&rhs);
+
+	if (sparseLhs && sparseRhs)
+	{
+		SparseCountMatrix product;
+		linear_algebra::multiplyInto(*sparseLhs, *sparseRhs, product, m_walkArithmetic);
+		if (fitsDense(m_verticesCount) && product.density() > SPARSE_DENSITY_LIMIT)
+			return product.toDense();
+
+		return product;
+	}
+
+	CountMatrix denseLhs = sparseLhs ? sparseLhs->toDense() : std::get<CountMatrix>(lhs);
+	CountMatrix denseRhs = sparseRhs ? sparseRhs->toDense() : std::get<CountMatrix>(rhs);
+	CountMatrix product;
+	linear_algebra::multiplyInto(denseLhs, denseRhs, product, m_walkArithmetic);
+	return product;
+}
+
+Digraph Digraph::fromFile(const std::string_view filepath, graph::GraphFormat format)
+{
+	DIGRAPH_PROFILE_SCOPE("load graph");
+
+	const std::string path(filepath);
+
+	if (format == graph::GraphFormat::Auto)
+		format = graph::detectGraphFormat(path);
+
+	if (format == graph::GraphFormat::Binary)
+	{
+		graph::BinaryGraph binary = graph::loadBinaryGraph(path);
+
+		Digraph digraph(binary.graph.getVertexCount());
+		digraph.m_graph = std::move(binary.graph);
+		digraph.m_vertices = std::move(binary.vertices);
+		return digraph;
+	}
+
+	graph::GraphDescription description;
+
+	if (format == graph::GraphFormat::Json)
+	{
+		std::ifstream file(path, std::ios::binary);
+		description = graph::loadJson(file);
+	}
+	else
+	{
+		// text formats are tokenized in place, straight from the mapping
+		std::shared_ptr<const graph::MappedFile> file = graph::MappedFile::Open(path);
+		std::string_view text(reinterpret_cast<const char*>(file->bytes().data()), file->bytes().size());
+
+		switch (format)
+		{
+		case graph::GraphFormat::Csv:
+			description = graph::loadEdgeList(text, ',');
+			break;
+		case graph::GraphFormat::Tsv:
+			description = graph::loadEdgeList(text, '\t');
+			break;
+		case graph::GraphFormat::MatrixMarket:
+			description = graph::loadMatrixMarket(text);
+			break;
+		default:
+			description = graph::loadEdgeList(text, 0);
+			break;
+		}
+	}
+
+	Digraph digraph(description.vertices.size());
+	digraph.m_graph = graph::CSRGraph::FromEdges(description.vertices.size(), description.edges);
+
+	// vertex table serves for quick matrix col/row index finding,
+	// so we don't need to do searches around the array of vertices
+	digraph.m_vertices = graph::VertexTable::Build(description.vertices);
+	return digraph;
+}
+
+void Digraph::saveBinary(const std::string_view filepath) const
+{
+	graph::saveBinaryGraph(std::string(filepath), m_vertices, m_graph);
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "CountMatrix.h"
+#include "BitMatrix.h"
+#include "SparseMatrix.h"
+#include "CSRGraph.h"
+#include "PowerCache.h"
+#include "GraphLoader.h"
+#include "GraphFile.h"
+#include "Reachability.h"
+#include "Components.h"
+#include "OnlineOrder.h"
+#include "MappedFile.h"
+
+class Digraph
+{
+	using CountMatrix = linear_algebra::CountMatrix;
+	using ByteMatrix = linear_algebra::ByteMatrix;
+	using BitMatrix = linear_algebra::BitMatrix;
+	using SparseCountMatrix = linear_algebra::SparseCountMatrix;
+	using WalkMatrix = std::variant<SparseCountMatrix, CountMatrix>;
+public:
+	// called with (from, to, count) for walks between two distinct vertices
+	using WalkVisitor = std::function<void(size_t, size_t, uint64_t)>;
+
+	Digraph()
+		: m_verticesCount(0)
+	{ }
+
+	Digraph(size_t verticesCount)
+		: m_verticesCount(verticesCount)
+	{}
+
+	bool isLeadingTo(const std::string_view from, const std::string_view to) const;
+
+	// whether a walk of at least one step leads from one vertex to the other (false for unknown
+	// vertices). A bit of the transitive closure, built on first use, unless the closure doesn't
+	// fit in memory, then every query takes a breadth first search
+	bool canReach(const std::string_view from, const std::string_view to) const;
+	bool canReach(size_t from, size_t to) const;
+
+	// reads the closure from this file when it was saved for this very graph, otherwise builds it
+	// and saves it there, so later runs skip building it. Returns whether it was read. Throws
+	// std::runtime_error, without touching the file, when it exists but isn't a reachability index
+	bool useReachabilityFile(const std::string_view filepath);
+	void findAllPathsWithLength(uint64_t length) const;
+	void findPathsFrom(const std::string_view from, uint64_t length) const;
+	void findPathsBetween(const std::string_view from, const std::string_view to, uint64_t length) const;
+
+	// the find* results go to this file (stdout by default), which stays owned by the caller.
+	// With countsOnly they only print how many pairs of vertices the walks connect (whether they
+	// connect the two vertices, for findPathsBetween)
+	void setResultOutput(std::FILE* file, bool countsOnly = false);
+
+	// visits every pair of distinct vertices joined by at least one walk of the given length
+	void forEachWalk(uint64_t length, const WalkVisitor& visitor) const;
+
+	// walks of the given length from one vertex: visitor(to, count) for every vertex they end in,
+	// source included. Takes length vector-matrix products (SpMV for sparse graphs) instead of
+	// a full power of the adjacency matrix, unless the length is over the vertex count
+	void forEachWalkFrom(size_t source, uint64_t length, const std::function<void(size_t, uint64_t)>& visitor) const;
+
+	// nothing when no walk of the length leads from one vertex to the other
+	std::optional<uint64_t> countWalksBetween(size_t from, size_t to, uint64_t length) const;
+
+	// adds or removes one edge, false when there was nothing to change (or no such vertex).
+	// The adjacency matrices, acyclicity, the reachability index, the components and the cached
+	// walk counts are updated in place where that's cheaper than rebuilding them, the rest is
+	// dropped and rebuilt on next use. The graph itself gets copied with the edge added or removed,
+	// O(V + E), which still costs a lot less than loading it again
+	bool insertEdge(const std::string_view from, const std::string_view to);
+	bool insertEdge(size_t from, size_t to);
+	bool removeEdge(const std::string_view from, const std::string_view to);
+	bool removeEdge(size_t from, size_t to);
+
+	// walk matrices stay cached (least recently used ones dropped past this many bytes),
+	// so a length close to an earlier one costs a multiplication or two
+	void setWalkCacheBudget(size_t bytes);
+	size_t getWalkCacheBudget() const { return m_walkCache.getBudget(); }
+
+	// walk counts are exact (saturating past 2^64 - 1) by default,
+	// a non-zero modulus makes them get counted modulo it instead
+	void setWalkCountModulus(uint64_t modulus);
+	uint64_t getWalkCountModulus() const { return m_walkArithmetic.modulus; }
+
+	bool isAcyclic() const;
+
+	// a topological order of the vertices, or one cycle when there is none
+	graph::TopologicalOrder topologicalOrder() const;
+
+	// strongly connected components, found once in linear time and kept
+	const graph::StronglyConnectedComponents& components() const;
+
+	// one cycle through a component with cycles, empty for any other
+	std::vector<graph::Vertex> componentCycle(uint32_t component) const;
+
+	// the DAG of the components
+	graph::CSRGraph condensation() const;
+
+	size_t getVertexCount() const { return m_verticesCount; }
+	size_t getEdgeCount() const { return m_graph.getEdgeCount(); }
+	std::string_view getVertexName(size_t ix) const { return m_vertices.name(static_cast<graph::Vertex>(ix)); }
+	std::optional<size_t> findVertex(std::string_view name) const { return m_vertices.find(name); }
+
+	// reads the JSON description, the binary format saveBinary writes or
+	// any other format of GraphLoader.h, Auto picks it from the file itself
+	static Digraph fromFile(const std::string_view filepath, graph::GraphFormat format = graph::GraphFormat::Auto);
+
+	// the binary format loads by mapping the file, with no parsing at all
+	void saveBinary(const std::string_view filepath) const;
+
+private:
+	// dense forms of m_graph are built on first use, so queries that never
+	// need them work on graphs far too big for an n x n matrix
+	const ByteMatrix& adjacencyMatrix() const;
+	const BitMatrix& adjacencyBits() const;
+	const SparseCountMatrix& adjacencySparse() const;
+
+	// nullptr when the closure is too big to be kept
+	const graph::ReachabilityIndex* reachability() const;
+
+	// breadth first search, for when there's no closure
+	bool searchReachable(size_t from, size_t to) const;
+
+	// sparse graphs (or ones too big for a dense matrix) count walks with SpGEMM
+	bool prefersSparse() const;
+	WalkMatrix multiplyWalks(const WalkMatrix& lhs, const WalkMatrix& rhs) const;
+
+	// counts of the walks of one length. Dense ones come with the boolean power, which tells
+	// the connected pairs apart (and skips the counting altogether when there are none)
+	struct Walks
+	{
+		uint64_t length = 0;
+		WalkMatrix counts;
+		std::optional<BitMatrix> reach;
+	};
+
+	using WalksPtr = std::shared_ptr<const Walks>;
+
+	WalksPtr walksOfLength(uint64_t length) const;
+	WalksPtr ladderWalks(unsigned rung, WalksPtr below = nullptr) const;
+	Walks combineWalks(const Walks& lhs, const Walks& rhs) const;
+	void cacheWalks(const WalksPtr& walks) const;
+	void visitWalks(const Walks& walks, const WalkVisitor& visitor) const;
+	void visitWalkRow(const Walks& walks, size_t row, const std::function<void(size_t, uint64_t)>& visitor) const;
+
+	// adds the walks over a new edge, which none of them can use twice, to the cached walk matrices
+	void updateWalksForEdge(graph::Vertex from, graph::Vertex to);
+
+	// "7", "at least 18446744073709551615" or "3 (mod 5)"
+	void appendWalkCount(fmt::memory_buffer& out, uint64_t count) const;
+
+private:
+	size_t m_verticesCount;
+	graph::CSRGraph m_graph;
+	mutable std::optional<ByteMatrix> m_adjMatrix;
+	mutable std::optional<BitMatrix> m_adjBits;
+	mutable std::optional<SparseCountMatrix> m_adjSparse;
+	mutable std::optional<graph::ReachabilityIndex> m_reach;
+	mutable std::optional<graph::StronglyConnectedComponents> m_components;
+
+	// an order while the graph is acyclic, otherwise one of its cycles
+	mutable std::optional<graph::OnlineTopologicalOrder> m_order;
+	mutable std::vector<graph::Vertex> m_cycle;
+	linear_algebra::CountArithmetic m_walkArithmetic;
+	mutable linear_algebra::PowerCache<Walks> m_walkCache;
+	graph::VertexTable m_vertices;
+	std::FILE* m_resultFile = stdout;
+	bool m_countsOnly = false;
+};
\ No newline at end of file
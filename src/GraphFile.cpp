@@ -0,0 +1,214 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "GraphFile.h"
+#include "MappedFile.h"
+
+using namespace graph;
+
+static uint64_t alignSection(uint64_t position)
+{
+	return (position + BINARY_SECTION_ALIGNMENT - 1) / BINARY_SECTION_ALIGNMENT * BINARY_SECTION_ALIGNMENT;
+}
+
+// whether count elements of T starting at position fit into the file
+template<typename T>
+static bool sectionFits(uint64_t position, uint64_t count, uint64_t fileSize)
+{
+	if (position % alignof(T) != 0 || position > fileSize)
+		return false;
+
+	return count <= (fileSize - position) / sizeof(T);
+}
+
+template<typename T>
+static std::span<const T> section(std::span<const std::byte> bytes, uint64_t position, uint64_t count)
+{
+	return { reinterpret_cast<const T*>(bytes.data() + position), static_cast<size_t>(count) };
+}
+
+bool graph::isBinaryGraphFile(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	char magic[sizeof(BINARY_GRAPH_MAGIC)];
+	if (!file.read(magic, sizeof(magic)))
+		return false;
+
+	return std::memcmp(magic, BINARY_GRAPH_MAGIC, sizeof(magic)) == 0;
+}
+
+void graph::saveBinaryGraph(const std::string& path, const VertexTable& vertices, const CSRGraph& graph)
+{
+	if (vertices.size() != graph.getVertexCount())
+		throw std::invalid_argument("Invalid argument: Every vertex needs a name");
+
+	BinaryGraphHeader header = {};
+	std::memcpy(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic));
+	header.version = BINARY_GRAPH_VERSION;
+	header.byteOrder = BINARY_GRAPH_BYTE_ORDER;
+	header.vertexCount = graph.getVertexCount();
+	header.edgeCount = graph.getEdgeCount();
+	header.nameBytes = vertices.chars().size();
+	header.slotCount = vertices.slots().size();
+
+	header.offsetsAt = alignSection(sizeof(BinaryGraphHeader));
+	header.targetsAt = alignSection(header.offsetsAt + graph.offsets().size_bytes());
+	header.nameOffsetsAt = alignSection(header.targetsAt + graph.targets().size_bytes());
+	header.slotsAt = alignSection(header.nameOffsetsAt + vertices.offsets().size_bytes());
+	header.namesAt = alignSection(header.slotsAt + vertices.slots().size_bytes());
+	header.fileSize = header.namesAt + vertices.chars().size_bytes();
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Couldn't create " + path);
+
+	uint64_t written = 0;
+	auto writeSection = [&](uint64_t position, const void* data, size_t bytes)
+	{
+		static const char padding[BINARY_SECTION_ALIGNMENT] = {};
+		file.write(padding, static_cast<std::streamsize>(position - written));
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+		written = position + bytes;
+	};
+
+	writeSection(0, &header, sizeof(header));
+	writeSection(header.offsetsAt, graph.offsets().data(), graph.offsets().size_bytes());
+	writeSection(header.targetsAt, graph.targets().data(), graph.targets().size_bytes());
+	writeSection(header.nameOffsetsAt, vertices.offsets().data(), vertices.offsets().size_bytes());
+	writeSection(header.slotsAt, vertices.slots().data(), vertices.slots().size_bytes());
+	writeSection(header.namesAt, vertices.chars().data(), vertices.chars().size_bytes());
+
+	if (!file.flush())
+		throw std::runtime_error("Couldn't write " + path);
+}
+
+BinaryGraph graph::loadBinaryGraph(const std::string& path)
+{
+	std::shared_ptr<const MappedFile> file = MappedFile::Open(path);
+	std::span<const std::byte> bytes = file->bytes();
+
+	BinaryGraphHeader header;
+	if (bytes.size() < sizeof(header))
+		throw std::runtime_error("File is not a binary graph");
+
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic)) != 0)
+		throw std::runtime_error("File is not a binary graph");
+
+	if (header.version != BINARY_GRAPH_VERSION || header.byteOrder != BINARY_GRAPH_BYTE_ORDER)
+		throw std::runtime_error("Binary graph was written by an incompatible version or machine");
+
+	uint64_t size = bytes.size();
+	bool fits = header.fileSize == size
+		&& header.vertexCount < size
+		&& sectionFits<uint64_t>(header.offsetsAt, header.vertexCount + 1, size)
+		&& sectionFits<Vertex>(header.targetsAt, header.edgeCount, size)
+		&& sectionFits<uint64_t>(header.nameOffsetsAt, header.vertexCount + 1, size)
+		&& sectionFits<Vertex>(header.slotsAt, header.slotCount, size)
+		&& sectionFits<char>(header.namesAt, header.nameBytes, size);
+
+	if (!fits)
+		throw std::runtime_error("Binary graph is truncated or damaged");
+
+	try
+	{
+		BinaryGraph result;
+		result.graph = CSRGraph::FromArrays(section<uint64_t>(bytes, header.offsetsAt, header.vertexCount + 1),
+			section<Vertex>(bytes, header.targetsAt, header.edgeCount), file);
+		result.vertices = VertexTable::FromArrays(section<char>(bytes, header.namesAt, header.nameBytes),
+			section<uint64_t>(bytes, header.nameOffsetsAt, header.vertexCount + 1),
+			section<Vertex>(bytes, header.slotsAt, header.slotCount), file);
+		return result;
+	}
+	catch (const std::invalid_argument&)
+	{
+		throw std::runtime_error("Binary graph is truncated or damaged");
+	}
+}
+
+bool graph::isReachabilityFile(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	char magic[sizeof(REACHABILITY_MAGIC)];
+	if (!file.read(magic, sizeof(magic)))
+		return false;
+
+	return std::memcmp(magic, REACHABILITY_MAGIC, sizeof(magic)) == 0;
+}
+
+void graph::saveReachability(const std::string& path, const ReachabilityIndex& index, const CSRGraph& graph)
+{
+	if (index.getVertexCount() != graph.getVertexCount())
+		throw std::invalid_argument("Invalid argument: Index was built for another graph");
+
+	ReachabilityHeader header = {};
+	std::memcpy(header.magic, REACHABILITY_MAGIC, sizeof(header.magic));
+	header.version = REACHABILITY_VERSION;
+	header.byteOrder = BINARY_GRAPH_BYTE_ORDER;
+	header.vertexCount = index.getVertexCount();
+	header.graphFingerprint = graph.fingerprint();
+	header.bitsAt = alignSection(sizeof(ReachabilityHeader));
+	header.fileSize = header.bitsAt + index.bits().size_bytes();
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Couldn't create " + path);
+
+	static const char padding[BINARY_SECTION_ALIGNMENT] = {};
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(padding, static_cast<std::streamsize>(header.bitsAt - sizeof(header)));
+	file.write(reinterpret_cast<const char*>(index.bits().data()), static_cast<std::streamsize>(index.bits().size_bytes()));
+
+	if (!file.flush())
+		throw std::runtime_error("Couldn't write " + path);
+}
+
+std::optional<ReachabilityIndex> graph::loadReachability(const std::string& path, const CSRGraph& graph)
+{
+	std::shared_ptr<const MappedFile> file = MappedFile::Open(path);
+	std::span<const std::byte> bytes = file->bytes();
+
+	ReachabilityHeader header;
+	if (bytes.size() < sizeof(header))
+		throw std::runtime_error("File is not a reachability index");
+
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, REACHABILITY_MAGIC, sizeof(header.magic)) != 0)
+		throw std::runtime_error("File is not a reachability index");
+
+	if (header.version != REACHABILITY_VERSION || header.byteOrder != BINARY_GRAPH_BYTE_ORDER)
+		return std::nullopt;
+
+	if (header.vertexCount != graph.getVertexCount() || header.graphFingerprint != graph.fingerprint())
+		return std::nullopt;
+
+	uint64_t size = bytes.size();
+	uint64_t words = header.vertexCount * ReachabilityIndex::WordsPerRow(header.vertexCount);
+	if (header.fileSize != size || !sectionFits<uint64_t>(header.bitsAt, words, size))
+		throw std::runtime_error("Reachability index is truncated or damaged");
+
+	return ReachabilityIndex::FromArrays(header.vertexCount, section<uint64_t>(bytes, header.bitsAt, words), file);
+}
\ No newline at end of file
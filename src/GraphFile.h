@@ -0,0 +1,99 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "CSRGraph.h"
+#include "VertexTable.h"
+#include "Reachability.h"
+
+namespace graph
+{
+	// Binary graph file: a BinaryGraphHeader followed by the arrays of a CSRGraph and
+	// a VertexTable, each of them starting on a BINARY_SECTION_ALIGNMENT boundary and
+	// stored in the byte order of the machine that wrote it
+	inline constexpr char BINARY_GRAPH_MAGIC[8] = { 'D', 'I', 'G', 'R', 'A', 'P', 'H', 0 };
+	inline constexpr uint32_t BINARY_GRAPH_VERSION = 1;
+	inline constexpr uint32_t BINARY_GRAPH_BYTE_ORDER = 0x01020304;
+	inline constexpr size_t BINARY_SECTION_ALIGNMENT = 64;
+
+	struct BinaryGraphHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t byteOrder;
+		uint64_t vertexCount;
+		uint64_t edgeCount;
+		uint64_t nameBytes;
+		uint64_t slotCount;
+
+		// section positions, in bytes from the start of the file
+		uint64_t offsetsAt;
+		uint64_t targetsAt;
+		uint64_t nameOffsetsAt;
+		uint64_t namesAt;
+		uint64_t slotsAt;
+		uint64_t fileSize;
+	};
+
+	// Reachability file: a ReachabilityHeader followed by the rows of a ReachabilityIndex,
+	// tied to the graph it was built from by the fingerprint of that graph
+	inline constexpr char REACHABILITY_MAGIC[8] = { 'D', 'I', 'G', 'R', 'E', 'A', 'C', 'H' };
+	inline constexpr uint32_t REACHABILITY_VERSION = 1;
+
+	struct ReachabilityHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t byteOrder;
+		uint64_t vertexCount;
+		uint64_t graphFingerprint;
+		uint64_t bitsAt;
+		uint64_t fileSize;
+	};
+
+	struct BinaryGraph
+	{
+		VertexTable vertices;
+		CSRGraph graph;
+	};
+
+	// true when the file starts with BINARY_GRAPH_MAGIC
+	bool isBinaryGraphFile(const std::string& path);
+
+	void saveBinaryGraph(const std::string& path, const VertexTable& vertices, const CSRGraph& graph);
+
+	// maps the file and points the returned graph straight into the mapping, nothing gets parsed
+	// or copied. One pass over the offsets and targets checks that they describe a valid graph,
+	// which pages the whole file in. Throws std::runtime_error when the file isn't one this build
+	// can read, or it's truncated or damaged
+	BinaryGraph loadBinaryGraph(const std::string& path);
+
+	// true when the file starts with REACHABILITY_MAGIC
+	bool isReachabilityFile(const std::string& path);
+
+	void saveReachability(const std::string& path, const ReachabilityIndex& index, const CSRGraph& graph);
+
+	// maps the file like loadBinaryGraph. Nothing when it was saved for another graph (or another
+	// version of this one), std::runtime_error when it can't be read or isn't a reachability file
+	std::optional<ReachabilityIndex> loadReachability(const std::string& path, const CSRGraph& graph);
+}
\ No newline at end of file
@@ -0,0 +1,364 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "GraphLoader.h"
+#include "GraphFile.h"
+#include "Profiler.h"
+
+using namespace graph;
+
+using json = nlohmann::json;
+
+static const GraphFormat NAMED_FORMATS[] = { GraphFormat::Auto, GraphFormat::Json, GraphFormat::Binary,
+	GraphFormat::EdgeList, GraphFormat::Csv, GraphFormat::Tsv, GraphFormat::MatrixMarket };
+
+const char* graph::graphFormatName(GraphFormat format)
+{
+	switch (format)
+	{
+	case GraphFormat::Json: return "json";
+	case GraphFormat::Binary: return "binary";
+	case GraphFormat::EdgeList: return "edges";
+	case GraphFormat::Csv: return "csv";
+	case GraphFormat::Tsv: return "tsv";
+	case GraphFormat::MatrixMarket: return "mtx";
+	default: return "auto";
+	}
+}
+
+bool graph::parseGraphFormat(const char* name, GraphFormat& format)
+{
+	for (GraphFormat candidate : NAMED_FORMATS)
+	{
+		if (std::strcmp(name, graphFormatName(candidate)) == 0)
+		{
+			format = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+GraphFormat graph::detectGraphFormat(const std::string& path)
+{
+	if (isBinaryGraphFile(path))
+		return GraphFormat::Binary;
+
+	std::string extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	if (extension == ".mtx")
+		return GraphFormat::MatrixMarket;
+	if (extension == ".csv")
+		return GraphFormat::Csv;
+	if (extension == ".tsv")
+		return GraphFormat::Tsv;
+	if (extension == ".txt" || extension == ".edges" || extension == ".el")
+		return GraphFormat::EdgeList;
+
+	return GraphFormat::Json;
+}
+
+namespace
+{
+	// Walks the SAX events with a small state machine instead of a document tree.
+	// Values the schema doesn't know about are skipped, however deeply nested
+	class JsonGraphHandler : public nlohmann::json_sax<json>
+	{
+		enum class State
+		{
+			Document,	// before the top level value
+			Root,		// inside the top level object, between its properties
+			Vertices,	// inside the "vertices" array
+			Edges,		// inside the "edges" array
+			Edge,		// inside one edge object
+			Skip,		// inside an unknown array or object
+			Done
+		};
+
+		enum class Property { Unknown, Vertices, Edges, From, To };
+
+	public:
+		explicit JsonGraphHandler(GraphDescription& description)
+			: m_description(description)
+		{ }
+
+		bool null() override { return scalar(); }
+		bool boolean(bool) override { return scalar(); }
+		bool number_integer(number_integer_t) override { return scalar(); }
+		bool number_unsigned(number_unsigned_t) override { return scalar(); }
+		bool number_float(number_float_t, const string_t&) override { return scalar(); }
+		bool binary(binary_t&) override { return scalar(); }
+
+		bool string(string_t& val) override
+		{
+			switch (m_state)
+			{
+			case State::Vertices:
+				addVertex(std::move(val));
+				return true;
+			case State::Edge:
+				if (m_property == Property::From)
+					m_from = std::move(val);
+				else if (m_property == Property::To)
+					m_to = std::move(val);
+				return true;
+			default:
+				return scalar();
+			}
+		}
+
+		bool start_object(std::size_t) override
+		{
+			switch (m_state)
+			{
+			case State::Document:
+				m_state = State::Root;
+				return true;
+			case State::Edges:
+				m_state = State::Edge;
+				m_from.reset();
+				m_to.reset();
+				return true;
+			default:
+				return container();
+			}
+		}
+
+		bool end_object() override
+		{
+			switch (m_state)
+			{
+			case State::Root:
+				m_state = State::Done;
+				finish();
+				return true;
+			case State::Edge:
+				m_state = State::Edges;
+				addEdge();
+				return true;
+			default:
+				return leave();
+			}
+		}
+
+		bool start_array(std::size_t) override
+		{
+			if (m_state == State::Root && m_property == Property::Vertices)
+			{
+				m_state = State::Vertices;
+				m_verticesSeen = true;
+				return true;
+			}
+
+			if (m_state == State::Root && m_property == Property::Edges)
+			{
+				m_state = State::Edges;
+				m_edgesSeen = true;
+				return true;
+			}
+
+			return container();
+		}
+
+		bool end_array() override
+		{
+			switch (m_state)
+			{
+			case State::Vertices:
+				m_state = State::Root;
+				resolvePending();
+				return true;
+			case State::Edges:
+				m_state = State::Root;
+				return true;
+			default:
+				return leave();
+			}
+		}
+
+		bool key(string_t& val) override
+		{
+			if (m_state == State::Root)
+			{
+				if (val == "vertices")
+					m_property = Property::Vertices;
+				else if (val == "edges")
+					m_property = Property::Edges;
+				else
+					m_property = Property::Unknown;
+			}
+			else if (m_state == State::Edge)
+			{
+				if (val == "from")
+					m_property = Property::From;
+				else if (val == "to")
+					m_property = Property::To;
+				else
+					m_property = Property::Unknown;
+			}
+
+			return true;
+		}
+
+		bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override
+		{
+			throw std::runtime_error("File is not a valid json");
+		}
+
+	private:
+		// a number, bool or null (or a string where no name is expected)
+		bool scalar()
+		{
+			switch (m_state)
+			{
+			case State::Document:
+				throw std::runtime_error("Vertices or edges properties are missing");
+			case State::Root:
+				if (m_property == Property::Vertices || m_property == Property::Edges)
+					throw std::runtime_error("Vertices or edges should be defined as arrays of properties");
+				return true;
+			case State::Vertices:
+				throw std::runtime_error("Vertices should be defined as an array of names");
+			case State::Edges:
+				throw std::runtime_error("Missing \"from\" or \"to\" property in edge");
+			case State::Edge:
+				if (m_property == Property::From || m_property == Property::To)
+					throw std::runtime_error("Edge endpoints should be vertex names");
+				return true;
+			default:
+				return true;
+			}
+		}
+
+		// an array or object that isn't part of the schema
+		bool container()
+		{
+			if (m_state == State::Skip)
+			{
+				m_skipDepth++;
+				return true;
+			}
+
+			// an array or object where a scalar was expected fails the same way a scalar would
+			if (m_state != State::Root && m_state != State::Edge)
+				return scalar();
+			if (m_property != Property::Unknown)
+				return scalar();
+
+			m_skipReturn = m_state;
+			m_state = State::Skip;
+			m_skipDepth = 1;
+			return true;
+		}
+
+		bool leave()
+		{
+			if (m_state == State::Skip && --m_skipDepth == 0)
+				m_state = m_skipReturn;
+
+			return true;
+		}
+
+		void addVertex(std::string&& name)
+		{
+			size_t ix = m_description.vertices.size();
+			if (ix > std::numeric_limits<Vertex>::max())
+				throw std::runtime_error("A graph described in file has too many vertices");
+
+			if (!m_lookupTable.try_emplace(name, ix).second)
+				throw std::runtime_error("Vertex \"" + name + "\" is defined more than once");
+
+			m_description.vertices.push_back(std::move(name));
+		}
+
+		Vertex resolve(const std::string& name) const
+		{
+			auto it = m_lookupTable.find(name);
+			if (it == m_lookupTable.end())
+				throw std::runtime_error("Nonexistent vertex specified in an edge description");
+
+			return static_cast<Vertex>(it->second);
+		}
+
+		void addEdge()
+		{
+			if (!m_from || !m_to)
+				throw std::runtime_error("Missing \"from\" or \"to\" property in edge");
+
+			// names are only known once the whole "vertices" array has been read
+			if (!m_verticesPending)
+				m_description.edges.push_back({ resolve(*m_from), resolve(*m_to) });
+			else
+				m_pending.emplace_back(std::move(*m_from), std::move(*m_to));
+		}
+
+		void resolvePending()
+		{
+			m_verticesPending = false;
+			for (const auto& [from, to] : m_pending)
+				m_description.edges.push_back({ resolve(from), resolve(to) });
+
+			m_pending.clear();
+			m_pending.shrink_to_fit();
+		}
+
+		void finish()
+		{
+			if (!m_verticesSeen || !m_edgesSeen)
+				throw std::runtime_error("Vertices or edges properties are missing");
+
+			if (m_description.vertices.empty() || (m_description.edges.empty() && m_pending.empty()))
+				throw std::runtime_error("A graph described in file should have at least 2 vertices and 1 edge");
+
+			resolvePending();
+		}
+
+	private:
+		GraphDescription& m_description;
+		std::unordered_map<std::string, size_t> m_lookupTable;
+		State m_state = State::Document;
+		State m_skipReturn = State::Root;
+		size_t m_skipDepth = 0;
+		Property m_property = Property::Unknown;
+		bool m_verticesSeen = false;
+		bool m_verticesPending = true;
+		bool m_edgesSeen = false;
+		std::optional<std::string> m_from, m_to;
+		std::vector<std::pair<std::string, std::string>> m_pending;
+	};
+}
+
+GraphDescription graph::loadJson(std::istream& input)
+{
+	DIGRAPH_PROFILE_SCOPE("parse json");
+
+	GraphDescription description;
+	JsonGraphHandler handler(description);
+
+	if (!input)
+		throw std::runtime_error("File is not a valid json");
+
+	json::sax_parse(input, &handler);
+	return description;
+}
\ No newline at end of file
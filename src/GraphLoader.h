@@ -0,0 +1,74 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "CSRGraph.h"
+
+namespace graph
+{
+	// A graph as read from a description file, vertex i is named vertices[i]
+	struct GraphDescription
+	{
+		std::vector<std::string> vertices;
+		std::vector<Edge> edges;
+	};
+
+	enum class GraphFormat
+	{
+		Auto,
+		Json,
+		Binary,			// see GraphFile.h
+		EdgeList,		// whitespace separated
+		Csv,
+		Tsv,
+		MatrixMarket	// coordinate .mtx
+	};
+
+	const char* graphFormatName(GraphFormat format);
+	bool parseGraphFormat(const char* name, GraphFormat& format);
+
+	// binary files are recognised by their magic number, everything else by the extension
+	// (.mtx, .csv, .tsv, .txt/.edges/.el). Anything unknown is read as JSON
+	GraphFormat detectGraphFormat(const std::string& path);
+
+	// Streams the JSON schema ({ "vertices": [names], "edges": [{ "from": name, "to": name }] })
+	// through a SAX parser, so no document tree is ever built. Edge endpoints are resolved
+	// through a hash table as soon as "vertices" has been read (edges listed before it
+	// wait for it by name). Throws std::runtime_error describing what's wrong with the file
+	GraphDescription loadJson(std::istream& input);
+
+	// text is cut into chunks of about this many bytes, on line boundaries, which are parsed in parallel
+	inline constexpr size_t TEXT_CHUNK_BYTES = 4ull << 20;
+
+	// One edge per line, the first two fields are its endpoints and the rest (weights etc.) is ignored.
+	// Fields are separated by delimiter, or by runs of spaces and tabs when it's 0. Blank lines and
+	// ones starting with # or % are skipped. When every endpoint is a non-negative integer those are
+	// the vertex indices (and names), unless they are sparse (see SPARSE_ID_FACTOR in GraphLoaderText.cpp),
+	// then they are numbered in increasing order. Otherwise vertices get numbered in the order they first appear
+	GraphDescription loadEdgeList(std::string_view text, char delimiter, size_t chunkBytes = TEXT_CHUNK_BYTES);
+
+	// Coordinate Matrix Market: the matrix has to be square, entry (i, j) is the edge i -> j
+	// unless its value is 0 and symmetric matrices get both directions. Vertices are named
+	// by their 1-based indices, as in the file
+	GraphDescription loadMatrixMarket(std::string_view text, size_t chunkBytes = TEXT_CHUNK_BYTES);
+}
\ No newline at end of file
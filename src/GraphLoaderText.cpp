@@ -0,0 +1,473 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+using namespace graph;
+
+namespace
+{
+	struct EdgeTokens
+	{
+		std::string_view from, to;
+	};
+
+	// One piece of the text, parsed on its own. Errors are only recorded with the line
+	// number inside the chunk, the global one is known once every chunk counted its lines
+	template<typename Item>
+	struct TextChunk
+	{
+		std::string_view text;
+		std::vector<Item> items;
+		size_t lineCount = 0;
+		size_t errorLine = 0;
+		const char* error = nullptr;
+
+		void fail(const char* message)
+		{
+			if (!error)
+			{
+				error = message;
+				errorLine = lineCount;
+			}
+		}
+	};
+}
+
+// cuts text into chunks of about chunkBytes, each one ending right after a newline
+template<typename Item>
+static std::vector<TextChunk<Item>> splitChunks(std::string_view text, size_t chunkBytes)
+{
+	std::vector<TextChunk<Item>> chunks;
+	size_t begin = 0;
+
+	while (begin < text.size())
+	{
+		size_t end = begin + std::max<size_t>(chunkBytes, 1);
+		if (end >= text.size())
+			end = text.size();
+		else
+		{
+			size_t newline = text.find('\n', end - 1);
+			end = newline == std::string_view::npos ? text.size() : newline + 1;
+		}
+
+		chunks.emplace_back().text = text.substr(begin, end - begin);
+		begin = end;
+	}
+
+	return chunks;
+}
+
+// calls parseLine(chunk, line) for every line of every chunk, chunks run in parallel
+template<typename Item, typename Fn>
+static void parseChunks(std::vector<TextChunk<Item>>& chunks, Fn&& parseLine)
+{
+	auto parseChunk = [&](size_t ix)
+	{
+		TextChunk<Item>& chunk = chunks[ix];
+		const char* cursor = chunk.text.data();
+		const char* end = cursor + chunk.text.size();
+
+		while (cursor < end && !chunk.error)
+		{
+			const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+			const char* lineEnd = newline ? newline : end;
+
+			chunk.lineCount++;
+			parseLine(chunk, std::string_view(cursor, lineEnd - cursor));
+			cursor = lineEnd + 1;
+		}
+	};
+
+	if (chunks.size() < 2)
+	{
+		for (size_t ix = 0; ix < chunks.size(); ix++)
+			parseChunk(ix);
+	}
+	else
+		linear_algebra::ThreadPool::Global().parallelFor(chunks.size(), parseChunk);
+}
+
+// throws the error of the first failed chunk, with its line number in the whole text
+// (linesBefore of which come before the first chunk)
+template<typename Item>
+static void checkChunks(const std::vector<TextChunk<Item>>& chunks, size_t linesBefore)
+{
+	size_t line = linesBefore;
+	for (const TextChunk<Item>& chunk : chunks)
+	{
+		if (chunk.error)
+			throw std::runtime_error(std::string(chunk.error) + " (line " + std::to_string(line + chunk.errorLine) + ")");
+
+		line += chunk.lineCount;
+	}
+}
+
+template<typename Item>
+static size_t countItems(const std::vector<TextChunk<Item>>& chunks)
+{
+	size_t count = 0;
+	for (const TextChunk<Item>& chunk : chunks)
+		count += chunk.items.size();
+
+	return count;
+}
+
+static bool isBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static std::string_view trim(std::string_view field)
+{
+	while (!field.empty() && isBlank(field.front()))
+		field.remove_prefix(1);
+	while (!field.empty() && isBlank(field.back()))
+		field.remove_suffix(1);
+
+	if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
+		field = field.substr(1, field.size() - 2);
+
+	return field;
+}
+
+// takes the next field off the front of line, an empty view when there is none
+static std::string_view nextField(std::string_view& line, char delimiter)
+{
+	if (delimiter == 0)
+	{
+		size_t begin = 0;
+		while (begin < line.size() && isBlank(line[begin]))
+			begin++;
+
+		size_t end = begin;
+		while (end < line.size() && !isBlank(line[end]))
+			end++;
+
+		std::string_view field = line.substr(begin, end - begin);
+		line.remove_prefix(end);
+		return field;
+	}
+
+	size_t end = line.find(delimiter);
+	std::string_view field = trim(line.substr(0, end));
+	line.remove_prefix(end == std::string_view::npos ? line.size() : end + 1);
+	return field;
+}
+
+// a whole field holding a non-negative integer
+static bool parseIndex(std::string_view field, uint64_t& value)
+{
+	auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+	return error == std::errc() && end == field.data() + field.size() && !field.empty();
+}
+
+// blank lines and comments
+static bool isSkipped(std::string_view line)
+{
+	std::string_view content = trim(line);
+	return content.empty() || content.front() == '#' || content.front() == '%';
+}
+
+// integer ids are taken for indices unless the largest one is more than this many times the
+// edge count, then the vertices would be mostly names nothing refers to (and could run out
+// of memory) so the ids with edges get renumbered instead
+static constexpr uint64_t SPARSE_ID_FACTOR = 16;
+
+static GraphDescription namedVertices(size_t count, uint64_t firstName)
+{
+	GraphDescription description;
+	description.vertices.reserve(count);
+	for (size_t v = 0; v < count; v++)
+		description.vertices.push_back(std::to_string(firstName + v));
+
+	return description;
+}
+
+GraphDescription graph::loadEdgeList(std::string_view text, char delimiter, size_t chunkBytes)
+{
+	DIGRAPH_PROFILE_SCOPE("parse edge list");
+
+	auto chunks = splitChunks<EdgeTokens>(text, chunkBytes);
+
+	// whether every endpoint so far is an integer, per chunk
+	std::vector<uint8_t> integral(chunks.size(), 1);
+	std::vector<uint64_t> maxIndex(chunks.size(), 0);
+
+	parseChunks(chunks, [&](TextChunk<EdgeTokens>& chunk, std::string_view line)
+	{
+		if (isSkipped(line))
+			return;
+
+		EdgeTokens tokens;
+		tokens.from = nextField(line, delimiter);
+		tokens.to = nextField(line, delimiter);
+
+		if (tokens.from.empty() || tokens.to.empty())
+			return chunk.fail("Edge should have a source and a target vertex");
+
+		size_t ix = &chunk - chunks.data();
+		uint64_t from, to;
+		if (integral[ix] && parseIndex(tokens.from, from) && parseIndex(tokens.to, to))
+			maxIndex[ix] = std::max({ maxIndex[ix], from, to });
+		else
+			integral[ix] = 0;
+
+		chunk.items.push_back(tokens);
+	});
+
+	checkChunks(chunks, 0);
+
+	size_t edgeCount = countItems(chunks);
+	if (edgeCount == 0)
+		throw std::runtime_error("A graph described in file should have at least 2 vertices and 1 edge");
+
+	bool indices = std::all_of(integral.begin(), integral.end(), [](uint8_t flag) { return flag != 0; });
+
+	uint64_t largestIndex = indices ? *std::max_element(maxIndex.begin(), maxIndex.end()) : 0;
+
+	if (indices && largestIndex / SPARSE_ID_FACTOR <= edgeCount)
+	{
+		if (largestIndex >= std::numeric_limits<Vertex>::max() - 1)
+			throw std::runtime_error("A graph described in file has too many vertices");
+
+		GraphDescription description = namedVertices(largestIndex + 1, 0);
+		description.edges.resize(edgeCount);
+
+		// every chunk writes its own range of the edge array
+		std::vector<size_t> firstEdge(chunks.size(), 0);
+		for (size_t ix = 1; ix < chunks.size(); ix++)
+			firstEdge[ix] = firstEdge[ix - 1] + chunks[ix - 1].items.size();
+
+		auto convert = [&](size_t ix)
+		{
+			Edge* out = description.edges.data() + firstEdge[ix];
+			for (const EdgeTokens& tokens : chunks[ix].items)
+			{
+				uint64_t from = 0, to = 0;
+				parseIndex(tokens.from, from);
+				parseIndex(tokens.to, to);
+				*out++ = { static_cast<Vertex>(from), static_cast<Vertex>(to) };
+			}
+		};
+
+		if (chunks.size() < 2)
+			convert(0);
+		else
+			linear_algebra::ThreadPool::Global().parallelFor(chunks.size(), convert);
+
+		return description;
+	}
+
+	if (indices)
+	{
+		// sparse ids become the indices of their rank, so the vertices still follow their order
+		std::vector<uint64_t> ids;
+		ids.reserve(2 * edgeCount);
+		for (const TextChunk<EdgeTokens>& chunk : chunks)
+		{
+			for (const EdgeTokens& tokens : chunk.items)
+			{
+				uint64_t from = 0, to = 0;
+				parseIndex(tokens.from, from);
+				parseIndex(tokens.to, to);
+				ids.push_back(from);
+				ids.push_back(to);
+			}
+		}
+
+		std::vector<uint64_t> sorted = ids;
+		std::sort(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+		if (sorted.size() >= std::numeric_limits<Vertex>::max() - 1)
+			throw std::runtime_error("A graph described in file has too many vertices");
+
+		GraphDescription description;
+		description.vertices.reserve(sorted.size());
+		for (uint64_t id : sorted)
+			description.vertices.push_back(std::to_string(id));
+
+		auto rank = [&](uint64_t id) { return static_cast<Vertex>(std::lower_bound(sorted.begin(), sorted.end(), id) - sorted.begin()); };
+
+		description.edges.reserve(edgeCount);
+		for (size_t i = 0; i < ids.size(); i += 2)
+			description.edges.push_back({ rank(ids[i]), rank(ids[i + 1]) });
+
+		return description;
+	}
+
+	// names get their indices in order of appearance, which has to be sequential.
+	// the keys are views into text, so only the names themselves are copied
+	GraphDescription description;
+	description.edges.reserve(edgeCount);
+	std::unordered_map<std::string_view, Vertex> lookupTable;
+
+	auto resolve = [&](std::string_view name)
+	{
+		auto [it, inserted] = lookupTable.try_emplace(name, static_cast<Vertex>(description.vertices.size()));
+		if (inserted)
+		{
+			if (description.vertices.size() >= std::numeric_limits<Vertex>::max() - 1)
+				throw std::runtime_error("A graph described in file has too many vertices");
+
+			description.vertices.emplace_back(name);
+		}
+
+		return it->second;
+	};
+
+	for (const TextChunk<EdgeTokens>& chunk : chunks)
+	{
+		for (const EdgeTokens& tokens : chunk.items)
+		{
+			Vertex from = resolve(tokens.from);
+			description.edges.push_back({ from, resolve(tokens.to) });
+		}
+	}
+
+	return description;
+}
+
+GraphDescription graph::loadMatrixMarket(std::string_view text, size_t chunkBytes)
+{
+	DIGRAPH_PROFILE_SCOPE("parse matrix market");
+
+	// the banner, comments and the size line are read sequentially
+	size_t line = 0;
+	auto nextLine = [&]() -> std::string_view
+	{
+		if (text.empty())
+			throw std::runtime_error("Matrix Market file ends before its entries");
+
+		size_t end = text.find('\n');
+		std::string_view result = text.substr(0, end);
+		text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+		line++;
+		return result;
+	};
+
+	std::string banner(nextLine());
+	std::transform(banner.begin(), banner.end(), banner.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	std::string_view header = banner;
+	std::string_view tokens[5];
+	for (std::string_view& token : tokens)
+		token = nextField(header, 0);
+
+	if (tokens[0] != "%%matrixmarket" || tokens[1] != "matrix")
+		throw std::runtime_error("File is not a Matrix Market matrix");
+
+	if (tokens[2] != "coordinate")
+		throw std::runtime_error("Only coordinate Matrix Market files are supported");
+
+	std::string_view field = tokens[3];
+	std::string_view symmetry = tokens[4];
+
+	if (field != "pattern" && field != "integer" && field != "real" && field != "double" && field != "complex")
+		throw std::runtime_error("Unknown Matrix Market field type");
+
+	if (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric" && symmetry != "hermitian")
+		throw std::runtime_error("Unknown Matrix Market symmetry");
+
+	std::string_view sizeLine;
+	do
+		sizeLine = nextLine();
+	while (isSkipped(sizeLine));
+
+	uint64_t rows = 0, cols = 0, entries = 0;
+	if (!parseIndex(nextField(sizeLine, 0), rows) || !parseIndex(nextField(sizeLine, 0), cols) || !parseIndex(nextField(sizeLine, 0), entries))
+		throw std::runtime_error("Matrix Market size line should hold the row, column and entry counts");
+
+	if (rows != cols)
+		throw std::runtime_error("Matrix Market adjacency matrix has to be square");
+
+	if (rows == 0 || rows >= std::numeric_limits<Vertex>::max())
+		throw std::runtime_error("A graph described in file should have at least 2 vertices and 1 edge");
+
+	bool pattern = field == "pattern";
+	bool complex = field == "complex";
+	bool mirrored = symmetry != "general";
+
+	auto chunks = splitChunks<Edge>(text, chunkBytes);
+
+	// entries per chunk, explicit zeros included, to check against the declared count
+	std::vector<uint64_t> entryCount(chunks.size(), 0);
+
+	parseChunks(chunks, [&](TextChunk<Edge>& chunk, std::string_view line)
+	{
+		if (isSkipped(line))
+			return;
+
+		uint64_t i, j;
+		if (!parseIndex(nextField(line, 0), i) || !parseIndex(nextField(line, 0), j))
+			return chunk.fail("Matrix Market entry should start with its row and column");
+
+		if (i == 0 || j == 0 || i > rows || j > cols)
+			return chunk.fail("Matrix Market entry is out of range");
+
+		entryCount[&chunk - chunks.data()]++;
+
+		if (!pattern)
+		{
+			bool nonZero = false;
+			for (int part = 0; part < (complex ? 2 : 1); part++)
+			{
+				std::string_view value = nextField(line, 0);
+				double number;
+				auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+				if (error != std::errc() || end != value.data() + value.size())
+					return chunk.fail("Matrix Market entry has an invalid value");
+
+				nonZero = nonZero || number != 0.0;
+			}
+
+			if (!nonZero)
+				return;
+		}
+
+		Vertex from = static_cast<Vertex>(i - 1);
+		Vertex to = static_cast<Vertex>(j - 1);
+
+		chunk.items.push_back({ from, to });
+		if (mirrored && from != to)
+			chunk.items.push_back({ to, from });
+	});
+
+	checkChunks(chunks, line);
+
+	if (std::accumulate(entryCount.begin(), entryCount.end(), uint64_t(0)) != entries)
+		throw std::runtime_error("Matrix Market file holds a different number of entries than its size line declares");
+
+	GraphDescription description = namedVertices(rows, 1);
+	description.edges.reserve(countItems(chunks));
+	for (const TextChunk<Edge>& chunk : chunks)
+		description.edges.insert(description.edges.end(), chunk.items.begin(), chunk.items.end());
+
+	if (description.edges.empty())
+		throw std::runtime_error("A graph described in file should have at least 2 vertices and 1 edge");
+
+	return description;
+}
\ No newline at end of file
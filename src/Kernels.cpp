@@ -0,0 +1,145 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Kernels.h"
+
+using namespace linear_algebra::kernels;
+
+static std::atomic<const KernelTable*> s_activeKernels{ nullptr };
+
+static const KernelTable& tableOf(Isa isa)
+{
+	switch (isa)
+	{
+	case Isa::SSE42: return sse42Kernels;
+	case Isa::AVX2: return avx2Kernels;
+	case Isa::AVX512: return avx512Kernels;
+	default: return scalarKernels;
+	}
+}
+
+bool linear_algebra::kernels::isSupported(Isa isa)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	// cpuid leaf 1 ecx: sse4.2 (20), fma (12), osxsave (27), avx (28). leaf 7 ebx: avx2 (5), avx512f (16)
+	int regs[4];
+	__cpuid(regs, 0);
+	int maxLeaf = regs[0];
+
+	__cpuid(regs, 1);
+	int ecx1 = regs[2];
+	int ebx7 = 0;
+
+	if (maxLeaf >= 7)
+	{
+		__cpuidex(regs, 7, 0);
+		ebx7 = regs[1];
+	}
+
+	// the OS has to save the ymm (and for AVX-512 the zmm and mask) registers as well
+	uint64_t xcr0 = (ecx1 & (1 << 27)) ? _xgetbv(0) : 0;
+	bool ymmState = (xcr0 & 0x06) == 0x06;
+	bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+	bool sse42 = ecx1 & (1 << 20);
+	bool avx2 = ymmState && (ecx1 & (1 << 28)) && (ecx1 & (1 << 12)) && (ebx7 & (1 << 5));
+	bool avx512 = avx2 && zmmState && (ebx7 & (1 << 16));
+#else
+	// backed by cpuid, also checks that the OS saves the extended register state
+	__builtin_cpu_init();
+	bool sse42 = __builtin_cpu_supports("sse4.2");
+	bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	bool avx512 = avx2 && __builtin_cpu_supports("avx512f");
+#endif
+
+	switch (isa)
+	{
+	case Isa::Scalar: return true;
+	case Isa::SSE42: return sse42;
+	case Isa::AVX2: return avx2;
+	case Isa::AVX512: return avx512;
+	default: return false;
+	}
+}
+
+Isa linear_algebra::kernels::detectIsa()
+{
+	for (Isa isa : { Isa::AVX512, Isa::AVX2, Isa::SSE42 })
+	{
+		if (isSupported(isa))
+			return isa;
+	}
+
+	return Isa::Scalar;
+}
+
+const char* linear_algebra::kernels::isaName(Isa isa)
+{
+	switch (isa)
+	{
+	case Isa::SSE42: return "sse4.2";
+	case Isa::AVX2: return "avx2";
+	case Isa::AVX512: return "avx512";
+	default: return "scalar";
+	}
+}
+
+bool linear_algebra::kernels::parseIsa(const char* name, Isa& isa)
+{
+	for (Isa candidate : { Isa::Scalar, Isa::SSE42, Isa::AVX2, Isa::AVX512 })
+	{
+		if (std::strcmp(name, isaName(candidate)) == 0)
+		{
+			isa = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const KernelTable& linear_algebra::kernels::active()
+{
+	const KernelTable* table = s_activeKernels.load(std::memory_order_acquire);
+	if (table)
+		return *table;
+
+	// an override the CPU can't run is ignored rather than crashing later
+	Isa isa = detectIsa();
+	Isa requested;
+	const char* env = std::getenv("DIGRAPH_ISA");
+
+	if (env && parseIsa(env, requested) && isSupported(requested))
+		isa = requested;
+
+	table = &tableOf(isa);
+	s_activeKernels.store(table, std::memory_order_release);
+	return *table;
+}
+
+void linear_algebra::kernels::selectIsa(Isa isa)
+{
+	if (!isSupported(isa))
+		throw std::invalid_argument(std::string("Invalid argument: This CPU doesn't support ") + isaName(isa));
+
+	s_activeKernels.store(&tableOf(isa), std::memory_order_release);
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+// Per instruction set implementations of the innermost matrix loops. Every
+// KernelsXXX.cpp is compiled with its own target flags (and without the
+// precompiled header) and exports one KernelTable, the rest of the library only
+// ever calls through the table picked at startup. Nothing in here may be inline:
+// an inline function compiled into one of the ISA units could be the copy the
+// linker keeps for the whole program.
+namespace linear_algebra::kernels
+{
+	// ordered from the most portable to the fastest
+	enum class Isa
+	{
+		Scalar,
+		SSE42,
+		AVX2,	// AVX2 + FMA
+		AVX512	// AVX-512F
+	};
+
+	// register block of the packed GEMM micro kernel, every ISA uses the same packing
+	inline constexpr size_t GEMM_MR = 6;
+	inline constexpr size_t GEMM_NR = 16;
+
+	// count is always a whole number of 32-byte column groups (padded rows)
+	template <typename T>
+	struct ElementwiseKernels
+	{
+		// out[i] = a[i] + b[i]. Saturating for uint64_t counts, wrapping for the other integers
+		void (*add)(const T* a, const T* b, T* out, size_t count);
+
+		// out[i] = src[i] * scalar, out may be src. Saturating for uint64_t as well
+		void (*scale)(const T* src, T scalar, T* out, size_t count);
+
+		// bit i of mask[i / 64] is set when src[i] != 0 (NaN included), mask holds count / 64
+		// words rounded up. Returns whether any bit was set
+		bool (*nonZeroMask)(const T* src, uint64_t* mask, size_t count);
+
+		// index of the first src[i] != 0, count when there is none
+		size_t (*findNonZero)(const T* src, size_t count);
+	};
+
+	// c (+)= a * b over rows [rowBegin, rowEnd) and cols [colBegin, colEnd) of c, in blocks of 4 rows
+	// and one 32-byte column group. the row range is a multiple of 4 and the col range a multiple
+	// of the group (both padded). Integer products wrap around
+	template <typename T>
+	using GemmTileKernel = void (*)(size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd, size_t k,
+		const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, bool accumulate);
+
+	struct KernelTable
+	{
+		Isa isa;
+
+		ElementwiseKernels<float> f32;
+		ElementwiseKernels<double> f64;
+		ElementwiseKernels<int32_t> i32;
+		ElementwiseKernels<uint8_t> u8;
+		ElementwiseKernels<uint64_t> u64;
+
+		GemmTileKernel<float> gemmTileF32;
+		GemmTileKernel<double> gemmTileF64;
+		GemmTileKernel<int32_t> gemmTileI32;
+
+		// c[0..MR)[0..NR) (+)= packed a sliver * packed b sliver
+		void (*microKernelF32)(size_t kc, const float* a, const float* b, float* c, size_t ldc, bool accumulate);
+
+		// out[j] = out[j] + scalar * row[j], stuck at UINT64_MAX on overflow. count is a multiple of 4
+		void (*countAxpySaturating)(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count);
+
+		// out[j] += scalar * row[j] with scalar and row below 2^31, lanes crossing 2^63 get fold
+		// subtracted (see detail::ModularOps). count is a multiple of 4
+		void (*countAxpyModular)(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count, uint64_t fold);
+
+		// out[j] += scalar * row[j] with the bytes of row widened to 64 bits, count is a multiple of 4.
+		// row has to stay readable up to the next 32-byte column group
+		void (*widenAxpyU8)(uint8_t scalar, const uint8_t* row, uint64_t* out, size_t count);
+
+		// dst[w] |= src[w] over bit rows, words is a multiple of 4 (rows padded to 256 bits)
+		void (*orWords)(const uint64_t* src, uint64_t* dst, size_t words);
+	};
+
+	extern const KernelTable scalarKernels;
+	extern const KernelTable sse42Kernels;
+	extern const KernelTable avx2Kernels;
+	extern const KernelTable avx512Kernels;
+
+	// kernels in use. Picked on first call: the fastest ISA the CPU supports, unless
+	// the DIGRAPH_ISA environment variable names another supported one
+	const KernelTable& active();
+
+	// forces an ISA (e.g. for benchmarking), throws if the CPU doesn't support it.
+	// should not be called while another thread runs matrix operations
+	void selectIsa(Isa isa);
+
+	bool isSupported(Isa isa);
+	Isa detectIsa();
+
+	// "scalar", "sse4.2", "avx2" and "avx512"
+	const char* isaName(Isa isa);
+	bool parseIsa(const char* name, Isa& isa);
+}
\ No newline at end of file
@@ -0,0 +1,479 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+// compiled with AVX2 and FMA enabled and without the precompiled header (see Kernels.h)
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Kernels.h"
+
+using namespace linear_algebra::kernels;
+
+namespace
+{
+	// one ymm register per 32-byte column group
+	template <typename T>
+	struct Vec;
+
+	template <>
+	struct Vec<float>
+	{
+		using Type = __m256;
+		static Type load(const float* p) { return _mm256_load_ps(p); }
+		static void store(float* p, Type v) { _mm256_store_ps(p, v); }
+		static Type broadcast(float x) { return _mm256_set1_ps(x); }
+		static Type zero() { return _mm256_setzero_ps(); }
+		static Type add(Type a, Type b) { return _mm256_add_ps(a, b); }
+		static Type mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+		static Type mulAdd(Type a, Type b, Type c) { return _mm256_fmadd_ps(a, b, c); }
+	};
+
+	template <>
+	struct Vec<double>
+	{
+		using Type = __m256d;
+		static Type load(const double* p) { return _mm256_load_pd(p); }
+		static void store(double* p, Type v) { _mm256_store_pd(p, v); }
+		static Type broadcast(double x) { return _mm256_set1_pd(x); }
+		static Type zero() { return _mm256_setzero_pd(); }
+		static Type add(Type a, Type b) { return _mm256_add_pd(a, b); }
+		static Type mul(Type a, Type b) { return _mm256_mul_pd(a, b); }
+		static Type mulAdd(Type a, Type b, Type c) { return _mm256_fmadd_pd(a, b, c); }
+	};
+
+	template <>
+	struct Vec<int32_t>
+	{
+		using Type = __m256i;
+		static Type load(const int32_t* p) { return _mm256_load_si256((const __m256i*)p); }
+		static void store(int32_t* p, Type v) { _mm256_store_si256((__m256i*)p, v); }
+		static Type broadcast(int32_t x) { return _mm256_set1_epi32(x); }
+		static Type zero() { return _mm256_setzero_si256(); }
+		static Type add(Type a, Type b) { return _mm256_add_epi32(a, b); }
+		static Type mul(Type a, Type b) { return _mm256_mullo_epi32(a, b); }
+		static Type mulAdd(Type a, Type b, Type c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+	};
+}
+
+template <typename T>
+static void addKernel(const T* a, const T* b, T* out, size_t count)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	for (size_t i = 0; i < count; i += LANES)
+		V::store(&out[i], V::add(V::load(&a[i]), V::load(&b[i])));
+
+	_mm256_zeroupper();
+}
+
+template <typename T>
+static void scaleKernel(const T* src, T scalar, T* out, size_t count)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	typename V::Type scalarVec = V::broadcast(scalar);
+	for (size_t i = 0; i < count; i += LANES)
+		V::store(&out[i], V::mul(V::load(&src[i]), scalarVec));
+
+	_mm256_zeroupper();
+}
+
+// 4 rows x one column group (one register) per block
+template <typename T>
+static void gemmTile(size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd, size_t k,
+	const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, bool accumulate)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	for (size_t i = rowBegin; i < rowEnd; i += 4)
+		for (size_t j = colBegin; j < colEnd; j += LANES)
+		{
+			typename V::Type c0 = V::zero();
+			typename V::Type c1 = V::zero();
+			typename V::Type c2 = V::zero();
+			typename V::Type c3 = V::zero();
+
+			for (size_t p = 0; p < k; p++)
+			{
+				typename V::Type rowRhs = V::load(&b[p * ldb + j]);
+
+				c0 = V::mulAdd(V::broadcast(a[i * lda + p]), rowRhs, c0);
+				c1 = V::mulAdd(V::broadcast(a[(i + 1) * lda + p]), rowRhs, c1);
+				c2 = V::mulAdd(V::broadcast(a[(i + 2) * lda + p]), rowRhs, c2);
+				c3 = V::mulAdd(V::broadcast(a[(i + 3) * lda + p]), rowRhs, c3);
+			}
+
+			if (accumulate)
+			{
+				c0 = V::add(c0, V::load(&c[i * ldc + j]));
+				c1 = V::add(c1, V::load(&c[(i + 1) * ldc + j]));
+				c2 = V::add(c2, V::load(&c[(i + 2) * ldc + j]));
+				c3 = V::add(c3, V::load(&c[(i + 3) * ldc + j]));
+			}
+
+			V::store(&c[i * ldc + j], c0);
+			V::store(&c[(i + 1) * ldc + j], c1);
+			V::store(&c[(i + 2) * ldc + j], c2);
+			V::store(&c[(i + 3) * ldc + j], c3);
+		}
+
+	_mm256_zeroupper();
+}
+
+static void addU8(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t count)
+{
+	for (size_t i = 0; i < count; i += 32)
+	{
+		__m256i sum = _mm256_add_epi8(_mm256_load_si256((const __m256i*)&a[i]), _mm256_load_si256((const __m256i*)&b[i]));
+		_mm256_store_si256((__m256i*)&out[i], sum);
+	}
+
+	_mm256_zeroupper();
+}
+
+// there is no byte multiply, even and odd bytes go through the 16-bit one separately
+static void scaleU8(const uint8_t* src, uint8_t scalar, uint8_t* out, size_t count)
+{
+	const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+	__m256i scalarVec = _mm256_set1_epi16(scalar);
+
+	for (size_t i = 0; i < count; i += 32)
+	{
+		__m256i vec = _mm256_load_si256((const __m256i*)&src[i]);
+		__m256i even = _mm256_and_si256(_mm256_mullo_epi16(vec, scalarVec), lowBytes);
+		__m256i odd = _mm256_slli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(vec, 8), scalarVec), 8);
+		_mm256_store_si256((__m256i*)&out[i], _mm256_or_si256(even, odd));
+	}
+
+	_mm256_zeroupper();
+}
+
+static void microKernelF32(size_t kc, const float* a, const float* b, float* c, size_t ldc, bool accumulate)
+{
+	__m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+	__m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+	__m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+	__m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+	__m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+	__m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+	for (size_t p = 0; p < kc; p++)
+	{
+		__m256 b0 = _mm256_load_ps(b);
+		__m256 b1 = _mm256_load_ps(b + 8);
+		__m256 av;
+
+		av = _mm256_broadcast_ss(a);
+		c00 = _mm256_fmadd_ps(av, b0, c00);
+		c01 = _mm256_fmadd_ps(av, b1, c01);
+
+		av = _mm256_broadcast_ss(a + 1);
+		c10 = _mm256_fmadd_ps(av, b0, c10);
+		c11 = _mm256_fmadd_ps(av, b1, c11);
+
+		av = _mm256_broadcast_ss(a + 2);
+		c20 = _mm256_fmadd_ps(av, b0, c20);
+		c21 = _mm256_fmadd_ps(av, b1, c21);
+
+		av = _mm256_broadcast_ss(a + 3);
+		c30 = _mm256_fmadd_ps(av, b0, c30);
+		c31 = _mm256_fmadd_ps(av, b1, c31);
+
+		av = _mm256_broadcast_ss(a + 4);
+		c40 = _mm256_fmadd_ps(av, b0, c40);
+		c41 = _mm256_fmadd_ps(av, b1, c41);
+
+		av = _mm256_broadcast_ss(a + 5);
+		c50 = _mm256_fmadd_ps(av, b0, c50);
+		c51 = _mm256_fmadd_ps(av, b1, c51);
+
+		a += GEMM_MR;
+		b += GEMM_NR;
+	}
+
+	__m256 rows[GEMM_MR][2] = {
+		{ c00, c01 }, { c10, c11 }, { c20, c21 },
+		{ c30, c31 }, { c40, c41 }, { c50, c51 }
+	};
+
+	for (size_t r = 0; r < GEMM_MR; r++)
+	{
+		float* dst = &c[r * ldc];
+		if (accumulate)
+		{
+			rows[r][0] = _mm256_add_ps(rows[r][0], _mm256_loadu_ps(dst));
+			rows[r][1] = _mm256_add_ps(rows[r][1], _mm256_loadu_ps(dst + 8));
+		}
+
+		_mm256_storeu_ps(dst, rows[r][0]);
+		_mm256_storeu_ps(dst + 8, rows[r][1]);
+	}
+
+	_mm256_zeroupper();
+}
+
+// unsigned a > b in every 64-bit lane, AVX2 only has the signed compare
+static inline __m256i greaterThanEpu64(__m256i a, __m256i b)
+{
+	const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+	return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+}
+
+// a + b, lanes that wrapped around become UINT64_MAX
+static inline __m256i saturatingAdd4(__m256i a, __m256i b)
+{
+	__m256i sum = _mm256_add_epi64(a, b);
+	return _mm256_or_si256(sum, greaterThanEpu64(a, sum));
+}
+
+// scalar * b for a scalar below 2^32 (broadcast to all lanes), saturating.
+// the product is put together from the two 32x32 -> 64 bit halves
+static inline __m256i saturatingMul4(__m256i scalar, __m256i b)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	__m256i low = _mm256_mul_epu32(scalar, b);
+	__m256i high = _mm256_mul_epu32(scalar, _mm256_srli_epi64(b, 32));
+
+	// high has to fit into 32 bits before it's shifted into place
+	__m256i overflow = _mm256_xor_si256(_mm256_cmpeq_epi64(_mm256_srli_epi64(high, 32), zero), _mm256_set1_epi64x(-1));
+	__m256i product = _mm256_add_epi64(_mm256_slli_epi64(high, 32), low);
+	overflow = _mm256_or_si256(overflow, greaterThanEpu64(low, product));
+
+	return _mm256_or_si256(product, overflow);
+}
+
+static void addU64(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t count)
+{
+	for (size_t i = 0; i < count; i += 4)
+	{
+		__m256i sum = saturatingAdd4(_mm256_load_si256((const __m256i*)&a[i]), _mm256_load_si256((const __m256i*)&b[i]));
+		_mm256_store_si256((__m256i*)&out[i], sum);
+	}
+
+	_mm256_zeroupper();
+}
+
+static void scaleU64(const uint64_t* src, uint64_t scalar, uint64_t* out, size_t count)
+{
+	if (scalar >> 32)
+	{
+		scalarKernels.u64.scale(src, scalar, out, count);
+		return;
+	}
+
+	__m256i scalarVec = _mm256_set1_epi64x(static_cast<int64_t>(scalar));
+	for (size_t i = 0; i < count; i += 4)
+		_mm256_store_si256((__m256i*)&out[i], saturatingMul4(scalarVec, _mm256_load_si256((const __m256i*)&src[i])));
+
+	_mm256_zeroupper();
+}
+
+static void countAxpySaturating(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count)
+{
+	// AVX2 has no 64x64 multiply, huge counts are rare enough to go scalar
+	if (scalar >> 32)
+	{
+		scalarKernels.countAxpySaturating(scalar, row, out, count);
+		return;
+	}
+
+	if (scalar == 1)
+	{
+		// adjacency matrices are all ones, those need no multiplication at all
+		for (size_t j = 0; j < count; j += 4)
+		{
+			__m256i acc = _mm256_load_si256((const __m256i*)&out[j]);
+			__m256i vec = _mm256_load_si256((const __m256i*)&row[j]);
+			_mm256_store_si256((__m256i*)&out[j], saturatingAdd4(acc, vec));
+		}
+	}
+	else
+	{
+		__m256i scalarVec = _mm256_set1_epi64x(static_cast<int64_t>(scalar));
+		for (size_t j = 0; j < count; j += 4)
+		{
+			__m256i acc = _mm256_load_si256((const __m256i*)&out[j]);
+			__m256i vec = _mm256_load_si256((const __m256i*)&row[j]);
+			_mm256_store_si256((__m256i*)&out[j], saturatingAdd4(acc, saturatingMul4(scalarVec, vec)));
+		}
+	}
+
+	_mm256_zeroupper();
+}
+
+static void countAxpyModular(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count, uint64_t fold)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i scalarVec = _mm256_set1_epi64x(static_cast<int64_t>(scalar));
+	__m256i foldVec = _mm256_set1_epi64x(static_cast<int64_t>(fold));
+
+	for (size_t j = 0; j < count; j += 4)
+	{
+		__m256i acc = _mm256_load_si256((const __m256i*)&out[j]);
+		__m256i vec = _mm256_load_si256((const __m256i*)&row[j]);
+
+		// both operands are below 2^31, so the 32x32 bit multiply is exact
+		acc = _mm256_add_epi64(acc, _mm256_mul_epu32(scalarVec, vec));
+
+		// lanes that crossed 2^63 look negative
+		__m256i crossed = _mm256_cmpgt_epi64(zero, acc);
+		acc = _mm256_sub_epi64(acc, _mm256_and_si256(crossed, foldVec));
+
+		_mm256_store_si256((__m256i*)&out[j], acc);
+	}
+
+	_mm256_zeroupper();
+}
+
+// four bytes of row widened to 64 bits per step
+static void widenAxpyU8(uint8_t scalar, const uint8_t* row, uint64_t* out, size_t count)
+{
+	__m256i scalarVec = _mm256_set1_epi64x(scalar);
+
+	for (size_t j = 0; j < count; j += 4)
+	{
+		__m256i vec = _mm256_cvtepu8_epi64(_mm_loadu_si32(&row[j]));
+		__m256i acc = _mm256_load_si256((const __m256i*)&out[j]);
+		_mm256_store_si256((__m256i*)&out[j], _mm256_add_epi64(acc, _mm256_mul_epu32(vec, scalarVec)));
+	}
+
+	_mm256_zeroupper();
+}
+
+// one 256-bit chunk of the row per step
+static void orWords(const uint64_t* src, uint64_t* dst, size_t words)
+{
+	for (size_t w = 0; w < words; w += 4)
+	{
+		__m256i bits = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)&dst[w]), _mm256_loadu_si256((const __m256i*)&src[w]));
+		_mm256_storeu_si256((__m256i*)&dst[w], bits);
+	}
+
+	_mm256_zeroupper();
+}
+
+// bit per lane of one ymm register, set for the nonzero ones
+static uint64_t nonZeroLanes(const float* p)
+{
+	return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_setzero_ps(), _CMP_NEQ_UQ)));
+}
+
+static uint64_t nonZeroLanes(const double* p)
+{
+	return static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), _mm256_setzero_pd(), _CMP_NEQ_UQ)));
+}
+
+static uint64_t nonZeroLanes(const int32_t* p)
+{
+	__m256i zero = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)p), _mm256_setzero_si256());
+	return ~static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(zero))) & 0xFF;
+}
+
+static uint64_t nonZeroLanes(const uint8_t* p)
+{
+	__m256i zero = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), _mm256_setzero_si256());
+	return ~static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(zero))) & 0xFFFFFFFF;
+}
+
+static uint64_t nonZeroLanes(const uint64_t* p)
+{
+	__m256i zero = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)p), _mm256_setzero_si256());
+	return ~static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(zero))) & 0xF;
+}
+
+// index of the lowest set bit of a nonzero word
+static inline size_t lowestSetBit(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return index;
+#else
+	return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+}
+
+// LANES divides 64, so a step never straddles two mask words
+template <typename T>
+static bool nonZeroMaskKernel(const T* src, uint64_t* mask, size_t count)
+{
+	constexpr size_t LANES = 32 / sizeof(T);
+	uint64_t any = 0;
+
+	for (size_t w = 0; w * 64 < count; w++)
+	{
+		uint64_t word = 0;
+		size_t end = count < w * 64 + 64 ? count : w * 64 + 64;
+		for (size_t i = w * 64; i < end; i += LANES)
+			word |= nonZeroLanes(&src[i]) << (i % 64);
+
+		mask[w] = word;
+		any |= word;
+	}
+
+	_mm256_zeroupper();
+	return any != 0;
+}
+
+template <typename T>
+static size_t findNonZeroKernel(const T* src, size_t count)
+{
+	constexpr size_t LANES = 32 / sizeof(T);
+
+	for (size_t i = 0; i < count; i += LANES)
+	{
+		uint64_t lanes = nonZeroLanes(&src[i]);
+		if (lanes != 0)
+		{
+			_mm256_zeroupper();
+			return i + lowestSetBit(lanes);
+		}
+	}
+
+	_mm256_zeroupper();
+	return count;
+}
+
+const KernelTable linear_algebra::kernels::avx2Kernels = {
+	Isa::AVX2,
+	{ addKernel<float>, scaleKernel<float>, nonZeroMaskKernel<float>, findNonZeroKernel<float> },
+	{ addKernel<double>, scaleKernel<double>, nonZeroMaskKernel<double>, findNonZeroKernel<double> },
+	{ addKernel<int32_t>, scaleKernel<int32_t>, nonZeroMaskKernel<int32_t>, findNonZeroKernel<int32_t> },
+	{ addU8, scaleU8, nonZeroMaskKernel<uint8_t>, findNonZeroKernel<uint8_t> },
+	{ addU64, scaleU64, nonZeroMaskKernel<uint64_t>, findNonZeroKernel<uint64_t> },
+	gemmTile<float>,
+	gemmTile<double>,
+	gemmTile<int32_t>,
+	microKernelF32,
+	countAxpySaturating,
+	countAxpyModular,
+	widenAxpyU8,
+	orWords
+};
\ No newline at end of file
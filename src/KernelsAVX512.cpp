@@ -0,0 +1,489 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+// compiled with AVX-512F (plus AVX2 and FMA, which every AVX-512 CPU has) enabled
+// and without the precompiled header (see Kernels.h)
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Kernels.h"
+
+using namespace linear_algebra::kernels;
+
+namespace
+{
+	// one zmm register covers two 32-byte column groups. Padded rows are only a whole
+	// number of groups long, so every loop ends with a half register when the count isn't
+	// a multiple of the lane count
+	template <typename T>
+	struct Vec;
+
+	template <>
+	struct Vec<float>
+	{
+		using Type = __m512;
+		using Mask = __mmask16;
+		static Mask tailMask(size_t remaining) { return remaining >= 16 ? Mask(0xFFFF) : Mask(0x00FF); }
+		static Type load(Mask mask, const float* p) { return _mm512_maskz_loadu_ps(mask, p); }
+		static void store(float* p, Mask mask, Type v) { _mm512_mask_storeu_ps(p, mask, v); }
+		static Type broadcast(float x) { return _mm512_set1_ps(x); }
+		static Type zero() { return _mm512_setzero_ps(); }
+		static Type add(Type a, Type b) { return _mm512_add_ps(a, b); }
+		static Type mul(Type a, Type b) { return _mm512_mul_ps(a, b); }
+		static Type mulAdd(Type a, Type b, Type c) { return _mm512_fmadd_ps(a, b, c); }
+	};
+
+	template <>
+	struct Vec<double>
+	{
+		using Type = __m512d;
+		using Mask = __mmask8;
+		static Mask tailMask(size_t remaining) { return remaining >= 8 ? Mask(0xFF) : Mask(0x0F); }
+		static Type load(Mask mask, const double* p) { return _mm512_maskz_loadu_pd(mask, p); }
+		static void store(double* p, Mask mask, Type v) { _mm512_mask_storeu_pd(p, mask, v); }
+		static Type broadcast(double x) { return _mm512_set1_pd(x); }
+		static Type zero() { return _mm512_setzero_pd(); }
+		static Type add(Type a, Type b) { return _mm512_add_pd(a, b); }
+		static Type mul(Type a, Type b) { return _mm512_mul_pd(a, b); }
+		static Type mulAdd(Type a, Type b, Type c) { return _mm512_fmadd_pd(a, b, c); }
+	};
+
+	template <>
+	struct Vec<int32_t>
+	{
+		using Type = __m512i;
+		using Mask = __mmask16;
+		static Mask tailMask(size_t remaining) { return remaining >= 16 ? Mask(0xFFFF) : Mask(0x00FF); }
+		static Type load(Mask mask, const int32_t* p) { return _mm512_maskz_loadu_epi32(mask, p); }
+		static void store(int32_t* p, Mask mask, Type v) { _mm512_mask_storeu_epi32(p, mask, v); }
+		static Type broadcast(int32_t x) { return _mm512_set1_epi32(x); }
+		static Type zero() { return _mm512_setzero_si512(); }
+		static Type add(Type a, Type b) { return _mm512_add_epi32(a, b); }
+		static Type mul(Type a, Type b) { return _mm512_mullo_epi32(a, b); }
+		static Type mulAdd(Type a, Type b, Type c) { return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c); }
+	};
+}
+
+// counts are padded to a multiple of 4, the last register of a row may be half full
+static inline __mmask8 countTailMask(size_t remaining)
+{
+	return remaining >= 8 ? __mmask8(0xFF) : __mmask8(0x0F);
+}
+
+template <typename T>
+static void addKernel(const T* a, const T* b, T* out, size_t count)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	for (size_t i = 0; i < count; i += LANES)
+	{
+		typename V::Mask mask = V::tailMask(count - i);
+		V::store(&out[i], mask, V::add(V::load(mask, &a[i]), V::load(mask, &b[i])));
+	}
+
+	_mm256_zeroupper();
+}
+
+template <typename T>
+static void scaleKernel(const T* src, T scalar, T* out, size_t count)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	typename V::Type scalarVec = V::broadcast(scalar);
+	for (size_t i = 0; i < count; i += LANES)
+	{
+		typename V::Mask mask = V::tailMask(count - i);
+		V::store(&out[i], mask, V::mul(V::load(mask, &src[i]), scalarVec));
+	}
+
+	_mm256_zeroupper();
+}
+
+// 4 rows x two column groups per block, the last block of an odd number of groups is masked
+template <typename T>
+static void gemmTile(size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd, size_t k,
+	const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, bool accumulate)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	for (size_t i = rowBegin; i < rowEnd; i += 4)
+	for (size_t j = colBegin; j < colEnd; j += LANES)
+	{
+		typename V::Mask mask = V::tailMask(colEnd - j);
+
+		typename V::Type c0 = V::zero();
+		typename V::Type c1 = V::zero();
+		typename V::Type c2 = V::zero();
+		typename V::Type c3 = V::zero();
+
+		for (size_t p = 0; p < k; p++)
+		{
+			typename V::Type rowRhs = V::load(mask, &b[p * ldb + j]);
+
+			c0 = V::mulAdd(V::broadcast(a[i * lda + p]), rowRhs, c0);
+			c1 = V::mulAdd(V::broadcast(a[(i + 1) * lda + p]), rowRhs, c1);
+			c2 = V::mulAdd(V::broadcast(a[(i + 2) * lda + p]), rowRhs, c2);
+			c3 = V::mulAdd(V::broadcast(a[(i + 3) * lda + p]), rowRhs, c3);
+		}
+
+		if (accumulate)
+		{
+			c0 = V::add(c0, V::load(mask, &c[i * ldc + j]));
+			c1 = V::add(c1, V::load(mask, &c[(i + 1) * ldc + j]));
+			c2 = V::add(c2, V::load(mask, &c[(i + 2) * ldc + j]));
+			c3 = V::add(c3, V::load(mask, &c[(i + 3) * ldc + j]));
+		}
+
+		V::store(&c[i * ldc + j], mask, c0);
+		V::store(&c[(i + 1) * ldc + j], mask, c1);
+		V::store(&c[(i + 2) * ldc + j], mask, c2);
+		V::store(&c[(i + 3) * ldc + j], mask, c3);
+	}
+
+	_mm256_zeroupper();
+}
+
+// byte arithmetic needs AVX-512BW, bytes stay on AVX2 registers
+static void addU8(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t count)
+{
+	for (size_t i = 0; i < count; i += 32)
+	{
+		__m256i sum = _mm256_add_epi8(_mm256_load_si256((const __m256i*)&a[i]), _mm256_load_si256((const __m256i*)&b[i]));
+		_mm256_store_si256((__m256i*)&out[i], sum);
+	}
+
+	_mm256_zeroupper();
+}
+
+// there is no byte multiply, even and odd bytes go through the 16-bit one separately
+static void scaleU8(const uint8_t* src, uint8_t scalar, uint8_t* out, size_t count)
+{
+	const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+	__m256i scalarVec = _mm256_set1_epi16(scalar);
+
+	for (size_t i = 0; i < count; i += 32)
+	{
+		__m256i vec = _mm256_load_si256((const __m256i*)&src[i]);
+		__m256i even = _mm256_and_si256(_mm256_mullo_epi16(vec, scalarVec), lowBytes);
+		__m256i odd = _mm256_slli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(vec, 8), scalarVec), 8);
+		_mm256_store_si256((__m256i*)&out[i], _mm256_or_si256(even, odd));
+	}
+
+	_mm256_zeroupper();
+}
+
+// one zmm covers a whole row of the 6x16 tile. Six accumulators alone can't hide the
+// FMA latency, so even and odd k steps go into separate sets that get summed at the end
+static void microKernelF32(size_t kc, const float* a, const float* b, float* c, size_t ldc, bool accumulate)
+{
+	__m512 even[GEMM_MR], odd[GEMM_MR];
+	for (size_t r = 0; r < GEMM_MR; r++)
+		even[r] = odd[r] = _mm512_setzero_ps();
+
+	size_t p = 0;
+	for (; p + 1 < kc; p += 2)
+	{
+		__m512 b0 = _mm512_loadu_ps(b);
+		__m512 b1 = _mm512_loadu_ps(b + GEMM_NR);
+
+		for (size_t r = 0; r < GEMM_MR; r++)
+		{
+			even[r] = _mm512_fmadd_ps(_mm512_set1_ps(a[r]), b0, even[r]);
+			odd[r] = _mm512_fmadd_ps(_mm512_set1_ps(a[GEMM_MR + r]), b1, odd[r]);
+		}
+
+		a += 2 * GEMM_MR;
+		b += 2 * GEMM_NR;
+	}
+
+	if (p < kc)
+	{
+		__m512 b0 = _mm512_loadu_ps(b);
+		for (size_t r = 0; r < GEMM_MR; r++)
+			even[r] = _mm512_fmadd_ps(_mm512_set1_ps(a[r]), b0, even[r]);
+	}
+
+	for (size_t r = 0; r < GEMM_MR; r++)
+	{
+		float* dst = &c[r * ldc];
+		__m512 sum = _mm512_add_ps(even[r], odd[r]);
+
+		if (accumulate)
+			sum = _mm512_add_ps(sum, _mm512_loadu_ps(dst));
+
+		_mm512_storeu_ps(dst, sum);
+	}
+
+	_mm256_zeroupper();
+}
+
+// scalar * vec for a scalar below 2^32 (broadcast to all lanes), overflowing lanes are flagged
+// in overflow. the product is put together from the two 32x32 -> 64 bit halves, the upper one
+// has to fit into 32 bits
+static inline __m512i multiplyCounts(__m512i scalar, __m512i vec, __mmask8& overflow)
+{
+	const __m512i highHalf = _mm512_set1_epi64(static_cast<int64_t>(0xFFFFFFFF00000000ull));
+
+	__m512i low = _mm512_mul_epu32(scalar, vec);
+	__m512i high = _mm512_mul_epu32(scalar, _mm512_srli_epi64(vec, 32));
+	overflow = _mm512_test_epi64_mask(high, highHalf);
+
+	__m512i product = _mm512_add_epi64(_mm512_slli_epi64(high, 32), low);
+	overflow |= _mm512_cmplt_epu64_mask(product, low);
+	return product;
+}
+
+static void addU64(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t count)
+{
+	const __m512i allOnes = _mm512_set1_epi64(-1);
+
+	for (size_t i = 0; i < count; i += 8)
+	{
+		__mmask8 mask = countTailMask(count - i);
+		__m512i lhs = _mm512_maskz_loadu_epi64(mask, &a[i]);
+		__m512i sum = _mm512_add_epi64(lhs, _mm512_maskz_loadu_epi64(mask, &b[i]));
+		__mmask8 overflow = _mm512_cmplt_epu64_mask(sum, lhs);
+
+		_mm512_mask_storeu_epi64(&out[i], mask, _mm512_mask_mov_epi64(sum, overflow, allOnes));
+	}
+
+	_mm256_zeroupper();
+}
+
+static void scaleU64(const uint64_t* src, uint64_t scalar, uint64_t* out, size_t count)
+{
+	if (scalar >> 32)
+	{
+		scalarKernels.u64.scale(src, scalar, out, count);
+		return;
+	}
+
+	const __m512i allOnes = _mm512_set1_epi64(-1);
+	__m512i scalarVec = _mm512_set1_epi64(static_cast<int64_t>(scalar));
+
+	for (size_t i = 0; i < count; i += 8)
+	{
+		__mmask8 mask = countTailMask(count - i);
+		__mmask8 overflow;
+		__m512i product = multiplyCounts(scalarVec, _mm512_maskz_loadu_epi64(mask, &src[i]), overflow);
+
+		_mm512_mask_storeu_epi64(&out[i], mask, _mm512_mask_mov_epi64(product, overflow, allOnes));
+	}
+
+	_mm256_zeroupper();
+}
+
+static void countAxpySaturating(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count)
+{
+	// no 64x64 bit vector multiply in AVX-512F either
+	if (scalar >> 32)
+	{
+		scalarKernels.countAxpySaturating(scalar, row, out, count);
+		return;
+	}
+
+	const __m512i allOnes = _mm512_set1_epi64(-1);
+	__m512i scalarVec = _mm512_set1_epi64(static_cast<int64_t>(scalar));
+
+	for (size_t j = 0; j < count; j += 8)
+	{
+		__mmask8 mask = countTailMask(count - j);
+		__m512i acc = _mm512_maskz_loadu_epi64(mask, &out[j]);
+
+		__mmask8 overflow;
+		__m512i product = multiplyCounts(scalarVec, _mm512_maskz_loadu_epi64(mask, &row[j]), overflow);
+
+		__m512i sum = _mm512_add_epi64(acc, product);
+		overflow |= _mm512_cmplt_epu64_mask(sum, acc);
+
+		_mm512_mask_storeu_epi64(&out[j], mask, _mm512_mask_mov_epi64(sum, overflow, allOnes));
+	}
+
+	_mm256_zeroupper();
+}
+
+static void countAxpyModular(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count, uint64_t fold)
+{
+	const __m512i zero = _mm512_setzero_si512();
+	__m512i scalarVec = _mm512_set1_epi64(static_cast<int64_t>(scalar));
+	__m512i foldVec = _mm512_set1_epi64(static_cast<int64_t>(fold));
+
+	for (size_t j = 0; j < count; j += 8)
+	{
+		__mmask8 mask = countTailMask(count - j);
+		__m512i acc = _mm512_maskz_loadu_epi64(mask, &out[j]);
+		acc = _mm512_add_epi64(acc, _mm512_mul_epu32(scalarVec, _mm512_maskz_loadu_epi64(mask, &row[j])));
+
+		// lanes that crossed 2^63 look negative
+		__mmask8 crossed = _mm512_cmplt_epi64_mask(acc, zero);
+		acc = _mm512_mask_sub_epi64(acc, crossed, acc, foldVec);
+
+		_mm512_mask_storeu_epi64(&out[j], mask, acc);
+	}
+
+	_mm256_zeroupper();
+}
+
+// eight bytes of row widened to 64 bits per step, the last step may read (not write) half past count
+static void widenAxpyU8(uint8_t scalar, const uint8_t* row, uint64_t* out, size_t count)
+{
+	__m512i scalarVec = _mm512_set1_epi64(scalar);
+
+	for (size_t j = 0; j < count; j += 8)
+	{
+		__mmask8 mask = countTailMask(count - j);
+		__m512i vec = _mm512_cvtepu8_epi64(_mm_loadl_epi64((const __m128i*)&row[j]));
+		__m512i acc = _mm512_maskz_loadu_epi64(mask, &out[j]);
+
+		_mm512_mask_storeu_epi64(&out[j], mask, _mm512_add_epi64(acc, _mm512_mul_epu32(vec, scalarVec)));
+	}
+
+	_mm256_zeroupper();
+}
+
+static void orWords(const uint64_t* src, uint64_t* dst, size_t words)
+{
+	for (size_t w = 0; w < words; w += 8)
+	{
+		__mmask8 mask = countTailMask(words - w);
+		__m512i bits = _mm512_or_si512(_mm512_maskz_loadu_epi64(mask, &dst[w]), _mm512_maskz_loadu_epi64(mask, &src[w]));
+		_mm512_mask_storeu_epi64(&dst[w], mask, bits);
+	}
+
+	_mm256_zeroupper();
+}
+
+// bit per lane of one zmm register (half of one at the end of a row), set for the nonzero ones
+static uint64_t nonZeroLanes(const float* p, size_t remaining)
+{
+	__mmask16 mask = Vec<float>::tailMask(remaining);
+	return _mm512_mask_cmp_ps_mask(mask, Vec<float>::load(mask, p), _mm512_setzero_ps(), _CMP_NEQ_UQ);
+}
+
+static uint64_t nonZeroLanes(const double* p, size_t remaining)
+{
+	__mmask8 mask = Vec<double>::tailMask(remaining);
+	return _mm512_mask_cmp_pd_mask(mask, Vec<double>::load(mask, p), _mm512_setzero_pd(), _CMP_NEQ_UQ);
+}
+
+static uint64_t nonZeroLanes(const int32_t* p, size_t remaining)
+{
+	__mmask16 mask = Vec<int32_t>::tailMask(remaining);
+	return _mm512_mask_cmpneq_epi32_mask(mask, Vec<int32_t>::load(mask, p), _mm512_setzero_si512());
+}
+
+static uint64_t nonZeroLanes(const uint64_t* p, size_t remaining)
+{
+	__mmask8 mask = countTailMask(remaining);
+	return _mm512_mask_cmpneq_epi64_mask(mask, _mm512_maskz_loadu_epi64(mask, p), _mm512_setzero_si512());
+}
+
+// bytes have no 512-bit compare without AVX-512BW, so they take two ymm registers
+static uint64_t nonZeroLanes(const uint8_t* p, size_t remaining)
+{
+	uint32_t zeroLo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), _mm256_setzero_si256())));
+	uint64_t lanes = static_cast<uint32_t>(~zeroLo);
+	if (remaining > 32)
+	{
+		uint32_t zeroHi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + 32)), _mm256_setzero_si256())));
+		lanes |= static_cast<uint64_t>(static_cast<uint32_t>(~zeroHi)) << 32;
+	}
+
+	return lanes;
+}
+
+// index of the lowest set bit of a nonzero word
+static inline size_t lowestSetBit(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return index;
+#else
+	return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+}
+
+// LANES divides 64, so a step never straddles two mask words
+template <typename T>
+static bool nonZeroMaskKernel(const T* src, uint64_t* mask, size_t count)
+{
+	constexpr size_t LANES = 64 / sizeof(T);
+	uint64_t any = 0;
+
+	for (size_t w = 0; w * 64 < count; w++)
+	{
+		uint64_t word = 0;
+		size_t end = count < w * 64 + 64 ? count : w * 64 + 64;
+		for (size_t i = w * 64; i < end; i += LANES)
+			word |= nonZeroLanes(&src[i], count - i) << (i % 64);
+
+		mask[w] = word;
+		any |= word;
+	}
+
+	_mm256_zeroupper();
+	return any != 0;
+}
+
+template <typename T>
+static size_t findNonZeroKernel(const T* src, size_t count)
+{
+	constexpr size_t LANES = 64 / sizeof(T);
+
+	for (size_t i = 0; i < count; i += LANES)
+	{
+		uint64_t lanes = nonZeroLanes(&src[i], count - i);
+		if (lanes != 0)
+		{
+			_mm256_zeroupper();
+			return i + lowestSetBit(lanes);
+		}
+	}
+
+	_mm256_zeroupper();
+	return count;
+}
+
+const KernelTable linear_algebra::kernels::avx512Kernels = {
+	Isa::AVX512,
+	{ addKernel<float>, scaleKernel<float>, nonZeroMaskKernel<float>, findNonZeroKernel<float> },
+	{ addKernel<double>, scaleKernel<double>, nonZeroMaskKernel<double>, findNonZeroKernel<double> },
+	{ addKernel<int32_t>, scaleKernel<int32_t>, nonZeroMaskKernel<int32_t>, findNonZeroKernel<int32_t> },
+	{ addU8, scaleU8, nonZeroMaskKernel<uint8_t>, findNonZeroKernel<uint8_t> },
+	{ addU64, scaleU64, nonZeroMaskKernel<uint64_t>, findNonZeroKernel<uint64_t> },
+	gemmTile<float>,
+	gemmTile<double>,
+	gemmTile<int32_t>,
+	microKernelF32,
+	countAxpySaturating,
+	countAxpyModular,
+	widenAxpyU8,
+	orWords
+};
\ No newline at end of file
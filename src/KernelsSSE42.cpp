@@ -0,0 +1,409 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+// compiled with SSE4.2 enabled and without the precompiled header (see Kernels.h)
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Kernels.h"
+
+using namespace linear_algebra::kernels;
+
+namespace
+{
+	// one xmm register, a 32-byte column group takes two of them
+	template <typename T>
+	struct Vec;
+
+	template <>
+	struct Vec<float>
+	{
+		using Type = __m128;
+		static Type load(const float* p) { return _mm_load_ps(p); }
+		static void store(float* p, Type v) { _mm_store_ps(p, v); }
+		static Type broadcast(float x) { return _mm_set1_ps(x); }
+		static Type zero() { return _mm_setzero_ps(); }
+		static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+		static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+	};
+
+	template <>
+	struct Vec<double>
+	{
+		using Type = __m128d;
+		static Type load(const double* p) { return _mm_load_pd(p); }
+		static void store(double* p, Type v) { _mm_store_pd(p, v); }
+		static Type broadcast(double x) { return _mm_set1_pd(x); }
+		static Type zero() { return _mm_setzero_pd(); }
+		static Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+		static Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+	};
+
+	template <>
+	struct Vec<int32_t>
+	{
+		using Type = __m128i;
+		static Type load(const int32_t* p) { return _mm_load_si128((const __m128i*)p); }
+		static void store(int32_t* p, Type v) { _mm_store_si128((__m128i*)p, v); }
+		static Type broadcast(int32_t x) { return _mm_set1_epi32(x); }
+		static Type zero() { return _mm_setzero_si128(); }
+		static Type add(Type a, Type b) { return _mm_add_epi32(a, b); }
+		static Type mul(Type a, Type b) { return _mm_mullo_epi32(a, b); }
+	};
+}
+
+template <typename T>
+static void addKernel(const T* a, const T* b, T* out, size_t count)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	for (size_t i = 0; i < count; i += LANES)
+		V::store(&out[i], V::add(V::load(&a[i]), V::load(&b[i])));
+}
+
+template <typename T>
+static void scaleKernel(const T* src, T scalar, T* out, size_t count)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	typename V::Type scalarVec = V::broadcast(scalar);
+	for (size_t i = 0; i < count; i += LANES)
+		V::store(&out[i], V::mul(V::load(&src[i]), scalarVec));
+}
+
+// 4 rows x one column group (two registers) per block
+template <typename T>
+static void gemmTile(size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd, size_t k,
+	const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, bool accumulate)
+{
+	using V = Vec<T>;
+	constexpr size_t LANES = sizeof(typename V::Type) / sizeof(T);
+
+	for (size_t i = rowBegin; i < rowEnd; i += 4)
+	for (size_t j = colBegin; j < colEnd; j += 2 * LANES)
+	{
+		typename V::Type acc[4][2];
+		for (size_t r = 0; r < 4; r++)
+			acc[r][0] = acc[r][1] = V::zero();
+
+		for (size_t p = 0; p < k; p++)
+		{
+			typename V::Type b0 = V::load(&b[p * ldb + j]);
+			typename V::Type b1 = V::load(&b[p * ldb + j + LANES]);
+
+			for (size_t r = 0; r < 4; r++)
+			{
+				typename V::Type av = V::broadcast(a[(i + r) * lda + p]);
+				acc[r][0] = V::add(acc[r][0], V::mul(av, b0));
+				acc[r][1] = V::add(acc[r][1], V::mul(av, b1));
+			}
+		}
+
+		for (size_t r = 0; r < 4; r++)
+		{
+			T* dst = &c[(i + r) * ldc + j];
+			if (accumulate)
+			{
+				acc[r][0] = V::add(acc[r][0], V::load(dst));
+				acc[r][1] = V::add(acc[r][1], V::load(dst + LANES));
+			}
+
+			V::store(dst, acc[r][0]);
+			V::store(dst + LANES, acc[r][1]);
+		}
+	}
+}
+
+static void addU8(const uint8_t* a, const uint8_t* b, uint8_t* out, size_t count)
+{
+	for (size_t i = 0; i < count; i += 16)
+		_mm_store_si128((__m128i*)&out[i], _mm_add_epi8(_mm_load_si128((const __m128i*)&a[i]), _mm_load_si128((const __m128i*)&b[i])));
+}
+
+// there is no byte multiply, even and odd bytes go through the 16-bit one separately
+static void scaleU8(const uint8_t* src, uint8_t scalar, uint8_t* out, size_t count)
+{
+	const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+	__m128i scalarVec = _mm_set1_epi16(scalar);
+
+	for (size_t i = 0; i < count; i += 16)
+	{
+		__m128i vec = _mm_load_si128((const __m128i*)&src[i]);
+		__m128i even = _mm_and_si128(_mm_mullo_epi16(vec, scalarVec), lowBytes);
+		__m128i odd = _mm_slli_epi16(_mm_mullo_epi16(_mm_srli_epi16(vec, 8), scalarVec), 8);
+		_mm_store_si128((__m128i*)&out[i], _mm_or_si128(even, odd));
+	}
+}
+
+// 6x16 doesn't fit into 16 xmm registers, so the tile is done as two 6x8 halves
+static void microKernelF32(size_t kc, const float* a, const float* b, float* c, size_t ldc, bool accumulate)
+{
+	for (size_t half = 0; half < GEMM_NR; half += 8)
+	{
+		__m128 acc[GEMM_MR][2];
+		for (size_t r = 0; r < GEMM_MR; r++)
+			acc[r][0] = acc[r][1] = _mm_setzero_ps();
+
+		const float* aSliver = a;
+		const float* bSliver = b + half;
+
+		for (size_t p = 0; p < kc; p++)
+		{
+			__m128 b0 = _mm_load_ps(bSliver);
+			__m128 b1 = _mm_load_ps(bSliver + 4);
+
+			for (size_t r = 0; r < GEMM_MR; r++)
+			{
+				__m128 av = _mm_load1_ps(&aSliver[r]);
+				acc[r][0] = _mm_add_ps(acc[r][0], _mm_mul_ps(av, b0));
+				acc[r][1] = _mm_add_ps(acc[r][1], _mm_mul_ps(av, b1));
+			}
+
+			aSliver += GEMM_MR;
+			bSliver += GEMM_NR;
+		}
+
+		for (size_t r = 0; r < GEMM_MR; r++)
+		{
+			float* dst = &c[r * ldc + half];
+			if (accumulate)
+			{
+				acc[r][0] = _mm_add_ps(acc[r][0], _mm_loadu_ps(dst));
+				acc[r][1] = _mm_add_ps(acc[r][1], _mm_loadu_ps(dst + 4));
+			}
+
+			_mm_storeu_ps(dst, acc[r][0]);
+			_mm_storeu_ps(dst + 4, acc[r][1]);
+		}
+	}
+}
+
+// unsigned a > b per 64-bit lane, SSE4.2 only has the signed compare
+static inline __m128i greaterThanEpu64(__m128i a, __m128i b)
+{
+	const __m128i sign = _mm_set1_epi64x(INT64_MIN);
+	return _mm_cmpgt_epi64(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+}
+
+// scalar * vec for a scalar below 2^32 (broadcast to both lanes), lanes that overflow become UINT64_MAX.
+// the product is put together from the two 32x32 -> 64 bit halves, the upper one has to fit into 32 bits
+static inline __m128i saturatingMul2(__m128i scalar, __m128i vec)
+{
+	__m128i low = _mm_mul_epu32(scalar, vec);
+	__m128i high = _mm_mul_epu32(scalar, _mm_srli_epi64(vec, 32));
+	__m128i overflow = _mm_xor_si128(_mm_cmpeq_epi64(_mm_srli_epi64(high, 32), _mm_setzero_si128()), _mm_set1_epi64x(-1));
+	__m128i product = _mm_add_epi64(_mm_slli_epi64(high, 32), low);
+	overflow = _mm_or_si128(overflow, greaterThanEpu64(low, product));
+
+	return _mm_or_si128(product, overflow);
+}
+
+// a + b, lanes that wrapped around become UINT64_MAX
+static inline __m128i saturatingAdd2(__m128i a, __m128i b)
+{
+	__m128i sum = _mm_add_epi64(a, b);
+	return _mm_or_si128(sum, greaterThanEpu64(a, sum));
+}
+
+static void addU64(const uint64_t* a, const uint64_t* b, uint64_t* out, size_t count)
+{
+	for (size_t i = 0; i < count; i += 2)
+		_mm_store_si128((__m128i*)&out[i], saturatingAdd2(_mm_load_si128((const __m128i*)&a[i]), _mm_load_si128((const __m128i*)&b[i])));
+}
+
+static void scaleU64(const uint64_t* src, uint64_t scalar, uint64_t* out, size_t count)
+{
+	if (scalar >> 32)
+	{
+		scalarKernels.u64.scale(src, scalar, out, count);
+		return;
+	}
+
+	__m128i scalarVec = _mm_set1_epi64x(static_cast<int64_t>(scalar));
+	for (size_t i = 0; i < count; i += 2)
+		_mm_store_si128((__m128i*)&out[i], saturatingMul2(scalarVec, _mm_load_si128((const __m128i*)&src[i])));
+}
+
+static void countAxpySaturating(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count)
+{
+	// no 64x64 bit vector multiply, huge scalars are rare enough to go scalar
+	if (scalar >> 32)
+	{
+		scalarKernels.countAxpySaturating(scalar, row, out, count);
+		return;
+	}
+
+	__m128i scalarVec = _mm_set1_epi64x(static_cast<int64_t>(scalar));
+
+	for (size_t j = 0; j < count; j += 2)
+	{
+		__m128i acc = _mm_load_si128((const __m128i*)&out[j]);
+		__m128i product = saturatingMul2(scalarVec, _mm_load_si128((const __m128i*)&row[j]));
+		_mm_store_si128((__m128i*)&out[j], saturatingAdd2(acc, product));
+	}
+}
+
+static void countAxpyModular(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count, uint64_t fold)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i scalarVec = _mm_set1_epi64x(static_cast<int64_t>(scalar));
+	__m128i foldVec = _mm_set1_epi64x(static_cast<int64_t>(fold));
+
+	for (size_t j = 0; j < count; j += 2)
+	{
+		__m128i acc = _mm_load_si128((const __m128i*)&out[j]);
+		acc = _mm_add_epi64(acc, _mm_mul_epu32(scalarVec, _mm_load_si128((const __m128i*)&row[j])));
+		acc = _mm_sub_epi64(acc, _mm_and_si128(_mm_cmpgt_epi64(zero, acc), foldVec));
+		_mm_store_si128((__m128i*)&out[j], acc);
+	}
+}
+
+// bytes of row widened to 64 bits, two at a time
+static void widenAxpyU8(uint8_t scalar, const uint8_t* row, uint64_t* out, size_t count)
+{
+	__m128i scalarVec = _mm_set1_epi64x(scalar);
+
+	for (size_t j = 0; j < count; j += 4)
+	{
+		__m128i bytes = _mm_loadu_si32(&row[j]);
+		__m128i lo = _mm_cvtepu8_epi64(bytes);
+		__m128i hi = _mm_cvtepu8_epi64(_mm_srli_epi32(bytes, 16));
+
+		__m128i acc0 = _mm_load_si128((const __m128i*)&out[j]);
+		__m128i acc1 = _mm_load_si128((const __m128i*)&out[j + 2]);
+		_mm_store_si128((__m128i*)&out[j], _mm_add_epi64(acc0, _mm_mul_epu32(lo, scalarVec)));
+		_mm_store_si128((__m128i*)&out[j + 2], _mm_add_epi64(acc1, _mm_mul_epu32(hi, scalarVec)));
+	}
+}
+
+static void orWords(const uint64_t* src, uint64_t* dst, size_t words)
+{
+	for (size_t w = 0; w < words; w += 4)
+	{
+		__m128i lo = _mm_or_si128(_mm_loadu_si128((const __m128i*)&dst[w]), _mm_loadu_si128((const __m128i*)&src[w]));
+		__m128i hi = _mm_or_si128(_mm_loadu_si128((const __m128i*)&dst[w + 2]), _mm_loadu_si128((const __m128i*)&src[w + 2]));
+		_mm_storeu_si128((__m128i*)&dst[w], lo);
+		_mm_storeu_si128((__m128i*)&dst[w + 2], hi);
+	}
+}
+
+// bit per lane of one xmm register, set for the nonzero ones
+static uint64_t nonZeroLanes(const float* p)
+{
+	return static_cast<uint64_t>(_mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(p), _mm_setzero_ps())));
+}
+
+static uint64_t nonZeroLanes(const double* p)
+{
+	return static_cast<uint64_t>(_mm_movemask_pd(_mm_cmpneq_pd(_mm_loadu_pd(p), _mm_setzero_pd())));
+}
+
+static uint64_t nonZeroLanes(const int32_t* p)
+{
+	__m128i zero = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)p), _mm_setzero_si128());
+	return ~static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(zero))) & 0xF;
+}
+
+static uint64_t nonZeroLanes(const uint8_t* p)
+{
+	__m128i zero = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), _mm_setzero_si128());
+	return ~static_cast<uint64_t>(_mm_movemask_epi8(zero)) & 0xFFFF;
+}
+
+static uint64_t nonZeroLanes(const uint64_t* p)
+{
+	__m128i zero = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)p), _mm_setzero_si128());
+	return ~static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(zero))) & 0x3;
+}
+
+// index of the lowest set bit of a nonzero word
+static inline size_t lowestSetBit(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return index;
+#else
+	return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+}
+
+// LANES divides 64, so a step never straddles two mask words
+template <typename T>
+static bool nonZeroMaskKernel(const T* src, uint64_t* mask, size_t count)
+{
+	constexpr size_t LANES = 16 / sizeof(T);
+	uint64_t any = 0;
+
+	for (size_t w = 0; w * 64 < count; w++)
+	{
+		uint64_t word = 0;
+		size_t end = count < w * 64 + 64 ? count : w * 64 + 64;
+		for (size_t i = w * 64; i < end; i += LANES)
+			word |= nonZeroLanes(&src[i]) << (i % 64);
+
+		mask[w] = word;
+		any |= word;
+	}
+
+	return any != 0;
+}
+
+template <typename T>
+static size_t findNonZeroKernel(const T* src, size_t count)
+{
+	constexpr size_t LANES = 16 / sizeof(T);
+
+	for (size_t i = 0; i < count; i += LANES)
+	{
+		uint64_t lanes = nonZeroLanes(&src[i]);
+		if (lanes != 0)
+		{
+			return i + lowestSetBit(lanes);
+		}
+	}
+
+	return count;
+}
+
+const KernelTable linear_algebra::kernels::sse42Kernels = {
+	Isa::SSE42,
+	{ addKernel<float>, scaleKernel<float>, nonZeroMaskKernel<float>, findNonZeroKernel<float> },
+	{ addKernel<double>, scaleKernel<double>, nonZeroMaskKernel<double>, findNonZeroKernel<double> },
+	{ addKernel<int32_t>, scaleKernel<int32_t>, nonZeroMaskKernel<int32_t>, findNonZeroKernel<int32_t> },
+	{ addU8, scaleU8, nonZeroMaskKernel<uint8_t>, findNonZeroKernel<uint8_t> },
+	{ addU64, scaleU64, nonZeroMaskKernel<uint64_t>, findNonZeroKernel<uint64_t> },
+	gemmTile<float>,
+	gemmTile<double>,
+	gemmTile<int32_t>,
+	microKernelF32,
+	countAxpySaturating,
+	countAxpyModular,
+	widenAxpyU8,
+	orWords
+};
\ No newline at end of file
@@ -0,0 +1,191 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Kernels.h"
+#include "CountArithmetic.h"
+
+using namespace linear_algebra;
+using namespace linear_algebra::kernels;
+
+// plain loops, the compiler vectorizes what it can for the baseline target.
+// int32 is computed unsigned, so overflowing products wrap instead of being UB
+template <typename T>
+struct WrappingOf { using type = T; };
+
+template <>
+struct WrappingOf<int32_t> { using type = uint32_t; };
+
+template <typename T>
+using Wrapping = typename WrappingOf<T>::type;
+
+template <typename T>
+static void addKernel(const T* a, const T* b, T* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if constexpr (std::is_same_v<T, uint64_t>)
+			out[i] = saturatingAdd(a[i], b[i]);
+		else
+			out[i] = static_cast<T>(static_cast<Wrapping<T>>(a[i]) + static_cast<Wrapping<T>>(b[i]));
+	}
+}
+
+template <typename T>
+static void scaleKernel(const T* src, T scalar, T* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if constexpr (std::is_same_v<T, uint64_t>)
+			out[i] = saturatingMul(src[i], scalar);
+		else
+			out[i] = static_cast<T>(static_cast<Wrapping<T>>(src[i]) * static_cast<Wrapping<T>>(scalar));
+	}
+}
+
+template <typename T>
+static void gemmTile(size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd, size_t k,
+	const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, bool accumulate)
+{
+	constexpr size_t GROUP = 32 / sizeof(T);
+
+	for (size_t i = rowBegin; i < rowEnd; i += 4)
+	for (size_t j = colBegin; j < colEnd; j += GROUP)
+	{
+		Wrapping<T> acc[4][GROUP] = {};
+
+		for (size_t p = 0; p < k; p++)
+		{
+			const T* rowRhs = &b[p * ldb + j];
+			for (size_t r = 0; r < 4; r++)
+			{
+				Wrapping<T> scalar = a[(i + r) * lda + p];
+				for (size_t col = 0; col < GROUP; col++)
+					acc[r][col] += scalar * static_cast<Wrapping<T>>(rowRhs[col]);
+			}
+		}
+
+		for (size_t r = 0; r < 4; r++)
+		for (size_t col = 0; col < GROUP; col++)
+		{
+			T& dst = c[(i + r) * ldc + j + col];
+			dst = accumulate ? static_cast<T>(static_cast<Wrapping<T>>(dst) + acc[r][col]) : static_cast<T>(acc[r][col]);
+		}
+	}
+}
+
+static void microKernelF32(size_t kc, const float* a, const float* b, float* c, size_t ldc, bool accumulate)
+{
+	float acc[GEMM_MR][GEMM_NR] = {};
+
+	for (size_t p = 0; p < kc; p++)
+	{
+		for (size_t r = 0; r < GEMM_MR; r++)
+		for (size_t col = 0; col < GEMM_NR; col++)
+			acc[r][col] += a[r] * b[col];
+
+		a += GEMM_MR;
+		b += GEMM_NR;
+	}
+
+	for (size_t r = 0; r < GEMM_MR; r++)
+	for (size_t col = 0; col < GEMM_NR; col++)
+	{
+		float& dst = c[r * ldc + col];
+		dst = accumulate ? dst + acc[r][col] : acc[r][col];
+	}
+}
+
+static void countAxpySaturating(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count)
+{
+	detail::SaturatingOps ops;
+	for (size_t j = 0; j < count; j++)
+		out[j] = ops.mulAdd(out[j], scalar, row[j]);
+}
+
+static void countAxpyModular(uint64_t scalar, const uint64_t* row, uint64_t* out, size_t count, uint64_t fold)
+{
+	for (size_t j = 0; j < count; j++)
+	{
+		uint64_t acc = out[j] + scalar * row[j];
+		out[j] = (acc >> 63) ? acc - fold : acc;
+	}
+}
+
+static void widenAxpyU8(uint8_t scalar, const uint8_t* row, uint64_t* out, size_t count)
+{
+	for (size_t j = 0; j < count; j++)
+		out[j] += static_cast<uint64_t>(scalar) * row[j];
+}
+
+static void orWords(const uint64_t* src, uint64_t* dst, size_t words)
+{
+	for (size_t w = 0; w < words; w++)
+		dst[w] |= src[w];
+}
+
+template <typename T>
+static bool nonZeroMaskKernel(const T* src, uint64_t* mask, size_t count)
+{
+	uint64_t any = 0;
+
+	for (size_t w = 0; w * 64 < count; w++)
+	{
+		uint64_t word = 0;
+		size_t end = std::min(count, w * 64 + 64);
+		for (size_t i = w * 64; i < end; i++)
+			word |= static_cast<uint64_t>(src[i] != T(0)) << (i % 64);
+
+		mask[w] = word;
+		any |= word;
+	}
+
+	return any != 0;
+}
+
+template <typename T>
+static size_t findNonZeroKernel(const T* src, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (src[i] != T(0))
+			return i;
+	}
+
+	return count;
+}
+
+const KernelTable linear_algebra::kernels::scalarKernels = {
+	Isa::Scalar,
+	{ addKernel<float>, scaleKernel<float>, nonZeroMaskKernel<float>, findNonZeroKernel<float> },
+	{ addKernel<double>, scaleKernel<double>, nonZeroMaskKernel<double>, findNonZeroKernel<double> },
+	{ addKernel<int32_t>, scaleKernel<int32_t>, nonZeroMaskKernel<int32_t>, findNonZeroKernel<int32_t> },
+	{ addKernel<uint8_t>, scaleKernel<uint8_t>, nonZeroMaskKernel<uint8_t>, findNonZeroKernel<uint8_t> },
+	{ addKernel<uint64_t>, scaleKernel<uint64_t>, nonZeroMaskKernel<uint64_t>, findNonZeroKernel<uint64_t> },
+	gemmTile<float>,
+	gemmTile<double>,
+	gemmTile<int32_t>,
+	microKernelF32,
+	countAxpySaturating,
+	countAxpyModular,
+	widenAxpyU8,
+	orWords
+};
\ No newline at end of file
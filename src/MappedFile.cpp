@@ -0,0 +1,79 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "MappedFile.h"
+
+using namespace graph;
+
+std::shared_ptr<const MappedFile> MappedFile::Open(const std::string& path)
+{
+	std::shared_ptr<MappedFile> file(new MappedFile());
+
+#if defined(__unix__) || defined(__APPLE__)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error("Couldn't open " + path);
+
+	struct stat info;
+	if (fstat(fd, &info) != 0)
+	{
+		close(fd);
+		throw std::runtime_error("Couldn't open " + path);
+	}
+
+	file->m_size = static_cast<size_t>(info.st_size);
+	if (file->m_size > 0)
+	{
+		void* ptr = mmap(nullptr, file->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		if (ptr == MAP_FAILED)
+			throw std::runtime_error("Couldn't map " + path);
+
+		file->m_data = static_cast<const std::byte*>(ptr);
+		file->m_mapped = true;
+	}
+	else
+		close(fd);
+#else
+	std::ifstream stream(path, std::ios::binary | std::ios::ate);
+	if (!stream)
+		throw std::runtime_error("Couldn't open " + path);
+
+	file->m_copy.resize(static_cast<size_t>(stream.tellg()));
+	stream.seekg(0);
+	stream.read(reinterpret_cast<char*>(file->m_copy.data()), file->m_copy.size());
+
+	file->m_data = file->m_copy.data();
+	file->m_size = file->m_copy.size();
+#endif
+
+	return file;
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	if (m_mapped)
+		munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+}
\ No newline at end of file
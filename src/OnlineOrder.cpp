@@ -0,0 +1,86 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "OnlineOrder.h"
+
+using namespace graph;
+
+OnlineTopologicalOrder::OnlineTopologicalOrder(std::vector<Vertex> order)
+	: m_order(std::move(order)), m_position(m_order.size())
+{
+	for (uint32_t i = 0; i < m_order.size(); i++)
+		m_position[m_order[i]] = i;
+}
+
+// the vertices to reaches inside the affected stretch [position of to, position of from] have to
+// end up after from. They move behind all the other vertices of the stretch, both groups
+// keeping their relative order, which breaks no edge: everything a moved vertex leads to
+// inside the stretch gets moved as well
+std::vector<Vertex> OnlineTopologicalOrder::insertEdge(const CSRGraph& graph, Vertex from, Vertex to)
+{
+	if (from == to)
+		return { from };
+
+	uint32_t lower = m_position[to];
+	uint32_t upper = m_position[from];
+	if (lower > upper)
+		return {};
+
+	// depth first search, the parents lead back to to once it reaches from
+	std::unordered_map<Vertex, Vertex> parent;
+	parent.emplace(to, to);
+
+	std::vector<Vertex> stack = { to };
+	while (!stack.empty())
+	{
+		Vertex v = stack.back();
+		stack.pop_back();
+
+		for (Vertex w : graph.successors(v))
+		{
+			if (w == from)
+			{
+				// to -> ... -> v -> from, closed by the new edge
+				std::vector<Vertex> cycle = { from };
+				for (Vertex u = v; u != to; u = parent[u])
+					cycle.push_back(u);
+
+				cycle.push_back(to);
+				std::reverse(cycle.begin(), cycle.end());
+				return cycle;
+			}
+
+			// edges lead forward in the order, so only the upper bound needs checking
+			if (m_position[w] < upper && parent.emplace(w, v).second)
+				stack.push_back(w);
+		}
+	}
+
+	auto stretchBegin = m_order.begin() + lower;
+	auto stretchEnd = m_order.begin() + upper + 1;
+	std::stable_partition(stretchBegin, stretchEnd, [&](Vertex v) { return !parent.contains(v); });
+
+	for (uint32_t i = lower; i <= upper; i++)
+		m_position[m_order[i]] = i;
+
+	return {};
+}
\ No newline at end of file
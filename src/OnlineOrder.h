@@ -0,0 +1,53 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "CSRGraph.h"
+
+namespace graph
+{
+	// Topological order of an acyclic graph kept up to date while edges get added, so acyclicity
+	// never has to be checked from scratch. Pearce-Kelly style: an edge that agrees with the order
+	// costs nothing, any other one only reorders the stretch of the order between its endpoints.
+	// Only successors are searched (the Marchetti-Spaccamela variant), so no reverse graph is needed.
+	// Removing an edge never invalidates the order
+	class OnlineTopologicalOrder
+	{
+	public:
+		OnlineTopologicalOrder() = default;
+
+		// order has to be a topological order of the graph the edges will be added to
+		explicit OnlineTopologicalOrder(std::vector<Vertex> order);
+
+		// graph has to hold the new edge already. Returns nothing when the order was restored,
+		// or the cycle the edge closed (from the order's point of view the edge never came)
+		std::vector<Vertex> insertEdge(const CSRGraph& graph, Vertex from, Vertex to);
+
+		const std::vector<Vertex>& order() const { return m_order; }
+		uint32_t position(Vertex v) const { return m_position[v]; }
+
+	private:
+		std::vector<Vertex> m_order;
+		std::vector<uint32_t> m_position;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+namespace linear_algebra
+{
+	inline constexpr size_t DEFAULT_POWER_CACHE_BUDGET = 512ull << 20;
+
+	// Least recently used cache of matrix powers keyed by their exponent, holding at most
+	// getBudget() bytes (as reported on insertion). Entries are shared, so evicting one
+	// never invalidates a power somebody is still using
+	template <typename Value>
+	class PowerCache
+	{
+	public:
+		explicit PowerCache(size_t budget = DEFAULT_POWER_CACHE_BUDGET)
+			: m_budget(budget), m_bytes(0)
+		{ }
+
+		// the power of exactly this exponent, marked as the most recently used
+		std::shared_ptr<const Value> find(uint64_t exponent)
+		{
+			auto it = m_entries.find(exponent);
+			if (it == m_entries.end())
+				return nullptr;
+
+			touch(it->second);
+			return it->second.value;
+		}
+
+		// the power with the largest exponent in [1, exponent], marked as the most recently used
+		std::shared_ptr<const Value> findBelow(uint64_t exponent, uint64_t& found)
+		{
+			auto it = m_entries.upper_bound(exponent);
+			if (it == m_entries.begin() || std::prev(it)->first == 0)
+				return nullptr;
+
+			--it;
+			found = it->first;
+			touch(it->second);
+			return it->second.value;
+		}
+
+		// powers bigger than the whole budget are not kept at all
+		void insert(uint64_t exponent, std::shared_ptr<const Value> value, size_t bytes)
+		{
+			erase(exponent);
+			if (bytes > m_budget)
+				return;
+
+			m_order.push_front(exponent);
+			m_entries.emplace(exponent, Entry{ std::move(value), bytes, m_order.begin() });
+			m_bytes += bytes;
+			evict();
+		}
+
+		void erase(uint64_t exponent)
+		{
+			auto it = m_entries.find(exponent);
+			if (it == m_entries.end())
+				return;
+
+			m_bytes -= it->second.bytes;
+			m_order.erase(it->second.position);
+			m_entries.erase(it);
+		}
+
+		// exponents of every cached power, in increasing order
+		std::vector<uint64_t> exponents() const
+		{
+			std::vector<uint64_t> result;
+			result.reserve(m_entries.size());
+			for (const auto& [exponent, entry] : m_entries)
+				result.push_back(exponent);
+
+			return result;
+		}
+
+		void clear()
+		{
+			m_entries.clear();
+			m_order.clear();
+			m_bytes = 0;
+		}
+
+		void setBudget(size_t budget)
+		{
+			m_budget = budget;
+			evict();
+		}
+
+		size_t getBudget() const { return m_budget; }
+		size_t getBytes() const { return m_bytes; }
+		size_t getEntryCount() const { return m_entries.size(); }
+
+	private:
+		struct Entry
+		{
+			std::shared_ptr<const Value> value;
+			size_t bytes;
+			std::list<uint64_t>::iterator position;
+		};
+
+		void touch(Entry& entry)
+		{
+			m_order.splice(m_order.begin(), m_order, entry.position);
+		}
+
+		void evict()
+		{
+			while (m_bytes > m_budget)
+				erase(m_order.back());
+		}
+
+	private:
+		size_t m_budget;
+		size_t m_bytes;
+
+		// most recently used first
+		std::list<uint64_t> m_order;
+		std::map<uint64_t, Entry> m_entries;
+	};
+}
\ No newline at end of file
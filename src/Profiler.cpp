@@ -0,0 +1,248 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Profiler.h"
+#include "BufferPool.h"
+#include <chrono>
+
+using namespace profiling;
+
+static const char* const COUNTER_NAMES[] = { "matrix bytes allocated", "matrix multiplies", "flops" };
+static_assert(std::size(COUNTER_NAMES) == static_cast<size_t>(Counter::Count));
+
+const char* profiling::counterName(Counter counter)
+{
+	return COUNTER_NAMES[static_cast<size_t>(counter)];
+}
+
+#ifdef DIGRAPH_PROFILING
+
+using Clock = std::chrono::steady_clock;
+
+// the trace keeps this many scopes, the summary counts all of them
+static constexpr size_t MAX_TRACE_EVENTS = 1ull << 20;
+
+namespace
+{
+	struct Event
+	{
+		const char* name;
+		uint32_t thread;
+		uint64_t start, duration;
+	};
+
+	struct Phase
+	{
+		uint64_t calls = 0;
+		uint64_t total = 0;
+		uint64_t self = 0;	// without the phases inside it
+	};
+
+	struct Recorder
+	{
+		std::mutex mutex;
+		Clock::time_point origin = Clock::now();
+		std::vector<Event> events;
+		size_t droppedEvents = 0;
+
+		// by text, the same literal may have a different address in every unit
+		std::map<std::string_view, Phase> phases;
+		std::atomic<uint64_t> counters[static_cast<size_t>(Counter::Count)] = {};
+		std::atomic<uint32_t> threadCount{ 0 };
+	};
+
+	Recorder& recorder()
+	{
+		static Recorder instance;
+		return instance;
+	}
+
+	// time of the finished scopes directly inside every open scope of this thread, innermost last
+	thread_local std::vector<uint64_t> t_childTime;
+	thread_local uint32_t t_thread = std::numeric_limits<uint32_t>::max();
+}
+
+std::atomic<bool> profiling::detail::g_recording{ false };
+
+uint64_t profiling::detail::now()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - recorder().origin).count());
+}
+
+void profiling::detail::enter()
+{
+	t_childTime.push_back(0);
+}
+
+void profiling::detail::leave(const char* name, uint64_t start)
+{
+	uint64_t duration = now() - start;
+	uint64_t children = t_childTime.back();
+	t_childTime.pop_back();
+
+	if (!t_childTime.empty())
+		t_childTime.back() += duration;
+
+	Recorder& rec = recorder();
+	if (t_thread == std::numeric_limits<uint32_t>::max())
+		t_thread = rec.threadCount++;
+
+	std::lock_guard lock(rec.mutex);
+	Phase& phase = rec.phases[name];
+	phase.calls++;
+	phase.total += duration;
+	phase.self += duration - std::min(children, duration);
+
+	if (rec.events.size() < MAX_TRACE_EVENTS)
+		rec.events.push_back({ name, t_thread, start, duration });
+	else
+		rec.droppedEvents++;
+}
+
+void profiling::detail::count(Counter counter, uint64_t amount)
+{
+	recorder().counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+bool profiling::isAvailable()
+{
+	return true;
+}
+
+void profiling::start()
+{
+	Recorder& rec = recorder();
+	{
+		std::lock_guard lock(rec.mutex);
+		rec.events.clear();
+		rec.droppedEvents = 0;
+		rec.phases.clear();
+		rec.origin = Clock::now();
+	}
+
+	for (std::atomic<uint64_t>& counter : rec.counters)
+		counter.store(0, std::memory_order_relaxed);
+
+	linear_algebra::BufferPool::Global().resetStats();
+	detail::g_recording.store(true, std::memory_order_relaxed);
+}
+
+void profiling::stop()
+{
+	detail::g_recording.store(false, std::memory_order_relaxed);
+}
+
+std::string profiling::summary()
+{
+	Recorder& rec = recorder();
+	std::string text;
+
+	std::vector<std::pair<std::string_view, Phase>> phases;
+	{
+		std::lock_guard lock(rec.mutex);
+		phases.assign(rec.phases.begin(), rec.phases.end());
+	}
+
+	std::sort(phases.begin(), phases.end(), [](const auto& lhs, const auto& rhs) { return lhs.second.total > rhs.second.total; });
+
+	auto out = std::back_inserter(text);
+	fmt::format_to(out, "{:<32} {:>10} {:>14} {:>14}\n", "phase", "calls", "total ms", "self ms");
+	for (const auto& [name, phase] : phases)
+	{
+		fmt::format_to(out, "{:<32} {:>10} {:>14.3f} {:>14.3f}\n", name.substr(0, 32), phase.calls,
+			static_cast<double>(phase.total) / 1e6, static_cast<double>(phase.self) / 1e6);
+	}
+
+	text.push_back('\n');
+	for (size_t c = 0; c < static_cast<size_t>(Counter::Count); c++)
+		fmt::format_to(out, "{:<32} {:>20}\n", COUNTER_NAMES[c], rec.counters[c].load(std::memory_order_relaxed));
+
+	linear_algebra::BufferPoolStats pool = linear_algebra::BufferPool::Global().stats();
+	fmt::format_to(out, "{:<32} {:>20} ({} reused, {} from the system)\n", "matrix buffers",
+		pool.allocations, pool.poolHits, pool.systemAllocations);
+	fmt::format_to(out, "{:<32} {:>20}\n", "peak resident matrix bytes", pool.peakBytesInUse);
+
+	return text;
+}
+
+void profiling::writeChromeTrace(const std::string& path)
+{
+	std::ofstream file(path);
+	if (!file)
+		throw std::runtime_error(fmt::format("Couldn't create {}", path));
+
+	Recorder& rec = recorder();
+	uint64_t end = detail::now();
+	std::string text = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+	auto out = std::back_inserter(text);
+
+	std::lock_guard lock(rec.mutex);
+	for (const Event& event : rec.events)
+	{
+		// names are literals of ours, nothing in them needs escaping
+		fmt::format_to(out, "{{\"name\": \"{}\", \"cat\": \"digraph\", \"ph\": \"X\", \"pid\": 0, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}},\n",
+			event.name, event.thread, static_cast<double>(event.start) / 1e3, static_cast<double>(event.duration) / 1e3);
+
+		if (text.size() >= (1u << 20))
+		{
+			file << text;
+			text.clear();
+		}
+	}
+
+	// the counters once, at the end of the trace
+	fmt::format_to(out, "{{\"name\": \"counters\", \"ph\": \"C\", \"pid\": 0, \"tid\": 0, \"ts\": {:.3f}, \"args\": {{", static_cast<double>(end) / 1e3);
+	for (size_t c = 0; c < static_cast<size_t>(Counter::Count); c++)
+		fmt::format_to(out, "{}\"{}\": {}", c ? ", " : "", COUNTER_NAMES[c], rec.counters[c].load(std::memory_order_relaxed));
+
+	fmt::format_to(out, "}}}}\n], \"otherData\": {{\"droppedEvents\": {}, \"peakResidentMatrixBytes\": {}}}}}\n",
+		rec.droppedEvents, linear_algebra::BufferPool::Global().stats().peakBytesInUse);
+
+	file << text;
+	if (!file)
+		throw std::runtime_error(fmt::format("Couldn't write {}", path));
+}
+
+#else
+
+bool profiling::isAvailable()
+{
+	return false;
+}
+
+void profiling::start()
+{ }
+
+void profiling::stop()
+{ }
+
+std::string profiling::summary()
+{
+	return {};
+}
+
+void profiling::writeChromeTrace([[maybe_unused]] const std::string& path)
+{
+	throw std::runtime_error("This build has no profiler, configure it with DIGRAPH_PROFILING on");
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,109 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+// Scoped timers and counters of the hot paths, switched on at runtime with profiling::start.
+// Builds without DIGRAPH_PROFILING (the CMake option of the same name) turn every
+// DIGRAPH_PROFILE_SCOPE and DIGRAPH_PROFILE_COUNT into nothing at all
+namespace profiling
+{
+	enum class Counter
+	{
+		BytesAllocated,	// matrix buffers handed out by the buffer pool
+		Multiplies,		// matrix products, dense and sparse
+		Flops,			// arithmetic of dense products (2 per multiply-add, padding included), sums and scaling
+		Count
+	};
+
+	const char* counterName(Counter counter);
+
+	// whether this build has the profiler
+	bool isAvailable();
+
+	// clears everything recorded so far (and the buffer pool statistics) and starts recording
+	void start();
+
+	// stops recording, what was recorded stays for summary and writeChromeTrace
+	void stop();
+
+	// time spent in every phase, nested ones counted in their parents as well, and the counters
+	std::string summary();
+
+	// Chrome trace event JSON (chrome://tracing, Perfetto) of every timed scope.
+	// Throws std::runtime_error when the file can't be written
+	void writeChromeTrace(const std::string& path);
+
+#ifdef DIGRAPH_PROFILING
+	namespace detail
+	{
+		extern std::atomic<bool> g_recording;
+
+		// nanoseconds since the profiler started
+		uint64_t now();
+		void enter();
+		void leave(const char* name, uint64_t start);
+		void count(Counter counter, uint64_t amount);
+	}
+
+	inline bool isRecording() { return detail::g_recording.load(std::memory_order_relaxed); }
+
+	// times the rest of the enclosing scope under a name, which has to outlive the profiler (a literal)
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(const char* name)
+			: m_name(isRecording() ? name : nullptr), m_start(0)
+		{
+			if (m_name)
+			{
+				detail::enter();
+				m_start = detail::now();
+			}
+		}
+
+		~ScopedTimer()
+		{
+			if (m_name)
+				detail::leave(m_name, m_start);
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		const char* m_name;
+		uint64_t m_start;
+	};
+#endif
+}
+
+#ifdef DIGRAPH_PROFILING
+#define DIGRAPH_PROFILE_JOIN_(a, b) a##b
+#define DIGRAPH_PROFILE_JOIN(a, b) DIGRAPH_PROFILE_JOIN_(a, b)
+#define DIGRAPH_PROFILE_SCOPE(name) ::profiling::ScopedTimer DIGRAPH_PROFILE_JOIN(profileScope, __LINE__)(name)
+#define DIGRAPH_PROFILE_COUNT(counter, amount) \
+	do { if (::profiling::isRecording()) ::profiling::detail::count(::profiling::Counter::counter, (amount)); } while (false)
+#else
+#define DIGRAPH_PROFILE_SCOPE(name) ((void)0)
+#define DIGRAPH_PROFILE_COUNT(counter, amount) ((void)0)
+#endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "Reachability.h"
+#include "Components.h"
+#include "ThreadPool.h"
+#include "Kernels.h"
+#include "Profiler.h"
+
+using namespace graph;
+
+// row passes over smaller closures (counted in words) stay on the calling thread
+static constexpr size_t PARALLEL_WARSHALL_MIN_WORDS = 1ull << 18;
+static constexpr size_t WARSHALL_ROWS_PER_TASK = 256;
+
+// bigger graphs get their closure through the condensation
+static constexpr size_t WARSHALL_MAX_VERTICES = 4096;
+
+ReachabilityIndex::ReachabilityIndex()
+	: m_vertexCount(0), m_wordsPerRow(0)
+{ }
+
+ReachabilityIndex ReachabilityIndex::FromArrays(size_t vertexCount, std::span<const uint64_t> bits, std::shared_ptr<const void> storage)
+{
+	if (vertexCount > std::numeric_limits<Vertex>::max())
+		throw std::invalid_argument("Invalid argument: Too many vertices");
+
+	if (bits.size() != vertexCount * WordsPerRow(vertexCount))
+		throw std::invalid_argument("Invalid argument: Bits don't hold a row for every vertex");
+
+	ReachabilityIndex index;
+	index.m_storage = std::move(storage);
+	index.m_bits = bits;
+	index.m_vertexCount = vertexCount;
+	index.m_wordsPerRow = WordsPerRow(vertexCount);
+	return index;
+}
+
+ReachabilityIndex ReachabilityIndex::Build(const CSRGraph& graph)
+{
+	DIGRAPH_PROFILE_SCOPE("reachability index");
+
+	if (graph.getVertexCount() <= WARSHALL_MAX_VERTICES)
+		return BuildWarshall(graph);
+
+	return BuildCondensed(graph);
+}
+
+// starts from the adjacency rows, then for every pivot k each row that reaches k
+// gets row k ORed into it. Row k itself doesn't change during its own pass
+ReachabilityIndex ReachabilityIndex::BuildWarshall(const CSRGraph& graph)
+{
+	size_t n = graph.getVertexCount();
+	size_t wordsPerRow = WordsPerRow(n);
+
+	auto storage = std::make_shared<std::vector<uint64_t>>(n * wordsPerRow, 0);
+	uint64_t* bits = storage->data();
+
+	for (Vertex v = 0; v < n; v++)
+	{
+		for (Vertex w : graph.successors(v))
+			bits[v * wordsPerRow + w / 64] |= 1ull << (w % 64);
+	}
+
+	const linear_algebra::kernels::KernelTable& kernelTable = linear_algebra::kernels::active();
+	bool parallel = n * wordsPerRow >= PARALLEL_WARSHALL_MIN_WORDS;
+
+	for (size_t k = 0; k < n; k++)
+	{
+		// row k holds at least the successors of k, a sink has nothing to pass on
+		if (graph.successors(static_cast<Vertex>(k)).empty())
+			continue;
+
+		const uint64_t* pivot = &bits[k * wordsPerRow];
+		size_t pivotWord = k / 64;
+		uint64_t pivotMask = 1ull << (k % 64);
+
+		linear_algebra::forEachRowBlock(n, WARSHALL_ROWS_PER_TASK, parallel, [&](size_t rowBegin, size_t rowEnd)
+		{
+			for (size_t i = rowBegin; i < rowEnd; i++)
+			{
+				uint64_t* row = &bits[i * wordsPerRow];
+				if (i != k && (row[pivotWord] & pivotMask))
+					kernelTable.orWords(pivot, row, wordsPerRow);
+			}
+		});
+	}
+
+	std::span<const uint64_t> view(*storage);
+	return FromArrays(n, view, std::move(storage));
+}
+
+// components come sinks first, so the rows of all the successors of a component are complete
+// by the time it is reached. The row of a component is built in the row of its first member
+// and then copied to the others
+ReachabilityIndex ReachabilityIndex::BuildCondensed(const CSRGraph& graph)
+{
+	size_t n = graph.getVertexCount();
+	size_t wordsPerRow = WordsPerRow(n);
+
+	StronglyConnectedComponents components = stronglyConnectedComponents(graph);
+	CSRGraph dag = condensation(graph, components);
+
+	auto storage = std::make_shared<std::vector<uint64_t>>(n * wordsPerRow, 0);
+	uint64_t* bits = storage->data();
+
+	const linear_algebra::kernels::KernelTable& kernelTable = linear_algebra::kernels::active();
+
+	for (uint32_t c = 0; c < components.getComponentCount(); c++)
+	{
+		std::span<const Vertex> members = components.componentMembers(c);
+		uint64_t* row = &bits[members.front() * wordsPerRow];
+
+		// the row of an acyclic successor lacks the successor itself
+		for (Vertex d : dag.successors(c))
+		{
+			Vertex other = components.componentMembers(d).front();
+			kernelTable.orWords(&bits[other * wordsPerRow], row, wordsPerRow);
+			row[other / 64] |= 1ull << (other % 64);
+		}
+
+		if (components.cyclic[c])
+		{
+			for (Vertex v : members)
+				row[v / 64] |= 1ull << (v % 64);
+		}
+
+		for (Vertex v : members.subspan(1))
+			std::memcpy(&bits[v * wordsPerRow], row, wordsPerRow * sizeof(uint64_t));
+	}
+
+	std::span<const uint64_t> view(*storage);
+	return FromArrays(n, view, std::move(storage));
+}
+
+ReachabilityIndex ReachabilityIndex::withEdge(Vertex from, Vertex to) const
+{
+	if (from >= m_vertexCount || to >= m_vertexCount)
+		throw std::out_of_range("Edge endpoint out of range");
+
+	if (reaches(from, to))
+		return *this;
+
+	auto storage = std::make_shared<std::vector<uint64_t>>(m_bits.begin(), m_bits.end());
+	uint64_t* bits = storage->data();
+
+	// walks over the new edge can only go on the way walks from to go, once they are at to
+	std::vector<uint64_t> gain(m_bits.begin() + to * m_wordsPerRow, m_bits.begin() + (to + 1) * m_wordsPerRow);
+	gain[to / 64] |= 1ull << (to % 64);
+
+	const linear_algebra::kernels::KernelTable& kernelTable = linear_algebra::kernels::active();
+
+	for (Vertex v = 0; v < m_vertexCount; v++)
+	{
+		if (v == from || reaches(v, from))
+			kernelTable.orWords(gain.data(), &bits[v * m_wordsPerRow], m_wordsPerRow);
+	}
+
+	std::span<const uint64_t> view(*storage);
+	return FromArrays(m_vertexCount, view, std::move(storage));
+}
\ No newline at end of file
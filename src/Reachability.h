@@ -0,0 +1,76 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "CSRGraph.h"
+
+namespace graph
+{
+	// Transitive closure of a graph: bit (u, v) is set when a walk of at least one step leads
+	// from u to v, so a vertex reaches itself only through a cycle. Every row is wordsPerRow
+	// 64-bit words, padded to a multiple of 256 bits like BitMatrix rows. Immutable and shared
+	// between copies the same way as the arrays of a CSRGraph
+	class ReachabilityIndex
+	{
+	public:
+		ReachabilityIndex();
+
+		// BuildWarshall for small graphs, BuildCondensed for the rest
+		static ReachabilityIndex Build(const CSRGraph& graph);
+
+		// bit-parallel Warshall over the adjacency rows, at most V^3 / 64 word ORs
+		static ReachabilityIndex BuildWarshall(const CSRGraph& graph);
+
+		// rows of the strongly connected components, each the OR of the rows of the components it
+		// has edges to, in one pass over the condensation. A row OR per condensation edge, so big
+		// cycles (which Warshall goes around over and over) cost next to nothing
+		static ReachabilityIndex BuildCondensed(const CSRGraph& graph);
+
+		// views the rows of vertexCount vertices without copying them, storage owns their memory
+		static ReachabilityIndex FromArrays(size_t vertexCount, std::span<const uint64_t> bits, std::shared_ptr<const void> storage);
+
+		// the index after adding the edge from -> to: from and every vertex reaching it gain to and
+		// everything to reaches, one row OR each. Shares the rows when from reaches to already
+		ReachabilityIndex withEdge(Vertex from, Vertex to) const;
+
+		static size_t WordsPerRow(size_t vertexCount) { return (vertexCount + 255) / 256 * 4; }
+
+		size_t getVertexCount() const { return m_vertexCount; }
+		size_t getWordsPerRow() const { return m_wordsPerRow; }
+
+		bool reaches(Vertex from, Vertex to) const
+		{
+			return (m_bits[from * m_wordsPerRow + to / 64] >> (to % 64)) & 1;
+		}
+
+		// bits of every vertex reachable from v
+		std::span<const uint64_t> row(Vertex v) const { return m_bits.subspan(v * m_wordsPerRow, m_wordsPerRow); }
+		std::span<const uint64_t> bits() const { return m_bits; }
+
+	private:
+		std::shared_ptr<const void> m_storage;
+		std::span<const uint64_t> m_bits;
+		size_t m_vertexCount;
+		size_t m_wordsPerRow;
+	};
+}
\ No newline at end of file
@@ -21,87 +21,143 @@
 //	SOFTWARE.
 
 #include "SIMDMatrix.h"
+#include "AlignedAlloc.h"
+#include "BufferPool.h"
+#include "ThreadPool.h"
+#include "Kernels.h"
+#include "Profiler.h"
+#include "Strassen.h"
 
-static void* alloc_aligned(size_t size, size_t alignment)
-{
-	size_t safeSize = (size + alignment - 1) & ~(alignment - 1);
+using namespace linear_algebra;
+using kernels::GEMM_MR;
+using kernels::GEMM_NR;
+
+// smaller products (counted in multiply-adds) stay on the calling thread
+static constexpr size_t PARALLEL_GEMM_MIN_WORK = 128ull * 128ull * 128ull;
+// smaller element-wise operations (counted in elements) stay on the calling thread
+static constexpr size_t PARALLEL_ELEMENTWISE_MIN_SIZE = 1ull << 18;
+static constexpr size_t ELEMENTWISE_ROWS_PER_TASK = 32;
+static constexpr size_t WIDENING_ROWS_PER_TASK = 16;
+
+static std::atomic<size_t> s_strassenCutoff{ DEFAULT_STRASSEN_CUTOFF };
 
-#ifdef _MSC_VER
-	return _aligned_malloc(safeSize, alignment);
-#else
-	return std::aligned_alloc(alignment, safeSize);
-#endif
+void linear_algebra::setStrassenCutoff(size_t cutoff)
+{
+	s_strassenCutoff.store(cutoff, std::memory_order_relaxed);
 }
 
-static void free_aligned(void* ptr)
+size_t linear_algebra::getStrassenCutoff()
 {
-#ifdef _WIN32
-	_aligned_free(ptr);
-#else
-	std::free(ptr);
-#endif
+	return s_strassenCutoff.load(std::memory_order_relaxed);
 }
 
-using namespace linear_algebra;
+template <typename T>
+static const kernels::ElementwiseKernels<T>& elementwiseKernels(const kernels::KernelTable& table)
+{
+	if constexpr (std::is_same_v<T, float>)
+		return table.f32;
+	else if constexpr (std::is_same_v<T, double>)
+		return table.f64;
+	else if constexpr (std::is_same_v<T, int32_t>)
+		return table.i32;
+	else if constexpr (std::is_same_v<T, uint8_t>)
+		return table.u8;
+	else
+		return table.u64;
+}
 
-static constexpr size_t SIMD_ALIGNMENT = 32ull;
+template <typename T>
+static kernels::GemmTileKernel<T> gemmTileKernel(const kernels::KernelTable& table)
+{
+	if constexpr (std::is_same_v<T, float>)
+		return table.gemmTileF32;
+	else if constexpr (std::is_same_v<T, double>)
+		return table.gemmTileF64;
+	else
+		return table.gemmTileI32;
+}
 
-SIMDMatrix::SIMDMatrix(size_t rc)
+template <MatrixElement T>
+BasicSIMDMatrix<T>::BasicSIMDMatrix(size_t rc)
 	: m_rows(rc), m_cols(rc)
 {
-	initialize();
+	initialize(true);
+}
+
+template <MatrixElement T>
+BasicSIMDMatrix<T>::BasicSIMDMatrix(size_t rows, size_t cols)
+	: m_rows(rows), m_cols(cols)
+{
+	initialize(true);
 }
 
-SIMDMatrix::SIMDMatrix(size_t rows, size_t cols)
+template <MatrixElement T>
+BasicSIMDMatrix<T>::BasicSIMDMatrix(size_t rows, size_t cols, Uninitialized_t)
 	: m_rows(rows), m_cols(cols)
 {
-	initialize();
+	initialize(false);
 }
 
-void SIMDMatrix::initialize()
+template <MatrixElement T>
+void BasicSIMDMatrix<T>::initialize(bool zeroFill)
 {
-	// rows aligned to 4 and cols aligned to 8
-	m_stride = (m_cols + 7) & ~7;
+	// rows aligned to 4 and cols aligned to a whole column group
+	m_stride = (m_cols + COLUMN_GROUP - 1) / COLUMN_GROUP * COLUMN_GROUP;
 	m_strideRow = (m_rows + 3) & ~3;
 
-	size_t bytes = m_strideRow * m_stride * sizeof(float);
-	m_data = (float*)alloc_aligned(bytes, SIMD_ALIGNMENT);
+	size_t bytes = bufferBytes();
+	m_data = (T*)BufferPool::Global().allocate(bytes);
 
-	if (!m_data)
-		throw std::bad_alloc();
+	if (zeroFill)
+	{
+		std::memset(m_data, 0, bytes);
+		return;
+	}
+
+	// a recycled block holds leftovers, only the padding has to be cleaned up
+	if (m_cols != m_stride)
+	{
+		for (size_t i = 0; i < m_rows; i++)
+			std::memset(&m_data[i * m_stride + m_cols], 0, (m_stride - m_cols) * sizeof(T));
+	}
 
-	std::memset(m_data, 0, bytes);
+	if (m_rows != m_strideRow)
+		std::memset(&m_data[m_rows * m_stride], 0, (m_strideRow - m_rows) * m_stride * sizeof(T));
 }
 
-SIMDMatrix::~SIMDMatrix()
+template <MatrixElement T>
+BasicSIMDMatrix<T>::~BasicSIMDMatrix()
 {
 	if (!m_data)
 		return;
 
-	free_aligned(m_data);
+	BufferPool::Global().release(m_data, bufferBytes());
 	m_data = nullptr;
 }
 
-SIMDMatrix::SIMDMatrix(const SIMDMatrix& other)
+template <MatrixElement T>
+BasicSIMDMatrix<T>::BasicSIMDMatrix(const BasicSIMDMatrix& other)
 	: m_rows(other.m_rows), m_cols(other.m_cols), m_stride(other.m_stride), m_strideRow(other.m_strideRow)
 {
-	size_t bytes = m_strideRow * m_stride * sizeof(float);
-	m_data = (float*)alloc_aligned(bytes, SIMD_ALIGNMENT);
+	size_t bytes = bufferBytes();
+	m_data = (T*)BufferPool::Global().allocate(bytes);
 	std::memcpy(m_data, other.m_data, bytes);
 }
 
-SIMDMatrix& SIMDMatrix::operator=(const SIMDMatrix& other)
+template <MatrixElement T>
+BasicSIMDMatrix<T>& BasicSIMDMatrix<T>::operator=(const BasicSIMDMatrix& other)
 {
 	if (this == &other)
 		return *this;
 
-	size_t neededBytes = other.m_strideRow * other.m_stride * sizeof(float);
-	size_t currentBytes = m_strideRow * m_stride * sizeof(float);
+	size_t neededBytes = other.bufferBytes();
+	size_t currentBytes = bufferBytes();
 
 	if (neededBytes != currentBytes)
 	{
-		free_aligned(m_data);
-		m_data = (float*)alloc_aligned(neededBytes, SIMD_ALIGNMENT);
+		BufferPool::Global().release(m_data, currentBytes);
+		m_data = nullptr;
+		m_data = (T*)BufferPool::Global().allocate(neededBytes);
 	}
 
 	m_rows = other.m_rows;
@@ -113,7 +169,8 @@ SIMDMatrix& SIMDMatrix::operator=(const SIMDMatrix& other)
 	return *this;
 }
 
-SIMDMatrix::SIMDMatrix(SIMDMatrix&& other) noexcept
+template <MatrixElement T>
+BasicSIMDMatrix<T>::BasicSIMDMatrix(BasicSIMDMatrix&& other) noexcept
 	: m_rows(other.m_rows),
 	m_cols(other.m_cols),
 	m_stride(other.m_stride),
@@ -127,12 +184,13 @@ SIMDMatrix::SIMDMatrix(SIMDMatrix&& other) noexcept
 	other.m_strideRow = 0;
 }
 
-SIMDMatrix& SIMDMatrix::operator=(SIMDMatrix&& other) noexcept
+template <MatrixElement T>
+BasicSIMDMatrix<T>& BasicSIMDMatrix<T>::operator=(BasicSIMDMatrix&& other) noexcept
 {
 	if (this == &other)
 		return *this;
 
-	free_aligned(m_data);
+	BufferPool::Global().release(m_data, bufferBytes());
 	m_data = other.m_data;
 	m_rows = other.m_rows;
 	m_cols = other.m_cols;
@@ -143,52 +201,92 @@ SIMDMatrix& SIMDMatrix::operator=(SIMDMatrix&& other) noexcept
 	other.m_rows = 0;
 	other.m_cols = 0;
 	other.m_stride = 0;
+	other.m_strideRow = 0;
 	return *this;
 }
 
-bool SIMDMatrix::isZero() const
+template <MatrixElement T>
+bool BasicSIMDMatrix<T>::isZero() const
+{
+	// padding is always zero, so the whole buffer can be tested, stopping at the first nonzero
+	size_t size = m_strideRow * m_stride;
+	return elementwiseKernels<T>(kernels::active()).findNonZero(m_data, size) == size;
+}
+
+template <MatrixElement T>
+bool BasicSIMDMatrix<T>::nonZeroMask(size_t row, uint64_t* mask) const
+{
+	if (row >= m_rows)
+		throw std::out_of_range("Matrix index out of bounds");
+
+	return elementwiseKernels<T>(kernels::active()).nonZeroMask(&m_data[row * m_stride], mask, m_stride);
+}
+
+template <MatrixElement T>
+bool BasicSIMDMatrix<T>::anySaturated() const requires std::is_same_v<T, uint64_t>
 {
 	for (size_t i = 0; i < m_rows; i++)
 	for (size_t j = 0; j < m_cols; j++)
 	{
-		if (get(i, j) != 0)
-			return false;
+		if (m_data[i * m_stride + j] == COUNT_SATURATED)
+			return true;
 	}
 
-	return true;
+	return false;
+}
+
+template <MatrixElement T>
+BasicSIMDMatrix<T> BasicSIMDMatrix<T>::operator+(const BasicSIMDMatrix& other) const
+{
+	BasicSIMDMatrix mat(m_rows, m_cols, Uninitialized);
+	addInto(*this, other, mat);
+	return mat;
 }
 
-SIMDMatrix SIMDMatrix::operator+(const SIMDMatrix& other)
+template <MatrixElement T>
+void linear_algebra::addInto(const BasicSIMDMatrix<T>& lhs, const BasicSIMDMatrix<T>& rhs, BasicSIMDMatrix<T>& out)
 {
-	if (m_rows != other.m_rows || m_cols != other.m_cols)
+	if (lhs.m_rows != rhs.m_rows || lhs.m_cols != rhs.m_cols)
 		throw std::runtime_error("Attempting to add 2 different matrices");
 
-	assert(m_stride == other.m_stride);
-	assert((m_stride * sizeof(float)) % SIMD_ALIGNMENT == 0);
+	assert(lhs.m_stride == rhs.m_stride);
+	assert((lhs.m_stride * sizeof(T)) % SIMD_ALIGNMENT == 0);
 
-	SIMDMatrix mat(m_rows, m_cols);
+	if (out.m_rows != lhs.m_rows || out.m_cols != lhs.m_cols)
+		out = BasicSIMDMatrix<T>(lhs.m_rows, lhs.m_cols, Uninitialized);
 
-	for (size_t i = 0; i < m_rows; i++)
+	const kernels::ElementwiseKernels<T>& kernelTable = elementwiseKernels<T>(kernels::active());
+	size_t stride = lhs.m_stride;
+	DIGRAPH_PROFILE_COUNT(Flops, lhs.m_rows * stride);
+
+	bool parallel = lhs.m_rows * stride >= PARALLEL_ELEMENTWISE_MIN_SIZE;
+	forEachRowBlock(lhs.m_rows, ELEMENTWISE_ROWS_PER_TASK, parallel, [&](size_t rowBegin, size_t rowEnd)
 	{
-		for (size_t j = 0; j < m_stride; j+=8)
-		{
-			size_t ix = i * m_stride + j;
-			const float* inA = &m_data[ix];
-			const float* inB = &other.m_data[ix];
-			float* out = &mat.m_data[ix];
+		size_t ix = rowBegin * stride;
+		kernelTable.add(&lhs.m_data[ix], &rhs.m_data[ix], &out.m_data[ix], (rowEnd - rowBegin) * stride);
+	});
+}
 
-			__m256 vecA = _mm256_load_ps(inA);
-			__m256 vecB = _mm256_load_ps(inB);
-			__m256 vecRes = _mm256_add_ps(vecA, vecB);
+template <MatrixElement T>
+void linear_algebra::scaleInto(const BasicSIMDMatrix<T>& src, T scalar, BasicSIMDMatrix<T>& out)
+{
+	if (out.m_rows != src.m_rows || out.m_cols != src.m_cols)
+		out = BasicSIMDMatrix<T>(src.m_rows, src.m_cols, Uninitialized);
 
-			_mm256_store_ps(out, vecRes);
-		}
-	}
+	const kernels::ElementwiseKernels<T>& kernelTable = elementwiseKernels<T>(kernels::active());
+	size_t stride = src.m_stride;
+	DIGRAPH_PROFILE_COUNT(Flops, src.m_rows * stride);
 
-	return mat;
+	bool parallel = src.m_rows * stride >= PARALLEL_ELEMENTWISE_MIN_SIZE;
+	forEachRowBlock(src.m_rows, ELEMENTWISE_ROWS_PER_TASK, parallel, [&](size_t rowBegin, size_t rowEnd)
+	{
+		size_t ix = rowBegin * stride;
+		kernelTable.scale(&src.m_data[ix], scalar, &out.m_data[ix], (rowEnd - rowBegin) * stride);
+	});
 }
 
-float SIMDMatrix::get(size_t row, size_t col) const
+template <MatrixElement T>
+T BasicSIMDMatrix<T>::get(size_t row, size_t col) const
 {
 	if (row >= m_rows || col >= m_cols) {
 		throw std::out_of_range("Matrix index out of bounds");
@@ -197,7 +295,8 @@ float SIMDMatrix::get(size_t row, size_t col) const
 	return m_data[row * m_stride + col];
 }
 
-void SIMDMatrix::set(size_t row, size_t col, float value)
+template <MatrixElement T>
+void BasicSIMDMatrix<T>::set(size_t row, size_t col, T value)
 {
 	if (row >= m_rows || col >= m_cols)
 		throw std::out_of_range("Matrix index out of bounds");
@@ -205,72 +304,522 @@ void SIMDMatrix::set(size_t row, size_t col, float value)
 	m_data[row * m_stride + col] = value;
 }
 
-SIMDMatrix SIMDMatrix::Identity(size_t size)
+template <MatrixElement T>
+BasicSIMDMatrix<T> BasicSIMDMatrix<T>::Identity(size_t size)
 {
-	SIMDMatrix mat(size);
+	BasicSIMDMatrix mat(size);
 	
 	size_t limit = std::min(mat.m_rows, mat.m_cols);
 	for (size_t i = 0; i < limit; i++)
-		mat.m_data[i * mat.m_stride + i] = 1.0f;
+		mat.m_data[i * mat.m_stride + i] = T(1);
 
 	return mat;
 }
 
-SIMDMatrix linear_algebra::operator*(const SIMDMatrix& lhs, const SIMDMatrix& rhs)
+// output tile handed to a single task by the parallel simple kernel
+static constexpr size_t SIMPLE_TILE_ROWS = 32;
+static constexpr size_t SIMPLE_TILE_COLS = 256;
+
+// 4 x column group register blocks (see KernelTable::gemmTileF32) over the whole of c. every
+// cell including the padding gets written, padding stays zero because the padding of
+// both operands is zero
+template <typename T>
+static void gemmSimple(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, bool accumulate, bool parallel)
 {
-	if (lhs.m_cols != rhs.m_rows)
-		throw std::invalid_argument("Invalid argument: Multiplied matrix column count must be equal to the row count of matrix multiplied by");
+	auto gemmSimpleTile = gemmTileKernel<T>(kernels::active());
+	size_t rowTiles = (m + SIMPLE_TILE_ROWS - 1) / SIMPLE_TILE_ROWS;
+	size_t colTiles = (n + SIMPLE_TILE_COLS - 1) / SIMPLE_TILE_COLS;
+
+	if (!parallel || rowTiles * colTiles < 2)
+	{
+		gemmSimpleTile(0, m, 0, n, k, a, lda, b, ldb, c, ldc, accumulate);
+		return;
+	}
+
+	ThreadPool::Global().parallelFor(rowTiles * colTiles, [&](size_t tile)
+	{
+		size_t rowBegin = (tile / colTiles) * SIMPLE_TILE_ROWS;
+		size_t colBegin = (tile % colTiles) * SIMPLE_TILE_COLS;
+
+		gemmSimpleTile(rowBegin, std::min(m, rowBegin + SIMPLE_TILE_ROWS), colBegin, std::min(n, colBegin + SIMPLE_TILE_COLS),
+			k, a, lda, b, ldb, c, ldc, accumulate);
+	});
+}
+
+// blocking for the packed kernel. a KC x NR sliver of B (16 KB) stays in L1,
+// the MC x KC block of A (96 KB) in L2 and the KC x NC panel of B (2 MB) in L3
+static constexpr size_t GEMM_MC = 96;
+static constexpr size_t GEMM_KC = 256;
+static constexpr size_t GEMM_NC = 2048;
+
+// per-thread packing buffer, allocated on first use and reused afterwards
+template <size_t Count>
+struct PackBuffer
+{
+	float* data;
+
+	PackBuffer()
+	{
+		data = (float*)alloc_aligned(Count * sizeof(float), SIMD_ALIGNMENT);
+		if (!data)
+			throw std::bad_alloc();
+	}
+
+	~PackBuffer()
+	{
+		free_aligned(data);
+	}
+};
+
+static float* threadPackBufferA()
+{
+	thread_local PackBuffer<GEMM_MC * GEMM_KC> buffer;
+	return buffer.data;
+}
+
+static float* threadPackBufferB()
+{
+	thread_local PackBuffer<GEMM_KC * GEMM_NC> buffer;
+	return buffer.data;
+}
+
+// packs rows [0, mc) x cols [0, kc) of a into MR-row slivers laid out column by column,
+// rows past m are zero filled so the micro kernel never needs a row tail
+static void packA(size_t mc, size_t kc, size_t m, const float* a, size_t lda, float* packed)
+{
+	for (size_t i = 0; i < mc; i += GEMM_MR)
+	{
+		for (size_t p = 0; p < kc; p++)
+		for (size_t r = 0; r < GEMM_MR; r++)
+			*packed++ = (i + r < m) ? a[(i + r) * lda + p] : 0.0f;
+	}
+}
+
+// packs rows [0, kc) x cols [0, nc) of b into NR-column slivers laid out row by row,
+// columns past n are zero filled
+static void packB(size_t kc, size_t nc, size_t n, const float* b, size_t ldb, float* packed)
+{
+	for (size_t j = 0; j < nc; j += GEMM_NR)
+	{
+		size_t width = std::min(GEMM_NR, n - j);
+		for (size_t p = 0; p < kc; p++)
+		{
+			const float* src = &b[p * ldb + j];
+			if (width == GEMM_NR)
+				std::memcpy(packed, src, GEMM_NR * sizeof(float));
+			else
+			{
+				for (size_t c = 0; c < GEMM_NR; c++)
+					packed[c] = c < width ? src[c] : 0.0f;
+			}
+
+			packed += GEMM_NR;
+		}
+	}
+}
+
+// B slivers packed by a single task of the parallel packed kernel
+static constexpr size_t PACK_B_SLIVERS_PER_TASK = 8;
+
+// c[0..mc) (+)= packed A block * packed B panel, mc and nc being the valid extent of c
+static void gemmPackedBlock(size_t mc, size_t nc, size_t kc, const float* packedA, const float* packedB, float* c, size_t ldc, bool accumulate)
+{
+	alignas(SIMD_ALIGNMENT) float edge[GEMM_MR * GEMM_NR];
+	auto microKernel = kernels::active().microKernelF32;
+
+	for (size_t jr = 0; jr < nc; jr += GEMM_NR)
+	for (size_t ir = 0; ir < mc; ir += GEMM_MR)
+	{
+		const float* aSliver = &packedA[ir * kc];
+		const float* bSliver = &packedB[jr * kc];
+		float* dst = &c[ir * ldc + jr];
+
+		size_t mr = std::min(GEMM_MR, mc - ir);
+		size_t nr = std::min(GEMM_NR, nc - jr);
+
+		if (mr == GEMM_MR && nr == GEMM_NR)
+		{
+			microKernel(kc, aSliver, bSliver, dst, ldc, accumulate);
+			continue;
+		}
+
+		// tile sticks out of c, compute it aside and copy back the valid part
+		microKernel(kc, aSliver, bSliver, edge, GEMM_NR, false);
+		for (size_t r = 0; r < mr; r++)
+		for (size_t col = 0; col < nr; col++)
+		{
+			float& out = dst[r * ldc + col];
+			out = accumulate ? out + edge[r * GEMM_NR + col] : edge[r * GEMM_NR + col];
+		}
+	}
+}
+
+// only rows [0, m) of c are written, the padding rows are left as they are (zero).
+// when running in parallel the B panel is packed cooperatively and every task then
+// packs and multiplies its own block of A rows against it
+static void gemmPacked(size_t m, size_t n, size_t k, const float* a, size_t lda, const float* b, size_t ldb, float* c, size_t ldc, bool accumulate, bool parallel)
+{
+	if (k == 0)
+	{
+		if (accumulate)
+			return;
+
+		for (size_t i = 0; i < m; i++)
+			std::memset(&c[i * ldc], 0, n * sizeof(float));
+		return;
+	}
+
+	ThreadPool& pool = ThreadPool::Global();
+	parallel = parallel && pool.getThreadCount() > 1;
+
+	// with few rows per thread, shrink the A blocks so every thread gets some of them
+	size_t mcStep = GEMM_MC;
+	if (parallel)
+	{
+		size_t wanted = pool.getThreadCount() * 2;
+		size_t rowsPerBlock = (m + wanted - 1) / wanted;
+		rowsPerBlock = (rowsPerBlock + GEMM_MR - 1) / GEMM_MR * GEMM_MR;
+		mcStep = std::clamp(rowsPerBlock, GEMM_MR, GEMM_MC);
+	}
 
-	SIMDMatrix result(lhs.m_rows, rhs.m_cols);
+	size_t rowBlocks = (m + mcStep - 1) / mcStep;
+	float* packedB = threadPackBufferB();
 
-	for (size_t i = 0; i < result.m_rows; i += 4)
-		for (size_t j = 0; j < result.m_stride; j += 8)
+	for (size_t jc = 0; jc < n; jc += GEMM_NC)
+	{
+		size_t nc = std::min(GEMM_NC, n - jc);
+		size_t slivers = (nc + GEMM_NR - 1) / GEMM_NR;
+
+		for (size_t pc = 0; pc < k; pc += GEMM_KC)
 		{
-			__m256 c0 = _mm256_setzero_ps();
-			__m256 c1 = _mm256_setzero_ps();
-			__m256 c2 = _mm256_setzero_ps();
-			__m256 c3 = _mm256_setzero_ps();
+			size_t kc = std::min(GEMM_KC, k - pc);
+			bool accumulatePanel = accumulate || pc != 0;
+			const float* bPanel = &b[pc * ldb + jc];
 
-			for (size_t k = 0; k < lhs.m_cols; k++)
+			auto packSlivers = [&](size_t task)
 			{
-				__m256 rowRhs = _mm256_load_ps(&rhs.m_data[k * rhs.m_stride + j]);
+				size_t first = task * PACK_B_SLIVERS_PER_TASK;
+				size_t last = std::min(slivers, first + PACK_B_SLIVERS_PER_TASK);
+				size_t col = first * GEMM_NR;
+				size_t width = std::min(nc, last * GEMM_NR) - col;
 
-				__m256 a0 = _mm256_set1_ps(lhs.m_data[i * lhs.m_stride + k]);
-				c0 = _mm256_fmadd_ps(a0, rowRhs, c0);
+				packB(kc, (last - first) * GEMM_NR, width, &bPanel[col], ldb, &packedB[col * kc]);
+			};
 
-				__m256 a1 = _mm256_set1_ps(lhs.m_data[(i + 1) * lhs.m_stride + k]);
-				c1 = _mm256_fmadd_ps(a1, rowRhs, c1);
+			auto multiplyRowBlock = [&](size_t block)
+			{
+				size_t ic = block * mcStep;
+				size_t mc = std::min(mcStep, m - ic);
+				size_t mcPadded = (mc + GEMM_MR - 1) / GEMM_MR * GEMM_MR;
+				float* packedA = threadPackBufferA();
 
-				__m256 a2 = _mm256_set1_ps(lhs.m_data[(i + 2) * lhs.m_stride + k]);
-				c2 = _mm256_fmadd_ps(a2, rowRhs, c2);
+				packA(mcPadded, kc, mc, &a[ic * lda + pc], lda, packedA);
+				gemmPackedBlock(mc, nc, kc, packedA, packedB, &c[ic * ldc + jc], ldc, accumulatePanel);
+			};
 
-				__m256 a3 = _mm256_set1_ps(lhs.m_data[(i + 3) * lhs.m_stride + k]);
-				c3 = _mm256_fmadd_ps(a3, rowRhs, c3);
+			size_t packTasks = (slivers + PACK_B_SLIVERS_PER_TASK - 1) / PACK_B_SLIVERS_PER_TASK;
+			if (parallel)
+			{
+				pool.parallelFor(packTasks, packSlivers);
+				pool.parallelFor(rowBlocks, multiplyRowBlock);
 			}
+			else
+			{
+				for (size_t task = 0; task < packTasks; task++)
+					packSlivers(task);
+				for (size_t block = 0; block < rowBlocks; block++)
+					multiplyRowBlock(block);
+			}
+		}
+	}
+}
+
+// out (+)= lhs * rhs for byte matrices, rows of rhs are widened to 64 bits on the fly
+// (see KernelTable::widenAxpyU8) and zero entries of lhs are skipped
+static void widenRows(size_t rowBegin, size_t rowEnd, size_t n, size_t k, const uint8_t* a, size_t lda,
+	const uint8_t* b, size_t ldb, uint64_t* c, size_t ldc, bool accumulate)
+{
+	auto widenAxpy = kernels::active().widenAxpyU8;
 
-			_mm256_store_ps(&result.m_data[i * result.m_stride + j], c0);
-			_mm256_store_ps(&result.m_data[(i + 1) * result.m_stride + j], c1);
-			_mm256_store_ps(&result.m_data[(i + 2) * result.m_stride + j], c2);
-			_mm256_store_ps(&result.m_data[(i + 3) * result.m_stride + j], c3);
+	for (size_t i = rowBegin; i < rowEnd; i++)
+	{
+		uint64_t* out = &c[i * ldc];
+		if (!accumulate)
+			std::memset(out, 0, n * sizeof(uint64_t));
+
+		for (size_t p = 0; p < k; p++)
+		{
+			uint8_t scalar = a[i * lda + p];
+			if (scalar != 0)
+				widenAxpy(scalar, &b[p * ldb], out, n);
 		}
+	}
+}
 
-	_mm256_zeroupper();
-	return result;
+static void checkProductOperands(size_t lhsCols, size_t rhsRows, const void* out, const void* lhs, const void* rhs)
+{
+	if (lhsCols != rhsRows)
+		throw std::invalid_argument("Invalid argument: Multiplied matrix column count must be equal to the row count of matrix multiplied by");
+
+	if (out == lhs || out == rhs)
+		throw std::invalid_argument("Invalid argument: Output matrix cannot be one of the operands");
+}
+
+// out (+)= lhs * rhs, out already has the right shape. uint64_t never gets here (see CountMatrix.cpp)
+template <MatrixElement T>
+static void multiplyProduct(const T* a, size_t lda, const T* b, size_t ldb, typename ProductOf<T>::type* c, size_t ldc,
+	size_t m, size_t n, size_t k, size_t smallest, GemmKernel kernel, bool accumulate)
+{
+	DIGRAPH_PROFILE_SCOPE("gemm");
+	DIGRAPH_PROFILE_COUNT(Multiplies, 1);
+	DIGRAPH_PROFILE_COUNT(Flops, 2 * m * n * k);
+
+	bool parallel = m * n * k >= PARALLEL_GEMM_MIN_WORK;
+
+	if constexpr (std::is_same_v<T, uint8_t>)
+	{
+		forEachRowBlock(m, WIDENING_ROWS_PER_TASK, parallel, [&](size_t rowBegin, size_t rowEnd)
+		{
+			widenRows(rowBegin, rowEnd, n, k, a, lda, b, ldb, c, ldc, accumulate);
+		});
+	}
+	else
+	{
+		// the packed kernel only exists for floats, the other types always take the simple one
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (kernel == GemmKernel::Auto || kernel == GemmKernel::Strassen)
+				kernel = smallest >= PACKED_GEMM_THRESHOLD ? GemmKernel::Packed : GemmKernel::Simple;
+
+			if (kernel == GemmKernel::Packed)
+			{
+				gemmPacked(m, n, k, a, lda, b, ldb, c, ldc, accumulate, parallel);
+				return;
+			}
+		}
+
+		gemmSimple(m, n, k, a, lda, b, ldb, c, ldc, accumulate, parallel);
+	}
 }
 
-SIMDMatrix linear_algebra::pow(const SIMDMatrix& mat, uint64_t pow)
+// the arithmetic of Strassen-Winograd over typed matrices, integers wrap like the GEMM kernels do
+template <MatrixElement T>
+struct TypedStrassenOps
+{
+	static constexpr size_t GROUP = BasicSIMDMatrix<T>::COLUMN_GROUP;
+	using Wrapping = std::conditional_t<std::is_same_v<T, int32_t>, uint32_t, T>;
+
+	void multiply(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, bool accumulate) const
+	{
+		multiplyProduct<T>(a, lda, b, ldb, c, ldc, m, n, k, std::min({ m, n, k }), GemmKernel::Auto, accumulate);
+	}
+
+	void add(size_t rows, size_t cols, const T* a, size_t lda, const T* b, size_t ldb, T* out, size_t ldo) const
+	{
+		for (size_t i = 0; i < rows; i++)
+		for (size_t j = 0; j < cols; j++)
+			out[i * ldo + j] = static_cast<T>(static_cast<Wrapping>(a[i * lda + j]) + static_cast<Wrapping>(b[i * ldb + j]));
+	}
+
+	void sub(size_t rows, size_t cols, const T* a, size_t lda, const T* b, size_t ldb, T* out, size_t ldo) const
+	{
+		for (size_t i = 0; i < rows; i++)
+		for (size_t j = 0; j < cols; j++)
+			out[i * ldo + j] = static_cast<T>(static_cast<Wrapping>(a[i * lda + j]) - static_cast<Wrapping>(b[i * ldb + j]));
+	}
+};
+
+template <MatrixElement T>
+static bool usesStrassen(GemmKernel kernel, size_t smallest)
+{
+	if (kernel == GemmKernel::Strassen)
+		return true;
+
+	size_t cutoff = getStrassenCutoff();
+	return kernel == GemmKernel::Auto && std::is_same_v<T, int32_t> && cutoff != 0 && smallest >= cutoff;
+}
+
+template <MatrixElement T>
+void linear_algebra::multiplyInto(const BasicSIMDMatrix<T>& lhs, const BasicSIMDMatrix<T>& rhs, ProductMatrix<T>& out, GemmKernel kernel)
+{
+	if constexpr (std::is_same_v<T, uint64_t>)
+	{
+		// counts always saturate, see the CountArithmetic overload
+		multiplyInto(lhs, rhs, out, CountArithmetic{});
+	}
+	else
+	{
+		checkProductOperands(lhs.m_cols, rhs.m_rows, &out, &lhs, &rhs);
+
+		if (out.m_rows != lhs.m_rows || out.m_cols != rhs.m_cols)
+			out = ProductMatrix<T>(lhs.m_rows, rhs.m_cols, Uninitialized);
+
+		size_t smallest = std::min({ lhs.m_rows, lhs.m_cols, rhs.m_cols });
+		// byte products widen into another type, so they stay classic
+		if constexpr (std::is_same_v<ProductMatrix<T>, BasicSIMDMatrix<T>>)
+		{
+			if (usesStrassen<T>(kernel, smallest))
+			{
+				DIGRAPH_PROFILE_SCOPE("strassen");
+
+				// over the padded shape: zero rows and columns multiply into zero padding
+				size_t cutoff = getStrassenCutoff() ? getStrassenCutoff() : DEFAULT_STRASSEN_CUTOFF;
+				TypedStrassenOps<T> ops;
+				detail::StrassenWinograd<T, TypedStrassenOps<T>>(ops, cutoff).multiply(out.m_strideRow, out.m_stride,
+					(lhs.m_cols + 3) & ~size_t(3), lhs.m_data, lhs.m_stride, rhs.m_data, rhs.m_stride, out.m_data, out.m_stride);
+				return;
+			}
+		}
+
+		multiplyProduct<T>(lhs.m_data, lhs.m_stride, rhs.m_data, rhs.m_stride, out.m_data, out.m_stride,
+			out.m_rows, out.m_stride, lhs.m_cols, smallest, kernel, false);
+	}
+}
+
+template <MatrixElement T>
+void linear_algebra::multiplyAddInto(const BasicSIMDMatrix<T>& lhs, const BasicSIMDMatrix<T>& rhs, ProductMatrix<T>& out, GemmKernel kernel)
+{
+	if constexpr (std::is_same_v<T, uint64_t>)
+	{
+		multiplyAddInto(lhs, rhs, out, CountArithmetic{});
+	}
+	else
+	{
+		checkProductOperands(lhs.m_cols, rhs.m_rows, &out, &lhs, &rhs);
+
+		if (out.m_rows != lhs.m_rows || out.m_cols != rhs.m_cols)
+			throw std::invalid_argument("Invalid argument: Accumulator must have the shape of the product");
+
+		size_t smallest = std::min({ lhs.m_rows, lhs.m_cols, rhs.m_cols });
+		multiplyProduct<T>(lhs.m_data, lhs.m_stride, rhs.m_data, rhs.m_stride, out.m_data, out.m_stride,
+			out.m_rows, out.m_stride, lhs.m_cols, smallest, kernel, true);
+	}
+}
+
+// rows of *this multiplied a block at a time, the packed kernel kicks in for big blocks
+static constexpr size_t IN_PLACE_ROWS_PER_BLOCK = 2 * PACKED_GEMM_THRESHOLD;
+
+template <MatrixElement T>
+BasicSIMDMatrix<T>& BasicSIMDMatrix<T>::operator*=(const BasicSIMDMatrix& rhs) requires std::is_same_v<ProductMatrix<T>, BasicSIMDMatrix>
+{
+	if (!rhs.isSquare() || m_cols != rhs.m_rows)
+		throw std::invalid_argument("Invalid argument: In-place product needs a square matrix with as many rows as this one has columns");
+
+	// x *= x reads every row of x for every row of the product
+	if (&rhs == this)
+	{
+		BasicSIMDMatrix product;
+		multiplyInto(*this, rhs, product);
+		swap(*this, product);
+		return *this;
+	}
+
+	size_t blockRows = std::min(m_rows, IN_PLACE_ROWS_PER_BLOCK);
+	BasicSIMDMatrix block(blockRows, m_cols, Uninitialized);
+	BasicSIMDMatrix product(blockRows, m_cols, Uninitialized);
+
+	for (size_t rowBegin = 0; rowBegin < m_rows; rowBegin += blockRows)
+	{
+		size_t rows = std::min(blockRows, m_rows - rowBegin);
+
+		// rows past the end of *this stay zero, so do the matching rows of the product
+		std::memcpy(block.m_data, &m_data[rowBegin * m_stride], rows * m_stride * sizeof(T));
+		if (rows < blockRows)
+			std::memset(&block.m_data[rows * m_stride], 0, (blockRows - rows) * m_stride * sizeof(T));
+
+		multiplyInto(block, rhs, product);
+		std::memcpy(&m_data[rowBegin * m_stride], product.m_data, rows * m_stride * sizeof(T));
+	}
+
+	return *this;
+}
+
+template <MatrixElement T>
+	requires std::is_same_v<ProductMatrix<T>, BasicSIMDMatrix<T>>
+BasicSIMDMatrix<T> linear_algebra::pow(const BasicSIMDMatrix<T>& mat, uint64_t pow)
 {
 	if (pow == 0 && !mat.isSquare())
 		throw std::invalid_argument("Bringing non-square matrix to the power of 0 is undefined");
 	else if (pow == 0)
-		return SIMDMatrix::Identity(mat.getRowCount());
+		return BasicSIMDMatrix<T>::Identity(mat.getRowCount());
 
 	if (pow == 1)
 		return mat;
 
-	SIMDMatrix res = mat;
-	for (uint64_t i = 1; i < pow; i++)
-		res *= mat;
+	if (!mat.isSquare())
+		throw std::invalid_argument("Invalid argument: Only square matrices can be raised to a power");
+
+	DIGRAPH_PROFILE_SCOPE("pow");
+
+	// exponentiation by squaring. base holds mat^(2^i), result collects the set bits of pow.
+	// all three buffers are allocated up front and then only swapped around, so
+	// computing mat^pow takes O(log pow) multiplications and no further allocations
+	size_t size = mat.getRowCount();
+	BasicSIMDMatrix<T> base = mat;
+	BasicSIMDMatrix<T> result(size, size, Uninitialized);
+	BasicSIMDMatrix<T> scratch(size, size, Uninitialized);
+	bool resultSet = false;
+
+	while (true)
+	{
+		if (pow & 1)
+		{
+			if (!resultSet)
+			{
+				result = base; // same size, so this is only a memcpy
+				resultSet = true;
+			}
+			else
+			{
+				multiplyInto(result, base, scratch);
+				swap(result, scratch);
+			}
+		}
+
+		pow >>= 1;
+		if (pow == 0)
+			break;
 
-	return res;
+		multiplyInto(base, base, scratch);
+		swap(base, scratch);
+	}
+
+	return result;
+}
+
+namespace linear_algebra
+{
+	template class BasicSIMDMatrix<float>;
+	template class BasicSIMDMatrix<double>;
+	template class BasicSIMDMatrix<int32_t>;
+	template class BasicSIMDMatrix<uint8_t>;
+	template class BasicSIMDMatrix<uint64_t>;
+
+	template void multiplyInto<float>(const BasicSIMDMatrix<float>&, const BasicSIMDMatrix<float>&, ProductMatrix<float>&, GemmKernel);
+	template void multiplyInto<double>(const BasicSIMDMatrix<double>&, const BasicSIMDMatrix<double>&, ProductMatrix<double>&, GemmKernel);
+	template void multiplyInto<int32_t>(const BasicSIMDMatrix<int32_t>&, const BasicSIMDMatrix<int32_t>&, ProductMatrix<int32_t>&, GemmKernel);
+	template void multiplyInto<uint8_t>(const BasicSIMDMatrix<uint8_t>&, const BasicSIMDMatrix<uint8_t>&, ProductMatrix<uint8_t>&, GemmKernel);
+	template void multiplyInto<uint64_t>(const BasicSIMDMatrix<uint64_t>&, const BasicSIMDMatrix<uint64_t>&, ProductMatrix<uint64_t>&, GemmKernel);
+
+	template void multiplyAddInto<float>(const BasicSIMDMatrix<float>&, const BasicSIMDMatrix<float>&, ProductMatrix<float>&, GemmKernel);
+	template void multiplyAddInto<double>(const BasicSIMDMatrix<double>&, const BasicSIMDMatrix<double>&, ProductMatrix<double>&, GemmKernel);
+	template void multiplyAddInto<int32_t>(const BasicSIMDMatrix<int32_t>&, const BasicSIMDMatrix<int32_t>&, ProductMatrix<int32_t>&, GemmKernel);
+	template void multiplyAddInto<uint8_t>(const BasicSIMDMatrix<uint8_t>&, const BasicSIMDMatrix<uint8_t>&, ProductMatrix<uint8_t>&, GemmKernel);
+	template void multiplyAddInto<uint64_t>(const BasicSIMDMatrix<uint64_t>&, const BasicSIMDMatrix<uint64_t>&, ProductMatrix<uint64_t>&, GemmKernel);
+
+	template void addInto<float>(const BasicSIMDMatrix<float>&, const BasicSIMDMatrix<float>&, BasicSIMDMatrix<float>&);
+	template void addInto<double>(const BasicSIMDMatrix<double>&, const BasicSIMDMatrix<double>&, BasicSIMDMatrix<double>&);
+	template void addInto<int32_t>(const BasicSIMDMatrix<int32_t>&, const BasicSIMDMatrix<int32_t>&, BasicSIMDMatrix<int32_t>&);
+	template void addInto<uint8_t>(const BasicSIMDMatrix<uint8_t>&, const BasicSIMDMatrix<uint8_t>&, BasicSIMDMatrix<uint8_t>&);
+	template void addInto<uint64_t>(const BasicSIMDMatrix<uint64_t>&, const BasicSIMDMatrix<uint64_t>&, BasicSIMDMatrix<uint64_t>&);
+
+	template void scaleInto<float>(const BasicSIMDMatrix<float>&, float, BasicSIMDMatrix<float>&);
+	template void scaleInto<double>(const BasicSIMDMatrix<double>&, double, BasicSIMDMatrix<double>&);
+	template void scaleInto<int32_t>(const BasicSIMDMatrix<int32_t>&, int32_t, BasicSIMDMatrix<int32_t>&);
+	template void scaleInto<uint8_t>(const BasicSIMDMatrix<uint8_t>&, uint8_t, BasicSIMDMatrix<uint8_t>&);
+	template void scaleInto<uint64_t>(const BasicSIMDMatrix<uint64_t>&, uint64_t, BasicSIMDMatrix<uint64_t>&);
+
+	template BasicSIMDMatrix<float> pow<float>(const BasicSIMDMatrix<float>&, uint64_t);
+	template BasicSIMDMatrix<double> pow<double>(const BasicSIMDMatrix<double>&, uint64_t);
+	template BasicSIMDMatrix<int32_t> pow<int32_t>(const BasicSIMDMatrix<int32_t>&, uint64_t);
 }
\ No newline at end of file
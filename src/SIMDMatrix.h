@@ -22,108 +22,275 @@
 
 #pragma once
 
+#include "CountArithmetic.h"
+
 namespace linear_algebra
 {
 	template <typename T>
-	concept ScalarType = std::is_arithmetic_v<T> && std::convertible_to<T, float>;
+	concept ScalarType = std::is_arithmetic_v<T>;
+
+	// element types BasicSIMDMatrix is instantiated for
+	template <typename T>
+	concept MatrixElement = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>
+		|| std::is_same_v<T, uint8_t> || std::is_same_v<T, uint64_t>;
+
+	// element type of a product. Bytes are widened to 64 bits, so uint8 adjacency
+	// matrices multiply into exact counts without ever overflowing
+	template <typename T>
+	struct ProductOf { using type = T; };
 
-	class SIMDMatrix
+	template <>
+	struct ProductOf<uint8_t> { using type = uint64_t; };
+
+	// Auto picks the packed kernel once all dimensions reach PACKED_GEMM_THRESHOLD, and
+	// Strassen-Winograd for int32 products once they reach the Strassen cutoff
+	enum class GemmKernel
+	{
+		Auto,
+		Simple,	// 4x8 register block, streams rhs straight from the matrix
+		Packed,	// 6x16 register block over L1/L2/L3 sized, packed panels (float only)
+		Strassen	// Strassen-Winograd over Auto down to the cutoff (the default one while it's off)
+	};
+
+	inline constexpr size_t PACKED_GEMM_THRESHOLD = 128;
+
+	// products whose every dimension reaches the cutoff take Strassen-Winograd (see Strassen.h)
+	// wherever it's exact: int32 products, which wrap anyway, and modular count products.
+	// Floats only take it when asked for, saturating counts never (a saturated entry can't be
+	// subtracted from). 0 turns it off
+	inline constexpr size_t DEFAULT_STRASSEN_CUTOFF = 512;
+
+	void setStrassenCutoff(size_t cutoff);
+	size_t getStrassenCutoff();
+
+	// picks the constructor that leaves the elements as they come out of the buffer pool,
+	// for outputs that get overwritten in full anyway. The padding is zeroed regardless
+	struct Uninitialized_t { explicit Uninitialized_t() = default; };
+	inline constexpr Uninitialized_t Uninitialized{};
+
+	template <MatrixElement T>
+	class BasicSIMDMatrix;
+
+	template <MatrixElement T>
+	using ProductMatrix = BasicSIMDMatrix<typename ProductOf<T>::type>;
+
+	// writes lhs * rhs into out without allocating, as long as out already has the right shape.
+	// out must not be the same object as lhs or rhs. Integer products wrap around, except for
+	// uint64_t which has its own overload with saturating (or modular) arithmetic
+	template <MatrixElement T>
+	void multiplyInto(const BasicSIMDMatrix<T>& lhs, const BasicSIMDMatrix<T>& rhs, ProductMatrix<T>& out, GemmKernel kernel = GemmKernel::Auto);
+
+	// out = lhs * rhs under the given arithmetic. In modular mode every entry of
+	// lhs and rhs has to be below the modulus already
+	void multiplyInto(const BasicSIMDMatrix<uint64_t>& lhs, const BasicSIMDMatrix<uint64_t>& rhs, BasicSIMDMatrix<uint64_t>& out, CountArithmetic arithmetic = {});
+
+	// out += lhs * rhs, accumulated straight into out by the GEMM kernels so the product
+	// never exists on its own. out must already have the shape of the product and must
+	// not be one of the operands
+	template <MatrixElement T>
+	void multiplyAddInto(const BasicSIMDMatrix<T>& lhs, const BasicSIMDMatrix<T>& rhs, ProductMatrix<T>& out, GemmKernel kernel = GemmKernel::Auto);
+
+	// same under the given arithmetic, in modular mode out has to be reduced as well
+	void multiplyAddInto(const BasicSIMDMatrix<uint64_t>& lhs, const BasicSIMDMatrix<uint64_t>& rhs, BasicSIMDMatrix<uint64_t>& out, CountArithmetic arithmetic = {});
+
+	// out = lhs + rhs and out = src * scalar. out may be one of the operands, otherwise
+	// its storage is reused as long as it already has the right shape
+	template <MatrixElement T>
+	void addInto(const BasicSIMDMatrix<T>& lhs, const BasicSIMDMatrix<T>& rhs, BasicSIMDMatrix<T>& out);
+
+	template <MatrixElement T>
+	void scaleInto(const BasicSIMDMatrix<T>& src, T scalar, BasicSIMDMatrix<T>& out);
+
+	// Dense matrix in one 32-byte aligned buffer. Rows are padded to a multiple of 4 and
+	// every row to a whole AVX2 register (8 floats, 4 doubles or counts, 32 bytes), so the
+	// kernels never need a tail. The padding is always zero. Buffers come from and go back
+	// to BufferPool::Global(), so matrices of a recurring shape cost no system allocation.
+	template <MatrixElement T>
+	class BasicSIMDMatrix
 	{
 	public:
-		SIMDMatrix()
+		using value_type = T;
+
+		// elements in one 32-byte column group
+		static constexpr size_t COLUMN_GROUP = 32 / sizeof(T);
+
+		BasicSIMDMatrix()
 			: m_rows(0), m_cols(0), m_stride(0), m_strideRow(0), m_data(nullptr)
 		{ }
 
-		SIMDMatrix(size_t rc);
-		SIMDMatrix(size_t rows, size_t cols);
-		~SIMDMatrix();
+		BasicSIMDMatrix(size_t rc);
+		BasicSIMDMatrix(size_t rows, size_t cols);
+		BasicSIMDMatrix(size_t rows, size_t cols, Uninitialized_t);
+		~BasicSIMDMatrix();
+
+		// element-wise conversion from another element type
+		template <MatrixElement U>
+		explicit BasicSIMDMatrix(const BasicSIMDMatrix<U>& other)
+			: BasicSIMDMatrix(other.getRowCount(), other.getColCount(), Uninitialized)
+		{
+			for (size_t i = 0; i < m_rows; i++)
+			for (size_t j = 0; j < m_cols; j++)
+				m_data[i * m_stride + j] = static_cast<T>(other.get(i, j));
+		}
 
 		// copy ctors
-		SIMDMatrix(const SIMDMatrix& other);
-		SIMDMatrix& operator=(const SIMDMatrix& other);
+		BasicSIMDMatrix(const BasicSIMDMatrix& other);
+		BasicSIMDMatrix& operator=(const BasicSIMDMatrix& other);
 
 		// move ctors
-		SIMDMatrix(SIMDMatrix&& other) noexcept;
-		SIMDMatrix& operator=(SIMDMatrix&& other) noexcept;
+		BasicSIMDMatrix(BasicSIMDMatrix&& other) noexcept;
+		BasicSIMDMatrix& operator=(BasicSIMDMatrix&& other) noexcept;
 
 
 		bool isSquare() const { return m_cols == m_rows; }
 		bool isZero() const;
 
-		float get(size_t row, size_t col) const;
-		void set(size_t row, size_t col, float value);
+		// true if any count stuck at COUNT_SATURATED
+		bool anySaturated() const requires std::is_same_v<T, uint64_t>;
+
+		T get(size_t row, size_t col) const;
+		void set(size_t row, size_t col, T value);
 
 		size_t getRowCount() const { return m_rows; }
 		size_t getColCount() const { return m_cols; }
 
-		SIMDMatrix operator+(const SIMDMatrix&);
-		inline SIMDMatrix operator+=(const SIMDMatrix& other)
+		// the elements of one row, padding (zero) included, with no bounds check
+		const T* rowData(size_t row) const { return &m_data[row * m_stride]; }
+
+		// words of a row mask, see nonZeroMask
+		size_t getMaskWordCount() const { return (m_stride + 63) / 64; }
+
+		// sets bit j of mask (getMaskWordCount() words) when entry (row, j) isn't zero and returns
+		// whether any is. One vector compare per column group instead of a branch per entry
+		bool nonZeroMask(size_t row, uint64_t* mask) const;
+
+		// calls fn(col, value) for every nonzero entry of one row, in order
+		template <typename Fn>
+		void forEachNonZeroInRow(size_t row, Fn&& fn) const
 		{
-			*this = *this + other;
-			return *this;
+			std::vector<uint64_t> mask(getMaskWordCount());
+			visitNonZero(row, mask.data(), fn);
 		}
-		
-		friend SIMDMatrix operator*(const SIMDMatrix& rhs, ScalarType auto lhs) noexcept
-		{
-			SIMDMatrix result = rhs;
-			__m256 scalarVec = _mm256_set1_ps(static_cast<float>(lhs));
 
-			for (size_t i = 0; i < result.m_rows; i++)
+		// calls fn(row, col, value) for every nonzero entry, in row-major order. Rows that are
+		// all zero cost a few compares, which is most of them in sparse walk counts
+		template <typename Fn>
+		void forEachNonZero(Fn&& fn) const
+		{
+			std::vector<uint64_t> mask(getMaskWordCount());
+			for (size_t i = 0; i < m_rows; i++)
 			{
-				for (size_t j = 0; j < result.m_stride; j+=8)
-				{
-					size_t ix = i * rhs.m_stride + j;
-					const float* inputPtr = &rhs.m_data[ix];
-					float* resultPtr = &result.m_data[ix];
-					__m256 vecA = _mm256_load_ps(inputPtr);
-					__m256 vecRes = _mm256_mul_ps(vecA, scalarVec);
-					_mm256_store_ps(resultPtr, vecRes);
-				}
+				auto visitor = [&](size_t col, T value) { fn(i, col, value); };
+				visitNonZero(i, mask.data(), visitor);
 			}
+		}
+
+		// size of the buffer, padding included
+		size_t getByteSize() const { return bufferBytes(); }
 
-			_mm256_zeroupper();
+		BasicSIMDMatrix operator+(const BasicSIMDMatrix& other) const;
+		inline BasicSIMDMatrix& operator+=(const BasicSIMDMatrix& other)
+		{
+			addInto(*this, other, *this);
+			return *this;
+		}
+		
+		friend BasicSIMDMatrix operator*(const BasicSIMDMatrix& rhs, ScalarType auto lhs)
+		{
+			BasicSIMDMatrix result(rhs.m_rows, rhs.m_cols, Uninitialized);
+			scaleInto(rhs, static_cast<T>(lhs), result);
 			return result;
 		}
 
-		inline friend SIMDMatrix operator*(ScalarType auto lhs, const SIMDMatrix& rhs) noexcept
+		inline friend BasicSIMDMatrix operator*(ScalarType auto lhs, const BasicSIMDMatrix& rhs) noexcept
 		{
 			return rhs * lhs;
 		}
 
-		SIMDMatrix& operator*=(ScalarType auto lhs) noexcept
+		BasicSIMDMatrix& operator*=(ScalarType auto lhs)
 		{
-			__m256 scalarVec = _mm256_set1_ps(static_cast<float>(lhs));
-
-			for (size_t i = 0; i < m_rows; i++)
-			for (size_t j = 0; j < m_stride; j += 8)
-			{
-				float* inputPtr = &m_data[i * m_stride + j];
-				__m256 vecMat = _mm256_load_ps(inputPtr);
-				__m256 res = _mm256_mul_ps(vecMat, scalarVec);
-				_mm256_store_ps(inputPtr, res);
-			}
-
-			_mm256_zeroupper();
+			scaleInto(*this, static_cast<T>(lhs), *this);
 			return *this;
 		}
 
-		friend SIMDMatrix operator*(const SIMDMatrix& lhs, const SIMDMatrix& rhs);
-		SIMDMatrix& operator*=(const SIMDMatrix& lhs)
+		friend ProductMatrix<T> operator*(const BasicSIMDMatrix& lhs, const BasicSIMDMatrix& rhs)
 		{
-			*this = *this * lhs;
-			return *this;
+			ProductMatrix<T> result(lhs.m_rows, rhs.m_cols, Uninitialized);
+			multiplyInto(lhs, rhs, result);
+			return result;
 		}
 
-		static SIMDMatrix Identity(size_t size);
+		// *this = *this * rhs for a square rhs. Rows of the product only depend on the same rows
+		// of *this, so they are computed a block at a time and copied back over the old ones
+		BasicSIMDMatrix& operator*=(const BasicSIMDMatrix& rhs) requires std::is_same_v<ProductMatrix<T>, BasicSIMDMatrix>;
+
+		template <MatrixElement U>
+		friend void multiplyInto(const BasicSIMDMatrix<U>& lhs, const BasicSIMDMatrix<U>& rhs, ProductMatrix<U>& out, GemmKernel kernel);
+		friend void multiplyInto(const BasicSIMDMatrix<uint64_t>& lhs, const BasicSIMDMatrix<uint64_t>& rhs, BasicSIMDMatrix<uint64_t>& out, CountArithmetic arithmetic);
+		template <MatrixElement U>
+		friend void multiplyAddInto(const BasicSIMDMatrix<U>& lhs, const BasicSIMDMatrix<U>& rhs, ProductMatrix<U>& out, GemmKernel kernel);
+		friend void multiplyAddInto(const BasicSIMDMatrix<uint64_t>& lhs, const BasicSIMDMatrix<uint64_t>& rhs, BasicSIMDMatrix<uint64_t>& out, CountArithmetic arithmetic);
+		template <MatrixElement U>
+		friend void addInto(const BasicSIMDMatrix<U>& lhs, const BasicSIMDMatrix<U>& rhs, BasicSIMDMatrix<U>& out);
+		template <MatrixElement U>
+		friend void scaleInto(const BasicSIMDMatrix<U>& src, U scalar, BasicSIMDMatrix<U>& out);
+
+		static BasicSIMDMatrix Identity(size_t size);
+
+		friend void swap(BasicSIMDMatrix& lhs, BasicSIMDMatrix& rhs) noexcept
+		{
+			std::swap(lhs.m_rows, rhs.m_rows);
+			std::swap(lhs.m_cols, rhs.m_cols);
+			std::swap(lhs.m_stride, rhs.m_stride);
+			std::swap(lhs.m_strideRow, rhs.m_strideRow);
+			std::swap(lhs.m_data, rhs.m_data);
+		}
+
+		template <MatrixElement U>
+		friend class BasicSIMDMatrix;
 		
 	private:
-		void initialize();
+		void initialize(bool zeroFill);
+		size_t bufferBytes() const { return m_strideRow * m_stride * sizeof(T); }
+
+		template <typename Fn>
+		void visitNonZero(size_t row, uint64_t* mask, Fn& fn) const
+		{
+			if (!nonZeroMask(row, mask))
+				return;
+
+			const T* data = rowData(row);
+			size_t words = getMaskWordCount();
+			for (size_t w = 0; w < words; w++)
+			{
+				uint64_t word = mask[w];
+				while (word)
+				{
+					size_t col = w * 64 + std::countr_zero(word);
+					fn(col, data[col]);
+					word &= word - 1;
+				}
+			}
+		}
 
 	private:
 		size_t m_rows, m_cols, m_stride, m_strideRow;
-		float* m_data;
+		T* m_data;
 	};
 
+	using SIMDMatrix = BasicSIMDMatrix<float>;
+
+	extern template class BasicSIMDMatrix<float>;
+	extern template class BasicSIMDMatrix<double>;
+	extern template class BasicSIMDMatrix<int32_t>;
+	extern template class BasicSIMDMatrix<uint8_t>;
+	extern template class BasicSIMDMatrix<uint64_t>;
+
 	// no need for pow -1, -2, 1/2 etc.
-	SIMDMatrix pow(const SIMDMatrix& mat, uint64_t pow);
+	template <MatrixElement T>
+		requires std::is_same_v<ProductMatrix<T>, BasicSIMDMatrix<T>>
+	BasicSIMDMatrix<T> pow(const BasicSIMDMatrix<T>& mat, uint64_t pow);
+
+	// in modular mode mat gets reduced first, so it may hold any counts
+	BasicSIMDMatrix<uint64_t> pow(const BasicSIMDMatrix<uint64_t>& mat, uint64_t pow, CountArithmetic arithmetic = {});
 }
\ No newline at end of file
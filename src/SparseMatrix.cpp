@@ -0,0 +1,430 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "SparseMatrix.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+using namespace linear_algebra;
+
+// rows of lhs handled by a single SpGEMM / SpMV task
+static constexpr size_t SPARSE_ROWS_PER_TASK = 512;
+
+// fewer stored entries than this keep sparse products on the calling thread
+static constexpr size_t PARALLEL_SPARSE_MIN_NNZ = 1ull << 16;
+
+template <typename T>
+BasicSparseMatrix<T>::BasicSparseMatrix(size_t rows, size_t cols)
+	: m_rows(rows), m_cols(cols), m_rowOffsets(rows + 1, 0)
+{
+	if (cols > std::numeric_limits<uint32_t>::max())
+		throw std::invalid_argument("Invalid argument: Too many columns for a sparse matrix");
+}
+
+template <typename T>
+BasicSparseMatrix<T>::BasicSparseMatrix(size_t rows, size_t cols, std::vector<uint64_t> rowOffsets, std::vector<uint32_t> colIndices, std::vector<T> values)
+	: m_rows(rows), m_cols(cols), m_rowOffsets(std::move(rowOffsets)), m_colIndices(std::move(colIndices)), m_values(std::move(values))
+{
+	if (cols > std::numeric_limits<uint32_t>::max())
+		throw std::invalid_argument("Invalid argument: Too many columns for a sparse matrix");
+
+	if (m_rowOffsets.size() != rows + 1 || m_colIndices.size() != m_values.size() || m_rowOffsets.back() != m_values.size())
+		throw std::invalid_argument("Invalid argument: Inconsistent CSR arrays");
+}
+
+template <typename T>
+double BasicSparseMatrix<T>::density() const
+{
+	if (m_rows == 0 || m_cols == 0)
+		return 0.0;
+
+	return static_cast<double>(m_values.size()) / (static_cast<double>(m_rows) * static_cast<double>(m_cols));
+}
+
+template <typename T>
+T BasicSparseMatrix<T>::get(size_t row, size_t col) const
+{
+	if (row >= m_rows || col >= m_cols)
+		throw std::out_of_range("Matrix index out of bounds");
+
+	auto cols = rowColumns(row);
+	auto it = std::lower_bound(cols.begin(), cols.end(), static_cast<uint32_t>(col));
+
+	if (it == cols.end() || *it != col)
+		return T(0);
+
+	return m_values[m_rowOffsets[row] + std::distance(cols.begin(), it)];
+}
+
+template <typename T>
+typename BasicSparseMatrix<T>::DenseMatrix BasicSparseMatrix<T>::toDense() const
+{
+	DenseMatrix mat(m_rows, m_cols);
+	forEachNonZero([&](size_t row, size_t col, T value) { mat.set(row, col, value); });
+	return mat;
+}
+
+template <typename T>
+BasicSparseMatrix<T> BasicSparseMatrix<T>::FromDense(const DenseMatrix& mat)
+{
+	BasicSparseMatrix result(mat.getRowCount(), mat.getColCount());
+
+	for (size_t i = 0; i < mat.getRowCount(); i++)
+	{
+		for (size_t j = 0; j < mat.getColCount(); j++)
+		{
+			T value = mat.get(i, j);
+			if (value == T(0))
+				continue;
+
+			result.m_colIndices.push_back(static_cast<uint32_t>(j));
+			result.m_values.push_back(value);
+		}
+
+		result.m_rowOffsets[i + 1] = result.m_values.size();
+	}
+
+	return result;
+}
+
+template <typename T>
+BasicSparseMatrix<T> BasicSparseMatrix<T>::Identity(size_t size)
+{
+	std::vector<uint64_t> offsets(size + 1);
+	std::vector<uint32_t> cols(size);
+
+	std::iota(offsets.begin(), offsets.end(), 0);
+	std::iota(cols.begin(), cols.end(), 0);
+
+	return BasicSparseMatrix(size, size, std::move(offsets), std::move(cols), std::vector<T>(size, T(1)));
+}
+
+template class linear_algebra::BasicSparseMatrix<float>;
+template class linear_algebra::BasicSparseMatrix<uint64_t>;
+
+// plain arithmetic for the float matrices
+struct FloatOps
+{
+	float mulAdd(float acc, float a, float b) const { return acc + a * b; }
+	float finish(float acc) const { return acc; }
+};
+
+// dense accumulator for a single output row. stamps mark the touched columns,
+// so it never has to be cleared between rows
+template <typename T>
+struct RowAccumulator
+{
+	std::vector<T> values;
+	std::vector<uint32_t> stamps;
+	std::vector<uint32_t> touched;
+	uint32_t stamp = 0;
+
+	void prepare(size_t cols)
+	{
+		if (values.size() < cols)
+		{
+			values.resize(cols);
+			stamps.assign(cols, 0);
+			stamp = 0;
+		}
+
+		if (++stamp == 0)
+		{
+			std::fill(stamps.begin(), stamps.end(), 0);
+			stamp = 1;
+		}
+
+		touched.clear();
+	}
+};
+
+// Gustavson over rows [rowBegin, rowEnd) of lhs, appending the results to cols/values
+// and the per-row entry counts to rowSizes
+template <typename T, typename Ops>
+static void spgemmRows(const BasicSparseMatrix<T>& lhs, const BasicSparseMatrix<T>& rhs, size_t rowBegin, size_t rowEnd, const Ops& ops,
+	std::vector<uint32_t>& cols, std::vector<T>& values, std::vector<uint64_t>& rowSizes)
+{
+	thread_local RowAccumulator<T> acc;
+	size_t width = rhs.getColCount();
+
+	for (size_t i = rowBegin; i < rowEnd; i++)
+	{
+		acc.prepare(width);
+
+		auto aCols = lhs.rowColumns(i);
+		auto aValues = lhs.rowValues(i);
+
+		for (size_t a = 0; a < aCols.size(); a++)
+		{
+			auto bCols = rhs.rowColumns(aCols[a]);
+			auto bValues = rhs.rowValues(aCols[a]);
+			T scale = aValues[a];
+
+			for (size_t b = 0; b < bCols.size(); b++)
+			{
+				uint32_t j = bCols[b];
+				if (acc.stamps[j] != acc.stamp)
+				{
+					acc.stamps[j] = acc.stamp;
+					acc.values[j] = T(0);
+					acc.touched.push_back(j);
+				}
+
+				acc.values[j] = ops.mulAdd(acc.values[j], scale, bValues[b]);
+			}
+		}
+
+		size_t before = cols.size();
+
+		// a nearly full row is cheaper to collect by scanning than by sorting
+		if (acc.touched.size() * 16 > width)
+		{
+			for (uint32_t j = 0; j < width; j++)
+			{
+				if (acc.stamps[j] != acc.stamp)
+					continue;
+
+				cols.push_back(j);
+				values.push_back(ops.finish(acc.values[j]));
+			}
+		}
+		else
+		{
+			std::sort(acc.touched.begin(), acc.touched.end());
+			for (uint32_t j : acc.touched)
+			{
+				cols.push_back(j);
+				values.push_back(ops.finish(acc.values[j]));
+			}
+		}
+
+		rowSizes.push_back(cols.size() - before);
+	}
+}
+
+template <typename T, typename Ops>
+void linear_algebra::detail::sparseMultiplyInto(const BasicSparseMatrix<T>& lhs, const BasicSparseMatrix<T>& rhs, BasicSparseMatrix<T>& out, const Ops& ops)
+{
+	if (lhs.m_cols != rhs.m_rows)
+		throw std::invalid_argument("Invalid argument: Multiplied matrix column count must be equal to the row count of matrix multiplied by");
+
+	if (&out == &lhs || &out == &rhs)
+		throw std::invalid_argument("Invalid argument: Output matrix cannot be one of the operands");
+
+	DIGRAPH_PROFILE_SCOPE("spgemm");
+	DIGRAPH_PROFILE_COUNT(Multiplies, 1);
+
+	out.m_rows = lhs.m_rows;
+	out.m_cols = rhs.m_cols;
+	out.m_rowOffsets.resize(lhs.m_rows + 1);
+	out.m_rowOffsets[0] = 0;
+	out.m_colIndices.clear();
+	out.m_values.clear();
+
+	std::vector<uint64_t> rowSizes;
+	rowSizes.reserve(lhs.m_rows);
+
+	size_t tasks = (lhs.m_rows + SPARSE_ROWS_PER_TASK - 1) / SPARSE_ROWS_PER_TASK;
+	bool parallel = tasks > 1 && lhs.getNonZeroCount() + rhs.getNonZeroCount() >= PARALLEL_SPARSE_MIN_NNZ;
+
+	if (!parallel)
+		spgemmRows(lhs, rhs, 0, lhs.m_rows, ops, out.m_colIndices, out.m_values, rowSizes);
+	else
+	{
+		// every task fills its own chunk, the chunks get stitched together in order afterwards
+		struct Chunk
+		{
+			std::vector<uint32_t> cols;
+			std::vector<T> values;
+			std::vector<uint64_t> rowSizes;
+		};
+
+		std::vector<Chunk> chunks(tasks);
+		ThreadPool::Global().parallelFor(tasks, [&](size_t task)
+		{
+			size_t rowBegin = task * SPARSE_ROWS_PER_TASK;
+			size_t rowEnd = std::min(lhs.m_rows, rowBegin + SPARSE_ROWS_PER_TASK);
+			spgemmRows(lhs, rhs, rowBegin, rowEnd, ops, chunks[task].cols, chunks[task].values, chunks[task].rowSizes);
+		});
+
+		size_t total = 0;
+		for (const Chunk& chunk : chunks)
+			total += chunk.values.size();
+
+		out.m_colIndices.reserve(total);
+		out.m_values.reserve(total);
+
+		for (Chunk& chunk : chunks)
+		{
+			out.m_colIndices.insert(out.m_colIndices.end(), chunk.cols.begin(), chunk.cols.end());
+			out.m_values.insert(out.m_values.end(), chunk.values.begin(), chunk.values.end());
+			rowSizes.insert(rowSizes.end(), chunk.rowSizes.begin(), chunk.rowSizes.end());
+		}
+	}
+
+	for (size_t i = 0; i < lhs.m_rows; i++)
+		out.m_rowOffsets[i + 1] = out.m_rowOffsets[i] + rowSizes[i];
+}
+
+void linear_algebra::multiplyInto(const SparseMatrix& lhs, const SparseMatrix& rhs, SparseMatrix& out)
+{
+	detail::sparseMultiplyInto(lhs, rhs, out, FloatOps{});
+}
+
+void linear_algebra::multiplyInto(const SparseCountMatrix& lhs, const SparseCountMatrix& rhs, SparseCountMatrix& out, CountArithmetic arithmetic)
+{
+	detail::validateArithmetic(arithmetic);
+
+	if (arithmetic.isModular())
+		detail::sparseMultiplyInto(lhs, rhs, out, detail::ModularOps(arithmetic.modulus));
+	else
+		detail::sparseMultiplyInto(lhs, rhs, out, detail::SaturatingOps{});
+}
+
+SparseMatrix linear_algebra::operator*(const SparseMatrix& lhs, const SparseMatrix& rhs)
+{
+	SparseMatrix result;
+	multiplyInto(lhs, rhs, result);
+	return result;
+}
+
+void linear_algebra::multiplyInto(const SparseMatrix& mat, std::span<const float> x, std::span<float> y)
+{
+	if (x.size() != mat.getColCount() || y.size() != mat.getRowCount())
+		throw std::invalid_argument("Invalid argument: Vector sizes don't match the matrix");
+
+	auto multiplyRows = [&](size_t rowBegin, size_t rowEnd)
+	{
+		for (size_t i = rowBegin; i < rowEnd; i++)
+		{
+			auto cols = mat.rowColumns(i);
+			auto values = mat.rowValues(i);
+
+			float sum = 0.0f;
+			for (size_t ix = 0; ix < cols.size(); ix++)
+				sum += values[ix] * x[cols[ix]];
+
+			y[i] = sum;
+		}
+	};
+
+	size_t rows = mat.getRowCount();
+	size_t tasks = (rows + SPARSE_ROWS_PER_TASK - 1) / SPARSE_ROWS_PER_TASK;
+
+	if (tasks < 2 || mat.getNonZeroCount() < PARALLEL_SPARSE_MIN_NNZ)
+	{
+		multiplyRows(0, rows);
+		return;
+	}
+
+	ThreadPool::Global().parallelFor(tasks, [&](size_t task)
+	{
+		size_t rowBegin = task * SPARSE_ROWS_PER_TASK;
+		multiplyRows(rowBegin, std::min(rows, rowBegin + SPARSE_ROWS_PER_TASK));
+	});
+}
+
+// exponentiation by squaring, multiply(lhs, rhs, out) does the products.
+// same buffer ping-ponging as the dense overloads, here it keeps the vector capacities around
+template <typename T, typename Multiply>
+static BasicSparseMatrix<T> sparsePow(BasicSparseMatrix<T> base, uint64_t pow, Multiply&& multiply)
+{
+	if (pow == 0 && !base.isSquare())
+		throw std::invalid_argument("Bringing non-square matrix to the power of 0 is undefined");
+	else if (pow == 0)
+		return BasicSparseMatrix<T>::Identity(base.getRowCount());
+
+	if (pow == 1)
+		return base;
+
+	if (!base.isSquare())
+		throw std::invalid_argument("Invalid argument: Only square matrices can be raised to a power");
+
+	BasicSparseMatrix<T> result;
+	BasicSparseMatrix<T> scratch;
+	bool resultSet = false;
+
+	while (true)
+	{
+		if (pow & 1)
+		{
+			if (!resultSet)
+			{
+				result = base;
+				resultSet = true;
+			}
+			else
+			{
+				multiply(result, base, scratch);
+				std::swap(result, scratch);
+			}
+		}
+
+		pow >>= 1;
+		if (pow == 0)
+			break;
+
+		multiply(base, base, scratch);
+		std::swap(base, scratch);
+	}
+
+	return result;
+}
+
+SparseMatrix linear_algebra::pow(const SparseMatrix& mat, uint64_t pow)
+{
+	return sparsePow(mat, pow, [](const SparseMatrix& lhs, const SparseMatrix& rhs, SparseMatrix& out)
+	{
+		multiplyInto(lhs, rhs, out);
+	});
+}
+
+SparseCountMatrix linear_algebra::pow(const SparseCountMatrix& mat, uint64_t pow, CountArithmetic arithmetic)
+{
+	detail::validateArithmetic(arithmetic);
+
+	SparseCountMatrix base = mat;
+	if (arithmetic.isModular())
+	{
+		// the modular kernels expect reduced operands
+		std::vector<uint64_t> offsets(mat.getRowCount() + 1, 0);
+		std::vector<uint32_t> cols;
+		std::vector<uint64_t> values;
+		cols.reserve(mat.getNonZeroCount());
+		values.reserve(mat.getNonZeroCount());
+
+		mat.forEachNonZero([&](size_t row, size_t col, uint64_t value)
+		{
+			cols.push_back(static_cast<uint32_t>(col));
+			values.push_back(value % arithmetic.modulus);
+			offsets[row + 1]++;
+		});
+
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+		base = SparseCountMatrix(mat.getRowCount(), mat.getColCount(), std::move(offsets), std::move(cols), std::move(values));
+	}
+
+	return sparsePow(std::move(base), pow, [&](const SparseCountMatrix& lhs, const SparseCountMatrix& rhs, SparseCountMatrix& out)
+	{
+		multiplyInto(lhs, rhs, out, arithmetic);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "SIMDMatrix.h"
+#include "CountMatrix.h"
+
+namespace linear_algebra
+{
+	template <typename T>
+	class BasicSparseMatrix;
+
+	namespace detail
+	{
+		// SpGEMM shared by all value types, ops supplies mulAdd/finish (see CountArithmetic.h)
+		template <typename T, typename Ops>
+		void sparseMultiplyInto(const BasicSparseMatrix<T>& lhs, const BasicSparseMatrix<T>& rhs, BasicSparseMatrix<T>& out, const Ops& ops);
+	}
+
+	// Compressed sparse row matrix. Row i holds the entries
+	// m_colIndices/m_values[m_rowOffsets[i] .. m_rowOffsets[i + 1]), ordered by column.
+	// Memory scales with the number of non-zero entries instead of rows * cols.
+	// Instantiated for float (SparseMatrix) and uint64_t walk counts (SparseCountMatrix)
+	template <typename T>
+	class BasicSparseMatrix
+	{
+	public:
+		// dense counterpart of the same value type
+		using DenseMatrix = BasicSIMDMatrix<T>;
+
+		BasicSparseMatrix()
+			: m_rows(0), m_cols(0), m_rowOffsets(1, 0)
+		{ }
+
+		// empty (all zero) matrix
+		BasicSparseMatrix(size_t rows, size_t cols);
+
+		// takes over ready CSR arrays, column indices have to be sorted within every row
+		BasicSparseMatrix(size_t rows, size_t cols, std::vector<uint64_t> rowOffsets, std::vector<uint32_t> colIndices, std::vector<T> values);
+
+		bool isSquare() const { return m_cols == m_rows; }
+
+		size_t getRowCount() const { return m_rows; }
+		size_t getColCount() const { return m_cols; }
+		size_t getNonZeroCount() const { return m_values.size(); }
+
+		size_t getByteSize() const
+		{
+			return m_rowOffsets.size() * sizeof(uint64_t) + m_colIndices.size() * sizeof(uint32_t) + m_values.size() * sizeof(T);
+		}
+
+		// fraction of entries that are stored
+		double density() const;
+
+		T get(size_t row, size_t col) const;
+
+		std::span<const uint32_t> rowColumns(size_t row) const
+		{
+			return { m_colIndices.data() + m_rowOffsets[row], m_colIndices.data() + m_rowOffsets[row + 1] };
+		}
+
+		std::span<const T> rowValues(size_t row) const
+		{
+			return { m_values.data() + m_rowOffsets[row], m_values.data() + m_rowOffsets[row + 1] };
+		}
+
+		// calls fn(row, col, value) for every stored entry, in row-major order
+		template <typename Fn>
+		void forEachNonZero(Fn&& fn) const
+		{
+			for (size_t i = 0; i < m_rows; i++)
+			{
+				for (uint64_t ix = m_rowOffsets[i]; ix < m_rowOffsets[i + 1]; ix++)
+					fn(i, static_cast<size_t>(m_colIndices[ix]), m_values[ix]);
+			}
+		}
+
+		DenseMatrix toDense() const;
+		static BasicSparseMatrix FromDense(const DenseMatrix& mat);
+		static BasicSparseMatrix Identity(size_t size);
+
+		template <typename U, typename Ops>
+		friend void detail::sparseMultiplyInto(const BasicSparseMatrix<U>& lhs, const BasicSparseMatrix<U>& rhs, BasicSparseMatrix<U>& out, const Ops& ops);
+
+	private:
+		size_t m_rows, m_cols;
+		std::vector<uint64_t> m_rowOffsets;
+		std::vector<uint32_t> m_colIndices;
+		std::vector<T> m_values;
+	};
+
+	using SparseMatrix = BasicSparseMatrix<float>;
+	using SparseCountMatrix = BasicSparseMatrix<uint64_t>;
+
+	extern template class BasicSparseMatrix<float>;
+	extern template class BasicSparseMatrix<uint64_t>;
+
+	// SpGEMM (Gustavson, with a dense accumulator per row). Reuses the capacity of out
+	void multiplyInto(const SparseMatrix& lhs, const SparseMatrix& rhs, SparseMatrix& out);
+	void multiplyInto(const SparseCountMatrix& lhs, const SparseCountMatrix& rhs, SparseCountMatrix& out, CountArithmetic arithmetic = {});
+
+	SparseMatrix operator*(const SparseMatrix& lhs, const SparseMatrix& rhs);
+
+	// SpMV, y = mat * x
+	void multiplyInto(const SparseMatrix& mat, std::span<const float> x, std::span<float> y);
+
+	SparseMatrix pow(const SparseMatrix& mat, uint64_t pow);
+
+	// in modular mode mat gets reduced first, like the dense overload
+	SparseCountMatrix pow(const SparseCountMatrix& mat, uint64_t pow, CountArithmetic arithmetic = {});
+}
\ No newline at end of file
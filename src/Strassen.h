@@ -0,0 +1,180 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "BufferPool.h"
+
+namespace linear_algebra::detail
+{
+	// Strassen-Winograd: 7 half-size products and 15 additions per level instead of 8 products,
+	// recursing until the smallest dimension drops below the cutoff, then the classic kernel
+	// takes over. The schedule is the one of Douglas et al., which needs two temporaries per
+	// level (X for the sums of A and for P1, Y for the sums of B) and writes the other
+	// intermediate products straight into the quadrants of C. Every level takes its temporaries
+	// from one workspace allocated up front, so the whole recursion allocates once.
+	//
+	// Subtraction makes it exact only where the arithmetic is a ring: wrapping integers and
+	// residues of modular counts. Floats lose a little more precision than the classic product.
+	//
+	// Ops supplies the arithmetic:
+	//	multiply(m, n, k, a, lda, b, ldb, c, ldc, accumulate)	the classic c (+)= a * b
+	//	add(rows, cols, a, lda, b, ldb, out, ldo)	out = a + b, out may be a or b
+	//	sub(rows, cols, a, lda, b, ldb, out, ldo)	out = a - b, the same
+	// and GROUP, the elements of one 32-byte column group. Row counts have to be multiples of 4,
+	// column counts and leading dimensions multiples of the group (padded matrices are)
+	template <typename T, typename Ops>
+	class StrassenWinograd
+	{
+	public:
+		StrassenWinograd(const Ops& ops, size_t cutoff)
+			: m_ops(ops), m_cutoff(cutoff)
+		{ }
+
+		// c = a * b, c is m x n and a m x k
+		void multiply(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) const
+		{
+			size_t elements = workspaceSize(m, n, k);
+			if (elements == 0)
+			{
+				m_ops.multiply(m, n, k, a, lda, b, ldb, c, ldc, false);
+				return;
+			}
+
+			BufferPool& pool = BufferPool::Global();
+			T* workspace = static_cast<T*>(pool.allocate(elements * sizeof(T)));
+
+			try
+			{
+				level(m, n, k, a, lda, b, ldb, c, ldc, workspace);
+			}
+			catch (...)
+			{
+				pool.release(workspace, elements * sizeof(T));
+				throw;
+			}
+
+			pool.release(workspace, elements * sizeof(T));
+		}
+
+		// elements of workspace the recursion needs, 0 when it takes the classic product right away
+		size_t workspaceSize(size_t m, size_t n, size_t k) const
+		{
+			if (!splits(m, n, k))
+				return 0;
+
+			Halves h = halves(m, n, k);
+			return h.m * std::max(h.k, h.n) + h.k * h.n + workspaceSize(h.m, h.n, h.k);
+		}
+
+	private:
+		struct Halves
+		{
+			size_t m, n, k;
+		};
+
+		bool splits(size_t m, size_t n, size_t k) const
+		{
+			return m_cutoff != 0 && std::min({ m, n, k }) >= std::max(m_cutoff, 2 * Ops::GROUP);
+		}
+
+		// rows split at a multiple of 4 and columns at a multiple of the group, so every quadrant
+		// starts aligned. Whatever doesn't fit into twice the halves gets peeled off
+		static Halves halves(size_t m, size_t n, size_t k)
+		{
+			return { m / 8 * 4, n / (2 * Ops::GROUP) * Ops::GROUP, k / (2 * Ops::GROUP) * Ops::GROUP };
+		}
+
+		void level(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, T* workspace) const
+		{
+			if (!splits(m, n, k))
+			{
+				m_ops.multiply(m, n, k, a, lda, b, ldb, c, ldc, false);
+				return;
+			}
+
+			Halves h = halves(m, n, k);
+			size_t ldx = std::max(h.k, h.n);
+			size_t ldy = h.n;
+			T* x = workspace;
+			T* y = x + h.m * ldx;
+			T* deeper = y + h.k * ldy;
+
+			const T* a11 = a;
+			const T* a12 = a + h.k;
+			const T* a21 = a + h.m * lda;
+			const T* a22 = a21 + h.k;
+			const T* b11 = b;
+			const T* b12 = b + h.n;
+			const T* b21 = b + h.k * ldb;
+			const T* b22 = b21 + h.n;
+			T* c11 = c;
+			T* c12 = c + h.n;
+			T* c21 = c + h.m * ldc;
+			T* c22 = c21 + h.n;
+
+			auto product = [&](const T* lhs, size_t ldl, const T* rhs, size_t ldr, T* out, size_t ldo)
+			{
+				level(h.m, h.n, h.k, lhs, ldl, rhs, ldr, out, ldo, deeper);
+			};
+
+			m_ops.sub(h.m, h.k, a11, lda, a21, lda, x, ldx);	// S3 = A11 - A21
+			m_ops.sub(h.k, h.n, b22, ldb, b12, ldb, y, ldy);	// T3 = B22 - B12
+			product(x, ldx, y, ldy, c21, ldc);					// P7 = S3 T3
+			m_ops.add(h.m, h.k, a21, lda, a22, lda, x, ldx);	// S1 = A21 + A22
+			m_ops.sub(h.k, h.n, b12, ldb, b11, ldb, y, ldy);	// T1 = B12 - B11
+			product(x, ldx, y, ldy, c22, ldc);					// P5 = S1 T1
+			m_ops.sub(h.m, h.k, x, ldx, a11, lda, x, ldx);		// S2 = S1 - A11
+			m_ops.sub(h.k, h.n, b22, ldb, y, ldy, y, ldy);		// T2 = B22 - T1
+			product(x, ldx, y, ldy, c11, ldc);					// P6 = S2 T2
+			m_ops.sub(h.m, h.k, a12, lda, x, ldx, x, ldx);		// S4 = A12 - S2
+			m_ops.sub(h.k, h.n, y, ldy, b21, ldb, y, ldy);		// T4 = T2 - B21
+			product(x, ldx, b22, ldb, c12, ldc);				// P3 = S4 B22
+			product(a11, lda, b11, ldb, x, ldx);				// P1 = A11 B11
+			m_ops.add(h.m, h.n, x, ldx, c11, ldc, c11, ldc);	// U2 = P1 + P6
+			m_ops.add(h.m, h.n, c11, ldc, c21, ldc, c21, ldc);	// U3 = U2 + P7
+			m_ops.add(h.m, h.n, c11, ldc, c22, ldc, c11, ldc);	// U4 = U2 + P5
+			m_ops.add(h.m, h.n, c21, ldc, c22, ldc, c22, ldc);	// U7 = U3 + P5, C22 done
+			m_ops.add(h.m, h.n, c11, ldc, c12, ldc, c12, ldc);	// U5 = U4 + P3, C12 done
+			product(a22, lda, y, ldy, c11, ldc);				// P4 = A22 T4
+			m_ops.sub(h.m, h.n, c21, ldc, c11, ldc, c21, ldc);	// U6 = U3 - P4, C21 done
+			product(a12, lda, b21, ldb, c11, ldc);				// P2 = A12 B21
+			m_ops.add(h.m, h.n, x, ldx, c11, ldc, c11, ldc);	// U1 = P1 + P2, C11 done
+
+			// odd strips: the rest of k goes onto the core, the columns and rows past it get
+			// the classic product on their own
+			size_t coreM = 2 * h.m, coreN = 2 * h.n, coreK = 2 * h.k;
+			if (k > coreK)
+				m_ops.multiply(coreM, coreN, k - coreK, a + coreK, lda, b + coreK * ldb, ldb, c, ldc, true);
+
+			if (n > coreN)
+				m_ops.multiply(coreM, n - coreN, k, a, lda, b + coreN, ldb, c + coreN, ldc, false);
+
+			if (m > coreM)
+				m_ops.multiply(m - coreM, n, k, a + coreM * lda, lda, b, ldb, c + coreM * ldc, ldc, false);
+		}
+
+	private:
+		const Ops& m_ops;
+		size_t m_cutoff;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "ThreadPool.h"
+
+using namespace linear_algebra;
+
+static thread_local bool t_insidePool = false;
+
+static std::mutex s_globalMutex;
+static std::unique_ptr<ThreadPool> s_globalPool;
+
+static constexpr uint64_t packRange(uint64_t begin, uint64_t end)
+{
+	return (end << 32) | begin;
+}
+
+static constexpr uint64_t rangeBegin(uint64_t range) { return range & 0xFFFFFFFFull; }
+static constexpr uint64_t rangeEnd(uint64_t range) { return range >> 32; }
+
+static size_t resolveThreadCount(size_t threadCount)
+{
+	if (threadCount != 0)
+		return threadCount;
+
+	return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+ThreadPool::ThreadPool(size_t threadCount)
+	: m_generation(0), m_pending(0), m_stop(false), m_task(nullptr)
+{
+	threadCount = std::max<size_t>(1, threadCount);
+	m_slots = std::make_unique<Slot[]>(threadCount);
+
+	m_workers.reserve(threadCount - 1);
+	for (size_t i = 1; i < threadCount; i++)
+		m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_wake.notify_all();
+	for (auto& worker : m_workers)
+		worker.join();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task)
+{
+	if (count == 0)
+		return;
+
+	if (count == 1 || m_workers.empty() || t_insidePool)
+	{
+		for (size_t i = 0; i < count; i++)
+			task(i);
+		return;
+	}
+
+	if (count > 0xFFFFFFFFull)
+		throw std::invalid_argument("Invalid argument: Too many tasks for a single parallelFor");
+
+	std::lock_guard submitLock(m_submitMutex);
+
+	size_t slotCount = getThreadCount();
+	for (size_t s = 0; s < slotCount; s++)
+	{
+		uint64_t begin = count * s / slotCount;
+		uint64_t end = count * (s + 1) / slotCount;
+		m_slots[s].range.store(packRange(begin, end), std::memory_order_relaxed);
+	}
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_task = &task;
+		m_error = nullptr;
+		m_pending = m_workers.size();
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	t_insidePool = true;
+	runSlot(0);
+	t_insidePool = false;
+
+	std::unique_lock lock(m_mutex);
+	m_done.wait(lock, [this] { return m_pending == 0; });
+	m_task = nullptr;
+
+	if (m_error)
+		std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+ThreadPool& ThreadPool::Global()
+{
+	std::lock_guard lock(s_globalMutex);
+	if (!s_globalPool)
+		s_globalPool = std::make_unique<ThreadPool>(resolveThreadCount(0));
+
+	return *s_globalPool;
+}
+
+void ThreadPool::workerLoop(size_t slot)
+{
+	t_insidePool = true;
+	uint64_t seenGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_wake.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+
+			if (m_stop)
+				return;
+
+			seenGeneration = m_generation;
+		}
+
+		runSlot(slot);
+
+		std::lock_guard lock(m_mutex);
+		if (--m_pending == 0)
+			m_done.notify_one();
+	}
+}
+
+void ThreadPool::runSlot(size_t slot)
+{
+	size_t ix;
+	while (popOwn(slot, ix) || steal(slot, ix))
+	{
+		try
+		{
+			(*m_task)(ix);
+		}
+		catch (...)
+		{
+			std::lock_guard lock(m_mutex);
+			if (!m_error)
+				m_error = std::current_exception();
+		}
+	}
+}
+
+bool ThreadPool::popOwn(size_t slot, size_t& ix)
+{
+	auto& range = m_slots[slot].range;
+	uint64_t current = range.load(std::memory_order_acquire);
+
+	while (rangeBegin(current) < rangeEnd(current))
+	{
+		uint64_t next = packRange(rangeBegin(current) + 1, rangeEnd(current));
+		if (range.compare_exchange_weak(current, next, std::memory_order_acq_rel))
+		{
+			ix = rangeBegin(current);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ThreadPool::steal(size_t thief, size_t& ix)
+{
+	size_t slotCount = getThreadCount();
+
+	for (size_t offset = 1; offset < slotCount; offset++)
+	{
+		auto& range = m_slots[(thief + offset) % slotCount].range;
+		uint64_t current = range.load(std::memory_order_acquire);
+
+		while (rangeBegin(current) < rangeEnd(current))
+		{
+			uint64_t begin = rangeBegin(current);
+			uint64_t end = rangeEnd(current);
+			uint64_t mid = begin + (end - begin) / 2;
+
+			if (!range.compare_exchange_weak(current, packRange(begin, mid), std::memory_order_acq_rel))
+				continue;
+
+			// run the first stolen index now and keep the rest where others can steal it back
+			m_slots[thief].range.store(packRange(mid + 1, end), std::memory_order_release);
+			ix = mid;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void linear_algebra::setThreadCount(size_t threadCount)
+{
+	threadCount = resolveThreadCount(threadCount);
+
+	std::lock_guard lock(s_globalMutex);
+	if (s_globalPool && s_globalPool->getThreadCount() == threadCount)
+		return;
+
+	s_globalPool.reset();
+	s_globalPool = std::make_unique<ThreadPool>(threadCount);
+}
+
+size_t linear_algebra::getThreadCount()
+{
+	return ThreadPool::Global().getThreadCount();
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+namespace linear_algebra
+{
+	// Persistent pool of worker threads used by the matrix kernels.
+	// Every parallelFor splits its index range evenly between the participants
+	// (the calling thread included), and a participant that runs out of work
+	// steals the upper half of someone else's remaining range.
+	class ThreadPool
+	{
+	public:
+		// threadCount includes the calling thread, so 1 means no workers at all
+		explicit ThreadPool(size_t threadCount);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		size_t getThreadCount() const { return m_workers.size() + 1; }
+
+		// calls task(i) for every i in [0, count) and returns once all of them finished.
+		// called from inside a task it simply runs serially on the current thread
+		void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+		// pool shared by the whole library, sized to the hardware by default
+		static ThreadPool& Global();
+
+	private:
+		struct alignas(64) Slot
+		{
+			// remaining [begin, end) of the slot, begin in the low and end in the high 32 bits
+			std::atomic<uint64_t> range{ 0 };
+		};
+
+		void workerLoop(size_t slot);
+		void runSlot(size_t slot);
+		bool popOwn(size_t slot, size_t& ix);
+		bool steal(size_t thief, size_t& ix);
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::unique_ptr<Slot[]> m_slots;
+
+		std::mutex m_submitMutex;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+		uint64_t m_generation;
+		size_t m_pending;
+		bool m_stop;
+
+		const std::function<void(size_t)>* m_task;
+		std::exception_ptr m_error;
+	};
+
+	// resizes the global pool, 0 picks std::thread::hardware_concurrency().
+	// should not be called while another thread is using the pool
+	void setThreadCount(size_t threadCount);
+	size_t getThreadCount();
+
+	// calls fn(rowBegin, rowEnd) over blocks of rowsPerTask rows, on the global pool if parallel is set
+	template <typename Fn>
+	void forEachRowBlock(size_t rows, size_t rowsPerTask, bool parallel, Fn&& fn)
+	{
+		size_t tasks = (rows + rowsPerTask - 1) / rowsPerTask;
+		if (!parallel || tasks < 2)
+		{
+			fn(size_t(0), rows);
+			return;
+		}
+
+		ThreadPool::Global().parallelFor(tasks, [&](size_t task)
+		{
+			fn(task * rowsPerTask, std::min(rows, (task + 1) * rowsPerTask));
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include "VertexTable.h"
+#include "Profiler.h"
+
+using namespace graph;
+
+namespace
+{
+	struct VertexArrays
+	{
+		std::vector<char> chars;
+		std::vector<uint64_t> offsets;
+		std::vector<Vertex> slots;
+	};
+}
+
+static const uint64_t EMPTY_OFFSETS[1] = { 0 };
+static const Vertex EMPTY_SLOTS[1] = { VertexTable::EMPTY_SLOT };
+
+VertexTable::VertexTable()
+	: m_offsets(EMPTY_OFFSETS), m_slots(EMPTY_SLOTS)
+{ }
+
+uint64_t VertexTable::Hash(std::string_view name)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (char c : name)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+VertexTable VertexTable::Build(const std::vector<std::string>& names)
+{
+	DIGRAPH_PROFILE_SCOPE("intern vertex names");
+
+	if (names.size() >= EMPTY_SLOT)
+		throw std::invalid_argument("Invalid argument: Too many vertices");
+
+	auto arrays = std::make_shared<VertexArrays>();
+
+	size_t charCount = 0;
+	for (const std::string& name : names)
+		charCount += name.size();
+
+	arrays->chars.reserve(charCount);
+	arrays->offsets.reserve(names.size() + 1);
+	arrays->offsets.push_back(0);
+
+	for (const std::string& name : names)
+	{
+		arrays->chars.insert(arrays->chars.end(), name.begin(), name.end());
+		arrays->offsets.push_back(arrays->chars.size());
+	}
+
+	size_t slotCount = std::bit_ceil(std::max<size_t>(names.size() * 2, 1));
+	arrays->slots.assign(slotCount, EMPTY_SLOT);
+
+	VertexTable table;
+	table.m_chars = arrays->chars;
+	table.m_offsets = arrays->offsets;
+	table.m_slots = arrays->slots;
+
+	for (Vertex v = 0; v < names.size(); v++)
+	{
+		size_t slot = Hash(names[v]) & (slotCount - 1);
+		while (arrays->slots[slot] != EMPTY_SLOT)
+		{
+			if (table.name(arrays->slots[slot]) == names[v])
+				throw std::invalid_argument("Invalid argument: Vertex names have to be unique");
+
+			slot = (slot + 1) & (slotCount - 1);
+		}
+
+		arrays->slots[slot] = v;
+	}
+
+	table.m_storage = std::move(arrays);
+	return table;
+}
+
+VertexTable VertexTable::FromArrays(std::span<const char> chars, std::span<const uint64_t> offsets,
+	std::span<const Vertex> slots, std::shared_ptr<const void> storage)
+{
+	if (offsets.empty() || offsets.front() != 0 || offsets.back() != chars.size())
+		throw std::invalid_argument("Invalid argument: Offsets don't describe the names");
+
+	for (size_t v = 0; v + 1 < offsets.size(); v++)
+	{
+		if (offsets[v] > offsets[v + 1])
+			throw std::invalid_argument("Invalid argument: Offsets don't describe the names");
+	}
+
+	if (!std::has_single_bit(slots.size()) || slots.size() < 2 * (offsets.size() - 1))
+		throw std::invalid_argument("Invalid argument: Hash table has to be a power of two at least twice the vertex count");
+
+	VertexTable table;
+	table.m_storage = std::move(storage);
+	table.m_chars = chars;
+	table.m_offsets = offsets;
+	table.m_slots = slots;
+	return table;
+}
+
+std::optional<Vertex> VertexTable::find(std::string_view name) const
+{
+	// bounded by the table length too, so a damaged file can't make it spin forever
+	size_t mask = m_slots.size() - 1;
+	size_t slot = Hash(name) & mask;
+	for (size_t probe = 0; probe < m_slots.size() && m_slots[slot] != EMPTY_SLOT; probe++, slot = (slot + 1) & mask)
+	{
+		Vertex v = m_slots[slot];
+		if (v < size() && this->name(v) == name)
+			return v;
+	}
+
+	return std::nullopt;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#pragma once
+
+#include "CSRGraph.h"
+
+namespace graph
+{
+	// Interned vertex names: the name of v is m_chars[m_offsets[v] .. m_offsets[v + 1])
+	// and m_slots is an open addressing hash table (linear probing, a power of two long,
+	// at most half full) of vertex indices, EMPTY_SLOT marking the free ones. Flat arrays
+	// with a fixed hash, so a table written to a file works straight from its mapping
+	class VertexTable
+	{
+	public:
+		static constexpr Vertex EMPTY_SLOT = std::numeric_limits<Vertex>::max();
+
+		VertexTable();
+
+		// names have to be unique
+		static VertexTable Build(const std::vector<std::string>& names);
+
+		// views arrays laid out as described above without copying them, storage owns their memory.
+		// The offsets are checked in one pass, slots pointing past the vertices are skipped by find
+		static VertexTable FromArrays(std::span<const char> chars, std::span<const uint64_t> offsets,
+			std::span<const Vertex> slots, std::shared_ptr<const void> storage);
+
+		// FNV-1a, the slots in files depend on it so it can never change
+		static uint64_t Hash(std::string_view name);
+
+		size_t size() const { return m_offsets.size() - 1; }
+
+		std::string_view name(Vertex v) const
+		{
+			return { m_chars.data() + m_offsets[v], m_chars.data() + m_offsets[v + 1] };
+		}
+
+		std::optional<Vertex> find(std::string_view name) const;
+
+		std::span<const char> chars() const { return m_chars; }
+		std::span<const uint64_t> offsets() const { return m_offsets; }
+		std::span<const Vertex> slots() const { return m_slots; }
+
+	private:
+		std::shared_ptr<const void> m_storage;
+		std::span<const char> m_chars;
+		std::span<const uint64_t> m_offsets;
+		std::span<const Vertex> m_slots;
+	};
+}
\ No newline at end of file
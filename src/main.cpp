@@ -20,10 +20,13 @@
 //	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 //	SOFTWARE.
 
-#include "SIMDMatrix.h"
+#include "Digraph.h"
+#include "BatchQueries.h"
+#include "ThreadPool.h"
+#include "Kernels.h"
+#include "Profiler.h"
 
 namespace fs = std::filesystem;
-using json = nlohmann::json;
 
 static void logError(const std::string_view content)
 {
@@ -31,140 +34,53 @@ static void logError(const std::string_view content)
 	fmt::print(fmt::fg(fmt::color::red), "{}: {}\n", ERROR_STR, content);
 }
 
-class Digraph
+// "A -> B -> C -> A"
+static std::string formatCycle(const Digraph& digraph, const std::vector<graph::Vertex>& cycle)
 {
-	using LookupTable_t = std::unordered_map<std::string, size_t>;
-	using SIMDMatrix = linear_algebra::SIMDMatrix;
-public:
-	Digraph()
-		: m_verticesCount(0)
-	{ }
-
-	Digraph(size_t verticesCount)
-		: m_verticesCount(verticesCount), m_adjMatrix(verticesCount)
-	{}
-
-	bool isLeadingTo(const std::string_view from, const std::string_view to) const
-	{
-		size_t fvIx, tvIx;
-
-		if (!vertexExists(from) || !vertexExists(to))
-			return false; // wrong vertex was specified
-
-		fvIx = m_lookupTable.at(from.data());
-		tvIx = m_lookupTable.at(to.data());
-
-		auto value = m_adjMatrix.get(fvIx, tvIx);
-		return value == 1.0f;
-	}
+	std::string result;
+	for (graph::Vertex v : cycle)
+		result += fmt::format("{} -> ", digraph.getVertexName(v));
 
-	void findAllPathsWithLength(uint64_t length) const
-	{
-		SIMDMatrix walkMatrix = linear_algebra::pow(m_adjMatrix, length);
-
-		size_t pathCount = 0;
-		for (size_t i = 0; i < walkMatrix.getRowCount(); i++)
-		for (size_t j = 0; j < walkMatrix.getColCount(); j++)
-		{
-			if (i == j)
-				continue;
-
-			float paths = walkMatrix.get(i, j);
-			if (paths > 0.0f)
-			{
-				fmt::print("There are {} paths of length {} from {} to {}\n", paths, static_cast<uint32_t>(length), m_ixToVert.at(i), m_ixToVert.at(j));
-				pathCount++;
-			}
-		}
+	result += digraph.getVertexName(cycle.front());
+	return result;
+}
 
-		fmt::println("{} paths of length {} were found!", pathCount, length);
-	}
+// "A, B, C" with at most limit names, then how many more there are
+static std::string formatMembers(const Digraph& digraph, std::span<const graph::Vertex> members, size_t limit)
+{
+	std::string result;
+	for (size_t i = 0; i < members.size() && i < limit; i++)
+		result += fmt::format("{}{}", i ? ", " : "", digraph.getVertexName(members[i]));
 
-	bool isAcyclic() const
-	{
-		SIMDMatrix walkMatrix = linear_algebra::pow(m_adjMatrix, m_verticesCount);
+	if (members.size() > limit)
+		result += fmt::format(" and {} more", members.size() - limit);
 
-		if (walkMatrix.isZero())
-			return true; 
+	return result;
+}
 
-		return false;
-	}
+// prints or saves what the profiler recorded when main returns, whichever way it does
+struct ProfileReport
+{
+	bool summary = false;
+	std::optional<std::string> tracePath;
 
-	static Digraph fromFile(const std::string_view filepath)
+	~ProfileReport()
 	{
-		std::ifstream file(filepath.data());
+		if (summary)
+			fmt::print(stderr, "{}", profiling::summary());
 
-		json data;
-		try
-		{
-			data = json::parse(file);
-		}
-		catch (const std::runtime_error& e)
-		{
-			throw std::runtime_error("File is not a valid json");
-		}
-
-		if (not data.contains("vertices") || not data.contains("edges"))
-			throw std::runtime_error("Vertices or edges properties are missing");
-
-		if (not data["vertices"].is_array() || not data["edges"].is_array())
-			throw std::runtime_error("Vertices or edges should be defined as arrays of properties");
-
-		const std::vector<std::string_view> vertices = data["vertices"];
-		const std::vector<json> edges = data["edges"];
-
-		if (vertices.size() == 0 || edges.size() == 0)
-			throw std::runtime_error("A graph described in file should have at least 2 vertices and 1 edge");
-
-		Digraph digraph(vertices.size());
-		auto& mat = digraph.m_adjMatrix;
-		auto& lt = digraph.m_lookupTable;
-
-		// not the best solution in terms of complexity, but works.
-		for (const auto& edge : edges)
+		if (tracePath)
 		{
-			if (not edge.contains("from") || not edge.contains("to"))
-				throw std::runtime_error("Missing \"from\" or \"to\" property in edge");
-			
-			std::string from = edge["from"].get<std::string>();
-			std::string to = edge["to"].get<std::string>();
-			auto fvIter = std::find(vertices.begin(), vertices.end(), from);
-			auto tvIter = std::find(vertices.begin(), vertices.end(), to);
-
-			if (fvIter == vertices.end() || tvIter == vertices.end())
-				throw std::runtime_error("Nonexistent vertex specified in an edge description");
-
-			// basically we're figuring out which vertex in order this is
-			size_t fvIx = std::distance(vertices.begin(), fvIter);
-			size_t tvIx = std::distance(vertices.begin(), tvIter);
-
-			mat.set(fvIx, tvIx, 1.0f);
-
-			// lookup table serves for quick matrix col/row index finding,
-			// so we don't need to do searches around the array of vertices
-			digraph.m_ixToVert.try_emplace(fvIx, from);
-			lt.try_emplace(std::move(from), fvIx);
-			digraph.m_ixToVert.try_emplace(tvIx, to);
-			lt.try_emplace(std::move(to), tvIx);
+			try
+			{
+				profiling::writeChromeTrace(*tracePath);
+			}
+			catch (const std::runtime_error& e)
+			{
+				logError(e.what());
+			}
 		}
-
-		return digraph;
-	}
-
-private:
-	bool vertexExists(const std::string_view v) const
-	{
-		if (m_lookupTable.find(v.data()) != m_lookupTable.end())
-			return true;
-
-		return false;
 	}
-
-private:
-	size_t m_verticesCount;
-	SIMDMatrix m_adjMatrix;
-	LookupTable_t m_lookupTable;
-	std::unordered_map<size_t, std::string> m_ixToVert;
 };
 
 static char menu(const std::string_view prompt)
@@ -196,6 +112,47 @@ int main(int argc, char** argv)
 	program.add_argument("desc_file")
 		.help("File describing a digraph (look into manual)")
 		.required();
+	program.add_argument("-t", "--threads")
+		.help("Number of threads used for matrix operations, 0 uses every hardware thread")
+		.default_value(size_t(0))
+		.scan<'u', size_t>();
+	program.add_argument("--strassen-cutoff")
+		.help("Dense modular path counts of graphs with at least this many vertices multiply with Strassen-Winograd, 0 turns it off")
+		.default_value(size_t(linear_algebra::DEFAULT_STRASSEN_CUTOFF))
+		.scan<'u', size_t>();
+	program.add_argument("--isa")
+		.help("Force the instruction set of the matrix kernels: scalar, sse4.2, avx2 or avx512 (the DIGRAPH_ISA environment variable does the same)");
+	program.add_argument("-m", "--modulus")
+		.help("Count paths modulo this number (2 to 2^31 - 1) instead of exactly")
+		.default_value(size_t(0))
+		.scan<'u', size_t>();
+	program.add_argument("-f", "--format")
+		.help("Format of desc_file: json, binary, edges, csv, tsv or mtx. By default it's picked from the file extension");
+	program.add_argument("--cache-mb")
+		.help("Memory for walk matrices kept between queries, in MiB")
+		.default_value(size_t(linear_algebra::DEFAULT_POWER_CACHE_BUDGET >> 20))
+		.scan<'u', size_t>();
+	program.add_argument("-b", "--batch")
+		.help("Answer the queries of this file (- reads them from stdin) instead of showing the menu, see the manual");
+	program.add_argument("--batch-format")
+		.help("Format of the batch results: json or csv")
+		.default_value(std::string("json"));
+	program.add_argument("-r", "--reach-index")
+		.help("Keep the reachability index of the graph in this file, it gets built and saved when the file is missing or belongs to another graph");
+	program.add_argument("-c", "--convert")
+		.help("Save the graph to this file in the binary format, which loads without parsing, and exit");
+	program.add_argument("-o", "--output")
+		.help("Write path results (of the menu or of --batch) to this file instead of stdout");
+	program.add_argument("--counts-only")
+		.help("Print only how many pairs of vertices the walks connect, not every pair")
+		.default_value(false)
+		.implicit_value(true);
+	program.add_argument("--profile")
+		.help("Time every phase and count allocations, products and flops, print a summary to stderr on exit")
+		.default_value(false)
+		.implicit_value(true);
+	program.add_argument("--profile-trace")
+		.help("Profile the same way and write every timed phase to this file as a Chrome trace (chrome://tracing, Perfetto)");
 
 	try
 	{
@@ -207,6 +164,44 @@ int main(int argc, char** argv)
 		return 0;
 	}
 
+	linear_algebra::setThreadCount(program.get<size_t>("--threads"));
+	linear_algebra::setStrassenCutoff(program.get<size_t>("--strassen-cutoff"));
+
+	ProfileReport profileReport;
+	profileReport.tracePath = program.present("--profile-trace");
+	if (program.get<bool>("--profile") || profileReport.tracePath)
+	{
+		if (!profiling::isAvailable())
+		{
+			logError("This build has no profiler, configure it with DIGRAPH_PROFILING on");
+			profileReport.tracePath.reset();
+			return -1;
+		}
+
+		profileReport.summary = program.get<bool>("--profile");
+		profiling::start();
+	}
+
+	if (auto isaName = program.present("--isa"))
+	{
+		linear_algebra::kernels::Isa isa;
+		if (!linear_algebra::kernels::parseIsa(isaName->c_str(), isa))
+		{
+			logError(fmt::format("Unknown instruction set \"{}\"", *isaName));
+			return -1;
+		}
+
+		try
+		{
+			linear_algebra::kernels::selectIsa(isa);
+		}
+		catch (const std::invalid_argument& e)
+		{
+			logError(e.what());
+			return -1;
+		}
+	}
+
 	const std::string descFilePath = program.get<std::string>("desc_file");
 	if (not fs::exists(descFilePath))
 	{
@@ -214,12 +209,22 @@ int main(int argc, char** argv)
 		return -1;
 	}
 
+	graph::GraphFormat format = graph::GraphFormat::Auto;
+	if (auto formatName = program.present("--format"))
+	{
+		if (!graph::parseGraphFormat(formatName->c_str(), format))
+		{
+			logError(fmt::format("Unknown graph format \"{}\"", *formatName));
+			return -1;
+		}
+	}
+
 	// parse
 	Digraph graph;
 
 	try
 	{
-		graph = Digraph::fromFile(descFilePath);
+		graph = Digraph::fromFile(descFilePath, format);
 	}
 	catch (const std::runtime_error& e)
 	{
@@ -227,10 +232,107 @@ int main(int argc, char** argv)
 		return -1;
 	}
 
+	if (auto binaryPath = program.present("--convert"))
+	{
+		try
+		{
+			graph.saveBinary(*binaryPath);
+		}
+		catch (const std::runtime_error& e)
+		{
+			logError(e.what());
+			return -1;
+		}
+
+		fmt::println("Saved {} vertices and {} edges to {}", graph.getVertexCount(), graph.getEdgeCount(), *binaryPath);
+		return 0;
+	}
+
+	try
+	{
+		graph.setWalkCountModulus(program.get<size_t>("--modulus"));
+	}
+	catch (const std::invalid_argument& e)
+	{
+		logError(e.what());
+		return -1;
+	}
+
+	graph.setWalkCacheBudget(program.get<size_t>("--cache-mb") << 20);
+
+	if (auto reachPath = program.present("--reach-index"))
+	{
+		try
+		{
+			graph.useReachabilityFile(*reachPath);
+		}
+		catch (const std::runtime_error& e)
+		{
+			logError(e.what());
+			return -1;
+		}
+	}
+
+	std::optional<std::string> outputPath = program.present("--output");
+	bool countsOnly = program.get<bool>("--counts-only");
+
+	if (auto batchPath = program.present("--batch"))
+	{
+		batch::OutputFormat outputFormat;
+		if (!batch::parseOutputFormat(program.get<std::string>("--batch-format").c_str(), outputFormat))
+		{
+			logError(fmt::format("Unknown batch format \"{}\"", program.get<std::string>("--batch-format")));
+			return -1;
+		}
+
+		std::ifstream queryFile;
+		if (*batchPath != "-")
+		{
+			queryFile.open(*batchPath);
+			if (!queryFile)
+			{
+				logError("Specified batch file doesn't exist");
+				return -1;
+			}
+		}
+
+		std::ofstream outputFile;
+		if (outputPath)
+		{
+			outputFile.open(*outputPath, std::ios::binary);
+			if (!outputFile)
+			{
+				logError(fmt::format("Can't write to \"{}\"", *outputPath));
+				return -1;
+			}
+		}
+
+		std::istream& queries = *batchPath == "-" ? std::cin : queryFile;
+		batch::run(graph, queries, outputPath ? outputFile : std::cout, outputFormat, countsOnly);
+		return 0;
+	}
+
+	// the file stays open until the menu is left
+	std::unique_ptr<std::FILE, int (*)(std::FILE*)> resultFile(nullptr, std::fclose);
+	if (outputPath)
+	{
+		resultFile.reset(std::fopen(outputPath->c_str(), "w"));
+		if (!resultFile)
+		{
+			logError(fmt::format("Can't write to \"{}\"", *outputPath));
+			return -1;
+		}
+	}
+
+	graph.setResultOutput(resultFile ? resultFile.get() : stdout, countsOnly);
+
 	bool run = true;
 	while (run)
 	{
-		int choice = menu("Choose an action:\n\t1. Look for paths with specified lenght\n\t2. Check wether the graph is acyclic\n\t3. Exit\n\nChoice: ");
+		int choice = menu("Choose an action:\n\t1. Look for paths with specified lenght\n\t2. Check wether the graph is acyclic\n"
+			"\t3. Look for paths with specified length from one vertex\n\t4. Count paths with specified length between two vertices\n"
+			"\t5. Check whether one vertex can reach another\n\t6. Show the strongly connected components\n"
+			"\t7. Add an edge\n\t8. Remove an edge\n\t9. Exit\n\nChoice: ");
 
 		switch (choice)
 		{
@@ -243,13 +345,94 @@ int main(int argc, char** argv)
 
 			break;
 		case '2':
-			if (graph.isAcyclic())
+		{
+			auto order = graph.topologicalOrder();
+			if (order.acyclic)
 				fmt::println("The graph is acyclic");
 			else
-				fmt::println("The graph is not acyclic");
+				fmt::println("The graph is not acyclic, it contains the cycle {}", formatCycle(graph, order.cycle));
 
 			break;
+		}
 		case '3':
+		{
+			std::string from;
+			uint64_t length;
+			fmt::print("From: ");
+			std::getline(std::cin, from);
+			fmt::print("Length: ");
+			std::cin >> length;
+
+			graph.findPathsFrom(from, length);
+			break;
+		}
+		case '4':
+		{
+			std::string from, to;
+			uint64_t length;
+			fmt::print("From: ");
+			std::getline(std::cin, from);
+			fmt::print("To: ");
+			std::getline(std::cin, to);
+			fmt::print("Length: ");
+			std::cin >> length;
+
+			graph.findPathsBetween(from, to, length);
+			break;
+		}
+		case '5':
+		{
+			std::string from, to;
+			fmt::print("From: ");
+			std::getline(std::cin, from);
+			fmt::print("To: ");
+			std::getline(std::cin, to);
+
+			if (!graph.findVertex(from) || !graph.findVertex(to))
+				fmt::println("There is no vertex {}", graph.findVertex(from) ? to : from);
+			else
+				fmt::println("{} {} reach {}", from, graph.canReach(from, to) ? "can" : "can't", to);
+
+			break;
+		}
+		case '6':
+		{
+			const graph::StronglyConnectedComponents& components = graph.components();
+			fmt::println("{} strongly connected components, {} of them with cycles", components.getComponentCount(), components.getCyclicCount());
+
+			for (uint32_t c = 0; c < components.getComponentCount(); c++)
+			{
+				if (!components.cyclic[c])
+					continue;
+
+				std::span<const graph::Vertex> members = components.componentMembers(c);
+				fmt::println("{} vertices: {}", members.size(), formatMembers(graph, members, 10));
+				fmt::println("\tcycle {}", formatCycle(graph, graph.componentCycle(c)));
+			}
+
+			graph::CSRGraph dag = graph.condensation();
+			fmt::println("The condensation has {} vertices and {} edges", dag.getVertexCount(), dag.getEdgeCount());
+			break;
+		}
+		case '7':
+		case '8':
+		{
+			std::string from, to;
+			fmt::print("From: ");
+			std::getline(std::cin, from);
+			fmt::print("To: ");
+			std::getline(std::cin, to);
+
+			if (!graph.findVertex(from) || !graph.findVertex(to))
+				fmt::println("There is no vertex {}", graph.findVertex(from) ? to : from);
+			else if (choice == '7')
+				fmt::println("{}", graph.insertEdge(from, to) ? "Added the edge" : "The edge is already there");
+			else
+				fmt::println("{}", graph.removeEdge(from, to) ? "Removed the edge" : "There is no such edge");
+
+			break;
+		}
+		case '9':
 			run = false;
 			break;
 		default:
@@ -15,5 +15,34 @@
 #include <filesystem>
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <utility>
+#include <bit>
+#include <span>
+#include <optional>
+#include <limits>
+#include <numeric>
+#include <variant>
+#include <type_traits>
+#include <map>
+#include <list>
+#include <charconv>
+#include <cctype>
 
-#include <immintrin.h>
\ No newline at end of file
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
\ No newline at end of file
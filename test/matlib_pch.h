@@ -4,4 +4,43 @@
 #include <stdexcept>
 #include <cassert>
 #include <cstdlib>
-#include <cstring>
\ No newline at end of file
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <utility>
+#include <bit>
+#include <span>
+#include <optional>
+#include <limits>
+#include <numeric>
+#include <variant>
+#include <type_traits>
+#include <map>
+#include <list>
+#include <charconv>
+#include <cctype>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <istream>
+#include <fstream>
+#include <string_view>
+#include <cstddef>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <sstream>
+#include "BatchQueries.h"
+
+// a -> new york -> say "hi" -> x,y, names that need escaping in both formats
+static Digraph loadChain()
+{
+	std::string path = (std::filesystem::temp_directory_path() / "digraph_batch.json").string();
+	std::ofstream(path) << R"({
+		"vertices": [ "a", "new york", "say \"hi\"", "x,y" ],
+		"edges": [ { "from": "a", "to": "new york" }, { "from": "new york", "to": "say \"hi\"" }, { "from": "say \"hi\"", "to": "x,y" } ]
+	})";
+
+	Digraph digraph = Digraph::fromFile(path, graph::GraphFormat::Json);
+	std::filesystem::remove(path);
+	return digraph;
+}
+
+static std::string runBatch(const std::string& queries, batch::OutputFormat format, bool countsOnly = false)
+{
+	Digraph digraph = loadChain();
+	std::istringstream input(queries);
+	std::ostringstream output;
+	batch::run(digraph, input, output, format, countsOnly);
+	return output.str();
+}
+
+// the insert splits the batch in two stretches, the paths of each see their own graph
+static const char* QUERIES =
+	"# walks of the chain\n"
+	"\n"
+	"paths 1 2\n"
+	"paths-between \"new york\" \"x,y\" 2\n"
+	"paths-from a 1\n"
+	"reaches \"x,y\" a\n"
+	"bogus 1\n"
+	"paths x\n"
+	"insert \"x,y\" a\n"
+	"  # an indented comment\r\n"
+	"paths 1\n"
+	"reaches \"x,y\" a\n"
+	"remove a \"new york\"\n"
+	"paths-between a \"new york\" 1\n"
+	"leads nobody a\n"
+	"leads \"a\n";
+
+TEST(BatchQueries, Json)
+{
+	EXPECT_EQ(runBatch(QUERIES, batch::OutputFormat::Json),
+		"{\"vertices\":4,\"edges\":3,\"modulus\":0,\"results\":[\n"
+		R"({"line":3,"query":"paths","length":1,"walks":[{"from":"a","to":"new york","count":1},{"from":"new york","to":"say \"hi\"","count":1},{"from":"say \"hi\"","to":"x,y","count":1}],"pairs":3},)" "\n"
+		R"({"line":3,"query":"paths","length":2,"walks":[{"from":"a","to":"say \"hi\"","count":1},{"from":"new york","to":"x,y","count":1}],"pairs":2},)" "\n"
+		R"({"line":4,"query":"paths-between","from":"new york","to":"x,y","length":2,"connected":true,"count":1},)" "\n"
+		R"({"line":5,"query":"paths-from","length":1,"walks":[{"from":"a","to":"new york","count":1}],"pairs":1},)" "\n"
+		R"({"line":6,"query":"reaches","from":"x,y","to":"a","reaches":false},)" "\n"
+		R"({"line":7,"query":"error","error":"Unknown query \"bogus\""},)" "\n"
+		R"({"line":8,"query":"error","error":"Invalid length \"x\""},)" "\n"
+		R"({"line":9,"query":"insert","from":"x,y","to":"a","changed":true},)" "\n"
+		R"({"line":11,"query":"paths","length":1,"walks":[{"from":"a","to":"new york","count":1},{"from":"new york","to":"say \"hi\"","count":1},{"from":"say \"hi\"","to":"x,y","count":1},{"from":"x,y","to":"a","count":1}],"pairs":4},)" "\n"
+		R"({"line":12,"query":"reaches","from":"x,y","to":"a","reaches":true},)" "\n"
+		R"({"line":13,"query":"remove","from":"a","to":"new york","changed":true},)" "\n"
+		R"({"line":14,"query":"paths-between","from":"a","to":"new york","length":1,"connected":false,"count":0},)" "\n"
+		R"({"line":15,"query":"error","error":"Nonexistent vertex specified in a query"},)" "\n"
+		R"({"line":16,"query":"error","error":"Unterminated quoted name"})" "\n"
+		"]}\n");
+}
+
+TEST(BatchQueries, Csv)
+{
+	EXPECT_EQ(runBatch(QUERIES, batch::OutputFormat::Csv),
+		"line,query,length,from,to,value\n"
+		"3,paths,1,a,new york,1\n"
+		"3,paths,1,new york,\"say \"\"hi\"\"\",1\n"
+		"3,paths,1,\"say \"\"hi\"\"\",\"x,y\",1\n"
+		"3,paths,1,,,3\n"
+		"3,paths,2,a,\"say \"\"hi\"\"\",1\n"
+		"3,paths,2,new york,\"x,y\",1\n"
+		"3,paths,2,,,2\n"
+		"4,paths-between,2,new york,\"x,y\",1\n"
+		"5,paths-from,1,a,new york,1\n"
+		"5,paths-from,1,,,1\n"
+		"6,reaches,,\"x,y\",a,false\n"
+		"7,error,,,,\"Unknown query \"\"bogus\"\"\"\n"
+		"8,error,,,,\"Invalid length \"\"x\"\"\"\n"
+		"9,insert,,\"x,y\",a,true\n"
+		"11,paths,1,a,new york,1\n"
+		"11,paths,1,new york,\"say \"\"hi\"\"\",1\n"
+		"11,paths,1,\"say \"\"hi\"\"\",\"x,y\",1\n"
+		"11,paths,1,\"x,y\",a,1\n"
+		"11,paths,1,,,4\n"
+		"12,reaches,,\"x,y\",a,true\n"
+		"13,remove,,a,new york,true\n"
+		"14,paths-between,1,a,new york,\n"
+		"15,error,,,,Nonexistent vertex specified in a query\n"
+		"16,error,,,,Unterminated quoted name\n");
+}
+
+TEST(BatchQueries, CountsOnly)
+{
+	EXPECT_EQ(runBatch("paths 2\npaths-from \"new york\" 1 2\n", batch::OutputFormat::Json, true),
+		"{\"vertices\":4,\"edges\":3,\"modulus\":0,\"results\":[\n"
+		R"({"line":1,"query":"paths","length":2,"pairs":2},)" "\n"
+		R"({"line":2,"query":"paths-from","length":1,"pairs":1},)" "\n"
+		R"({"line":2,"query":"paths-from","length":2,"pairs":1})" "\n"
+		"]}\n");
+
+	EXPECT_EQ(runBatch("paths 2\n", batch::OutputFormat::Csv, true), "line,query,length,from,to,value\n1,paths,2,,,2\n");
+}
+
+// lines of nothing but whitespace tokenize splits on are skipped like blank ones
+TEST(BatchQueries, WhitespaceLines)
+{
+	EXPECT_EQ(runBatch("\f\n\v \n \t\r\npaths 1\n", batch::OutputFormat::Csv, true), "line,query,length,from,to,value\n4,paths,1,,,3\n");
+}
\ No newline at end of file
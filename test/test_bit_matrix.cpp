@@ -0,0 +1,156 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <random>
+#include "BitMatrix.h"
+
+using BitMatrix = linear_algebra::BitMatrix;
+
+static std::mt19937 bitTwister(std::random_device{}());
+
+static BitMatrix genRandBitMatrix(size_t rows, size_t cols, double density)
+{
+	BitMatrix mat(rows, cols);
+	std::bernoulli_distribution dist(density);
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < cols; j++)
+	{
+		if (dist(bitTwister))
+			mat.set(i, j, true);
+	}
+
+	return mat;
+}
+
+static BitMatrix naiveBoolMultiplication(const BitMatrix& lhs, const BitMatrix& rhs)
+{
+	BitMatrix result(lhs.getRowCount(), rhs.getColCount());
+
+	for (size_t i = 0; i < result.getRowCount(); i++)
+	for (size_t j = 0; j < result.getColCount(); j++)
+	{
+		bool any = false;
+		for (size_t k = 0; k < lhs.getColCount() && !any; k++)
+			any = lhs.get(i, k) && rhs.get(k, j);
+
+		result.set(i, j, any);
+	}
+
+	return result;
+}
+
+static void expectEqual(const BitMatrix& lhs, const BitMatrix& rhs)
+{
+	ASSERT_EQ(lhs.getRowCount(), rhs.getRowCount());
+	ASSERT_EQ(lhs.getColCount(), rhs.getColCount());
+
+	for (size_t r = 0; r < lhs.getRowCount(); r++)
+	for (size_t c = 0; c < lhs.getColCount(); c++)
+		ASSERT_EQ(lhs.get(r, c), rhs.get(r, c)) << "at " << r << ", " << c;
+}
+
+TEST(BitMatrix, SetGetCount)
+{
+	BitMatrix mat(70, 300);
+	EXPECT_TRUE(mat.isZero());
+
+	mat.set(0, 0, true);
+	mat.set(69, 299, true);
+	mat.set(12, 64, true);
+	mat.set(12, 64, true);
+
+	EXPECT_FALSE(mat.isZero());
+	EXPECT_EQ(mat.count(), 3u);
+	EXPECT_TRUE(mat.get(12, 64));
+	EXPECT_FALSE(mat.get(12, 63));
+
+	std::vector<std::pair<size_t, size_t>> visited;
+	mat.forEachSetBit([&](size_t r, size_t c) { visited.emplace_back(r, c); });
+	ASSERT_EQ(visited.size(), 3u);
+	EXPECT_EQ(visited[1], std::make_pair(size_t(12), size_t(64)));
+
+	mat.set(12, 64, false);
+	mat.set(0, 0, false);
+	mat.set(69, 299, false);
+	EXPECT_TRUE(mat.isZero());
+
+	EXPECT_THROW(mat.get(70, 0), std::out_of_range);
+}
+
+TEST(BitMatrix, Or)
+{
+	BitMatrix lhs = genRandBitMatrix(70, 300, 0.1);
+	BitMatrix rhs = genRandBitMatrix(70, 300, 0.1);
+
+	BitMatrix result = lhs;
+	result |= rhs;
+
+	for (size_t r = 0; r < 70; r++)
+	for (size_t c = 0; c < 300; c++)
+		ASSERT_EQ(result.get(r, c), lhs.get(r, c) || rhs.get(r, c)) << "at " << r << ", " << c;
+
+	EXPECT_THROW(result |= BitMatrix(70, 299), std::invalid_argument);
+}
+
+TEST(BitMatrix, Multiplication)
+{
+	for (size_t i = 1; i <= 70; i += 3)
+	for (size_t j = 1; j <= 70; j += 7)
+	{
+		BitMatrix mat1 = genRandBitMatrix(i, j, 0.1);
+		BitMatrix mat2 = genRandBitMatrix(j, 300 - 3 * i, 0.1);
+
+		expectEqual(mat1 * mat2, naiveBoolMultiplication(mat1, mat2));
+	}
+}
+
+TEST(BitMatrix, Power)
+{
+	for (size_t size : { 1, 2, 9, 64, 65, 130 })
+	{
+		BitMatrix mat = genRandBitMatrix(size, size, 2.0 / size);
+		BitMatrix resCmp = BitMatrix::Identity(size);
+
+		for (uint64_t p = 0; p <= 12; p++)
+		{
+			expectEqual(linear_algebra::pow(mat, p), resCmp);
+			resCmp = naiveBoolMultiplication(resCmp, mat);
+		}
+	}
+}
+
+TEST(BitMatrix, CycleNeverVanishes)
+{
+	// a cycle keeps walks of every length alive, a chain dies after its length
+	size_t size = 300;
+	BitMatrix chain(size);
+	for (size_t i = 0; i + 1 < size; i++)
+		chain.set(i, i + 1, true);
+
+	EXPECT_FALSE(linear_algebra::pow(chain, size - 1).isZero());
+	EXPECT_TRUE(linear_algebra::pow(chain, size).isZero());
+
+	chain.set(size - 1, 0, true);
+	EXPECT_EQ(linear_algebra::pow(chain, 1000).count(), size);
+}
\ No newline at end of file
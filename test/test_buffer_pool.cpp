@@ -0,0 +1,133 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include "BufferPool.h"
+#include "SIMDMatrix.h"
+
+using BufferPool = linear_algebra::BufferPool;
+using SIMDMatrix = linear_algebra::SIMDMatrix;
+
+TEST(BufferPool, SizeClasses)
+{
+	EXPECT_EQ(BufferPool::sizeClass(1), 64u);
+	EXPECT_EQ(BufferPool::sizeClass(64), 64u);
+	EXPECT_EQ(BufferPool::sizeClass(65), 128u);
+	EXPECT_EQ(BufferPool::sizeClass(1000), 1024u);
+	EXPECT_EQ(BufferPool::sizeClass(1025), 1280u);
+
+	// past a few cache lines never more than a quarter of waste
+	for (size_t bytes = 257; bytes < (1 << 20); bytes = bytes * 3 / 2 + 7)
+	{
+		size_t capacity = BufferPool::sizeClass(bytes);
+		EXPECT_GE(capacity, bytes);
+		EXPECT_LE(capacity, bytes + bytes / 4);
+		EXPECT_EQ(capacity % BufferPool::POOL_ALIGNMENT, 0u);
+	}
+}
+
+TEST(BufferPool, RecyclesBlocks)
+{
+	BufferPool pool;
+
+	void* first = pool.allocate(5000);
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % BufferPool::POOL_ALIGNMENT, 0u);
+	pool.release(first, 5000);
+
+	// same size class, so the block comes back
+	void* second = pool.allocate(4900);
+	EXPECT_EQ(second, first);
+	pool.release(second, 4900);
+
+	void* huge = pool.allocate(3 * BufferPool::HUGE_BLOCK_SIZE);
+	ASSERT_NE(huge, nullptr);
+	static_cast<char*>(huge)[3 * BufferPool::HUGE_BLOCK_SIZE - 1] = 1;
+	pool.release(huge, 3 * BufferPool::HUGE_BLOCK_SIZE);
+
+	linear_algebra::BufferPoolStats stats = pool.stats();
+	EXPECT_EQ(stats.allocations, 3u);
+	EXPECT_EQ(stats.poolHits, 1u);
+	EXPECT_EQ(stats.systemAllocations, 2u);
+	EXPECT_EQ(stats.bytesInUse, 0u);
+	EXPECT_EQ(stats.bytesCached, BufferPool::sizeClass(5000) + BufferPool::sizeClass(3 * BufferPool::HUGE_BLOCK_SIZE));
+
+	pool.setCacheLimit(0);
+	EXPECT_EQ(pool.stats().bytesCached, 0u);
+
+	void* uncached = pool.allocate(5000);
+	pool.release(uncached, 5000);
+	EXPECT_EQ(pool.stats().bytesCached, 0u);
+	EXPECT_EQ(pool.stats().poolHits, 1u);
+}
+
+TEST(BufferPool, WarmPowerDoesNotAllocate)
+{
+	SIMDMatrix mat(70);
+	for (size_t i = 0; i < 70; i++)
+		mat.set(i, (i * 7 + 3) % 70, 1.0f);
+
+	auto workload = [&]()
+	{
+		SIMDMatrix result = linear_algebra::pow(mat, 37);
+		result *= mat;
+		result += result * mat;
+	};
+
+	// the first run fills the free lists, the second one should only take from them
+	BufferPool& pool = BufferPool::Global();
+	workload();
+	pool.resetStats();
+	workload();
+
+	linear_algebra::BufferPoolStats stats = pool.stats();
+	EXPECT_GT(stats.allocations, 0u);
+	EXPECT_EQ(stats.systemAllocations, 0u);
+	EXPECT_EQ(stats.poolHits, stats.allocations);
+}
+
+TEST(BufferPool, UninitializedKeepsPaddingZero)
+{
+	// leave garbage behind in a block of the size class used below
+	{
+		SIMDMatrix dirty(13, 13, linear_algebra::Uninitialized);
+		for (size_t i = 0; i < 13; i++)
+		for (size_t j = 0; j < 13; j++)
+			dirty.set(i, j, 7.0f);
+
+		SIMDMatrix wide(13, 16);
+		for (size_t i = 0; i < 13; i++)
+		for (size_t j = 0; j < 16; j++)
+			wide.set(i, j, 5.0f);
+	}
+
+	SIMDMatrix lhs = SIMDMatrix::Identity(13);
+	SIMDMatrix product(13, 13, linear_algebra::Uninitialized);
+	linear_algebra::multiplyInto(lhs, lhs, product);
+
+	for (size_t i = 0; i < 13; i++)
+	for (size_t j = 0; j < 13; j++)
+		EXPECT_EQ(product.get(i, j), i == j ? 1.0f : 0.0f);
+
+	EXPECT_FALSE(product.isZero());
+	EXPECT_TRUE((product * 0.0f).isZero());
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <random>
+#include "CountMatrix.h"
+#include "SparseMatrix.h"
+
+using CountMatrix = linear_algebra::CountMatrix;
+using SparseCountMatrix = linear_algebra::SparseCountMatrix;
+using CountArithmetic = linear_algebra::CountArithmetic;
+
+static std::mt19937_64 countTwister(std::random_device{}());
+
+static CountMatrix genRandCountMatrix(size_t rows, size_t cols, uint64_t maxValue, double density = 1.0)
+{
+	CountMatrix mat(rows, cols);
+	std::uniform_int_distribution<uint64_t> value(0, maxValue);
+	std::bernoulli_distribution present(density);
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < cols; j++)
+	{
+		if (present(countTwister))
+			mat.set(i, j, value(countTwister));
+	}
+
+	return mat;
+}
+
+// reference product in 128-bit arithmetic, clamped or reduced at the end
+static CountMatrix naiveCountMultiplication(const CountMatrix& lhs, const CountMatrix& rhs, CountArithmetic arithmetic)
+{
+	CountMatrix result(lhs.getRowCount(), rhs.getColCount());
+
+	for (size_t i = 0; i < result.getRowCount(); i++)
+	for (size_t j = 0; j < result.getColCount(); j++)
+	{
+		unsigned __int128 sum = 0;
+		bool saturated = false;
+
+		for (size_t k = 0; k < lhs.getColCount(); k++)
+		{
+			unsigned __int128 product = static_cast<unsigned __int128>(lhs.get(i, k)) * rhs.get(k, j);
+			if (arithmetic.isModular())
+				sum = (sum + product) % arithmetic.modulus;
+			else if ((sum += product) > linear_algebra::COUNT_SATURATED)
+				saturated = true;
+		}
+
+		result.set(i, j, saturated ? linear_algebra::COUNT_SATURATED : static_cast<uint64_t>(sum));
+	}
+
+	return result;
+}
+
+static void expectEqual(const CountMatrix& lhs, const CountMatrix& rhs)
+{
+	ASSERT_EQ(lhs.getRowCount(), rhs.getRowCount());
+	ASSERT_EQ(lhs.getColCount(), rhs.getColCount());
+
+	for (size_t i = 0; i < lhs.getRowCount(); i++)
+	for (size_t j = 0; j < lhs.getColCount(); j++)
+		ASSERT_EQ(lhs.get(i, j), rhs.get(i, j)) << "at " << i << ", " << j;
+}
+
+TEST(CountMatrix, SaturatingMultiplication)
+{
+	// small values, values that need the 32x32 bit split and ones that take the scalar path
+	for (uint64_t maxValue : std::initializer_list<uint64_t>{ 3, 1ull << 31, 1ull << 33, linear_algebra::COUNT_SATURATED })
+	for (size_t i = 1; i <= 40; i += 13)
+	for (size_t j = 1; j <= 40; j += 9)
+	{
+		CountMatrix mat1 = genRandCountMatrix(i, j, maxValue, 0.7);
+		CountMatrix mat2 = genRandCountMatrix(j, 45 - i, maxValue, 0.7);
+
+		CountMatrix product;
+		linear_algebra::multiplyInto(mat1, mat2, product);
+		expectEqual(product, naiveCountMultiplication(mat1, mat2, {}));
+	}
+}
+
+TEST(CountMatrix, ModularMultiplication)
+{
+	// long inner dimensions make the accumulators cross 2^63 a couple of times
+	for (uint64_t modulus : std::initializer_list<uint64_t>{ 2, 7, 1000000007, linear_algebra::MAX_COUNT_MODULUS })
+	for (size_t k : { 1, 5, 300 })
+	{
+		CountMatrix mat1 = genRandCountMatrix(17, k, modulus - 1);
+		CountMatrix mat2 = genRandCountMatrix(k, 22, modulus - 1);
+
+		CountMatrix product;
+		linear_algebra::multiplyInto(mat1, mat2, product, { modulus });
+		expectEqual(product, naiveCountMultiplication(mat1, mat2, { modulus }));
+	}
+
+	CountMatrix mat(2), product;
+	EXPECT_THROW(linear_algebra::multiplyInto(mat, mat, product, { 1 }), std::invalid_argument);
+	EXPECT_THROW(linear_algebra::multiplyInto(mat, mat, product, { 1ull << 31 }), std::invalid_argument);
+}
+
+TEST(CountMatrix, ExactWalkCounts)
+{
+	// every power of the all-ones n x n matrix is n^(p - 1) everywhere,
+	// 3^40 is way past what a float holds exactly and 3^41 doesn't fit into 64 bits
+	CountMatrix ones(3);
+	for (size_t i = 0; i < 3; i++)
+	for (size_t j = 0; j < 3; j++)
+		ones.set(i, j, 1);
+
+	uint64_t expected = 1;
+	for (uint64_t p = 1; p <= 41; p++)
+	{
+		CountMatrix walks = linear_algebra::pow(ones, p);
+		EXPECT_EQ(walks.get(2, 1), expected);
+		EXPECT_FALSE(walks.anySaturated());
+		expected *= 3;
+	}
+
+	CountMatrix saturated = linear_algebra::pow(ones, 42);
+	EXPECT_TRUE(saturated.anySaturated());
+	EXPECT_EQ(saturated.get(0, 0), linear_algebra::COUNT_SATURATED);
+
+	// 3^99 mod 1000000007
+	uint64_t residue = 1;
+	for (int p = 0; p < 99; p++)
+		residue = residue * 3 % 1000000007;
+
+	EXPECT_EQ(linear_algebra::pow(ones, 100, { 1000000007 }).get(1, 2), residue);
+	EXPECT_TRUE(linear_algebra::pow(ones, 0).get(1, 1) == 1 && linear_algebra::pow(ones, 0).get(1, 2) == 0);
+}
+
+TEST(CountMatrix, StrassenModular)
+{
+	size_t previousCutoff = linear_algebra::getStrassenCutoff();
+	linear_algebra::setStrassenCutoff(16);
+
+	for (auto [rows, inner, cols] : { std::tuple<size_t, size_t, size_t>{ 64, 64, 64 }, { 150, 133, 141 }, { 37, 200, 90 } })
+	{
+		CountMatrix mat1 = genRandCountMatrix(rows, inner, 1ull << 40, 0.5);
+		CountMatrix mat2 = genRandCountMatrix(inner, cols, 1ull << 40, 0.5);
+
+		// residues are exact, saturating products never take Strassen-Winograd
+		for (CountArithmetic arithmetic : { CountArithmetic{}, CountArithmetic{ 13 }, CountArithmetic{ linear_algebra::MAX_COUNT_MODULUS } })
+		{
+			CountMatrix lhs = linear_algebra::pow(mat1, 1, arithmetic);
+			CountMatrix rhs = linear_algebra::pow(mat2, 1, arithmetic);
+
+			CountMatrix product;
+			linear_algebra::multiplyInto(lhs, rhs, product, arithmetic);
+			expectEqual(product, naiveCountMultiplication(lhs, rhs, arithmetic));
+		}
+	}
+
+	linear_algebra::setStrassenCutoff(previousCutoff);
+}
+
+TEST(CountMatrix, SparsePowerMatchesDense)
+{
+	CountMatrix adjacency = genRandCountMatrix(60, 60, 1, 0.1);
+	SparseCountMatrix sparse = SparseCountMatrix::FromDense(adjacency);
+
+	for (CountArithmetic arithmetic : { CountArithmetic{}, CountArithmetic{ 13 } })
+	for (uint64_t p : std::initializer_list<uint64_t>{ 0, 1, 2, 5, 30, 64 })
+	{
+		CountMatrix dense = linear_algebra::pow(adjacency, p, arithmetic);
+		expectEqual(linear_algebra::pow(sparse, p, arithmetic).toDense(), dense);
+	}
+}
+
+TEST(CountMatrix, ByteProductWidens)
+{
+	// 300 x 300 ones, every entry of the square (300) is past what a byte holds
+	linear_algebra::ByteMatrix ones(300);
+	for (size_t i = 0; i < 300; i++)
+	for (size_t j = 0; j < 300; j++)
+		ones.set(i, j, 1);
+
+	CountMatrix square = ones * ones;
+	EXPECT_EQ(square.get(0, 0), 300u);
+	EXPECT_EQ(square.get(299, 17), 300u);
+
+	CountMatrix widened(ones);
+	expectEqual(linear_algebra::pow(widened, 2), square);
+	EXPECT_EQ(linear_algebra::pow(square, 2).get(5, 5), 300ull * 300 * 300);
+}
+
+TEST(CountMatrix, MultiplyAddInto)
+{
+	CountMatrix mat1 = genRandCountMatrix(20, 30, 1000, 0.5);
+	CountMatrix mat2 = genRandCountMatrix(30, 25, 1000, 0.5);
+
+	for (CountArithmetic arithmetic : { CountArithmetic{}, CountArithmetic{ 13 } })
+	{
+		CountMatrix acc = linear_algebra::pow(genRandCountMatrix(20, 25, 1000, 0.5), 1, arithmetic);
+		CountMatrix expected = acc;
+
+		CountMatrix product = naiveCountMultiplication(mat1, mat2, arithmetic);
+		for (size_t i = 0; i < 20; i++)
+		for (size_t j = 0; j < 25; j++)
+		{
+			uint64_t sum = expected.get(i, j) + product.get(i, j);
+			expected.set(i, j, arithmetic.isModular() ? sum % arithmetic.modulus : sum);
+		}
+
+		CountMatrix lhs = linear_algebra::pow(mat1, 1, arithmetic);
+		CountMatrix rhs = linear_algebra::pow(mat2, 1, arithmetic);
+		linear_algebra::multiplyAddInto(lhs, rhs, acc, arithmetic);
+		expectEqual(acc, expected);
+	}
+
+	// a product that saturates keeps the accumulator stuck at the maximum
+	CountMatrix big(1, 1), acc(1, 1);
+	big.set(0, 0, 1ull << 40);
+	acc.set(0, 0, 5);
+	linear_algebra::multiplyAddInto(big, big, acc);
+	EXPECT_EQ(acc.get(0, 0), linear_algebra::COUNT_SATURATED);
+}
+
+TEST(CountMatrix, ForEachNonZero)
+{
+	// 70 columns leave part of a mask word unused
+	CountMatrix mat = genRandCountMatrix(33, 70, 1000, 0.05);
+
+	std::vector<std::tuple<size_t, size_t, uint64_t>> expected, visited;
+	for (size_t i = 0; i < 33; i++)
+	for (size_t j = 0; j < 70; j++)
+	{
+		if (mat.get(i, j) != 0)
+			expected.emplace_back(i, j, mat.get(i, j));
+	}
+
+	EXPECT_EQ(mat.isZero(), expected.empty());
+	mat.forEachNonZero([&](size_t row, size_t col, uint64_t value) { visited.emplace_back(row, col, value); });
+	EXPECT_EQ(visited, expected);
+
+	std::vector<std::tuple<size_t, size_t, uint64_t>> rowVisited;
+	for (size_t i = 0; i < 33; i++)
+		mat.forEachNonZeroInRow(i, [&](size_t col, uint64_t value) { rowVisited.emplace_back(i, col, value); });
+	EXPECT_EQ(rowVisited, expected);
+
+	CountMatrix zero(33, 70);
+	EXPECT_TRUE(zero.isZero());
+	zero.set(32, 69, 1);
+	EXPECT_FALSE(zero.isZero());
+}
\ No newline at end of file
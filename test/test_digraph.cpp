@@ -0,0 +1,445 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <random>
+#include "Digraph.h"
+#include "Profiler.h"
+
+using Edges = std::vector<std::pair<size_t, size_t>>;
+using WalkCounts = std::map<std::pair<size_t, size_t>, uint64_t>;
+
+static std::string tempPath(const std::string& name)
+{
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::string vertexName(size_t v)
+{
+	return fmt::format("v{}", v);
+}
+
+// vertices v0, v1, ... in index order, loaded from a JSON description like any other graph
+static Digraph loadDigraph(size_t verticesCount, const Edges& edges, uint64_t modulus = 0)
+{
+	nlohmann::json description = { { "vertices", nlohmann::json::array() }, { "edges", nlohmann::json::array() } };
+	for (size_t v = 0; v < verticesCount; v++)
+		description["vertices"].push_back(vertexName(v));
+	for (const auto& [from, to] : edges)
+		description["edges"].push_back({ { "from", vertexName(from) }, { "to", vertexName(to) } });
+
+	std::string path = tempPath("digraph_test.json");
+	std::ofstream(path) << description.dump();
+	Digraph digraph = Digraph::fromFile(path, graph::GraphFormat::Json);
+	std::filesystem::remove(path);
+
+	digraph.setWalkCountModulus(modulus);
+	return digraph;
+}
+
+// edges only go from lower to higher indices, so the graph is acyclic
+static Edges randomDag(size_t verticesCount, double density, uint64_t seed)
+{
+	std::mt19937_64 twister(seed);
+	std::bernoulli_distribution present(density);
+
+	Edges edges;
+	for (size_t i = 0; i < verticesCount; i++)
+	for (size_t j = i + 1; j < verticesCount; j++)
+	{
+		if (present(twister))
+			edges.emplace_back(i, j);
+	}
+
+	return edges;
+}
+
+static WalkCounts walksOf(const Digraph& digraph, uint64_t length)
+{
+	WalkCounts walks;
+	digraph.forEachWalk(length, [&](size_t from, size_t to, uint64_t count) { walks[{ from, to }] = count; });
+	return walks;
+}
+
+static void expectSameGraph(const Digraph& edited, const Digraph& loaded, std::span<const uint64_t> lengths)
+{
+	for (uint64_t length : lengths)
+		EXPECT_EQ(walksOf(edited, length), walksOf(loaded, length)) << "length " << length;
+
+	EXPECT_EQ(edited.isAcyclic(), loaded.isAcyclic());
+
+	for (size_t i = 0; i < loaded.getVertexCount(); i++)
+	for (size_t j = 0; j < loaded.getVertexCount(); j++)
+		EXPECT_EQ(edited.canReach(i, j), loaded.canReach(i, j)) << i << " -> " << j;
+}
+
+TEST(Digraph, EditsMatchReloadedGraph)
+{
+	// a dense DAG keeps its walk matrices across forward edges, a sparse one drops them
+	const std::pair<size_t, double> shapes[] = { { 16, 0.3 }, { 90, 0.03 } };
+	const uint64_t lengths[] = { 1, 2, 3, 4, 5, 8, 13, 16 };
+
+	// 8 KiB keeps short walk matrices of the dense DAG but not the memory to update the longest
+	for (const auto& [verticesCount, density] : shapes)
+	for (uint64_t modulus : { 0ull, 13ull })
+	for (size_t budget : { linear_algebra::DEFAULT_POWER_CACHE_BUDGET, size_t(8) << 10 })
+	{
+		SCOPED_TRACE(testing::Message() << verticesCount << " vertices, modulus " << modulus << ", budget " << budget);
+
+		Edges edges = randomDag(verticesCount, density, verticesCount);
+		Digraph digraph = loadDigraph(verticesCount, edges, modulus);
+		digraph.setWalkCacheBudget(budget);
+
+		// lengths 1..5 and 13 = 8 + 4 + 1 fill the cache with powers and the squaring ladder,
+		// the order and the reachability index get built too
+		expectSameGraph(digraph, loadDigraph(verticesCount, edges, modulus), lengths);
+
+		// forward edge, the graph stays acyclic and cached walks get updated in place
+		size_t from = 0, to = verticesCount - 1;
+		while (std::find(edges.begin(), edges.end(), std::pair(from, to)) != edges.end())
+			from++;
+
+		ASSERT_TRUE(digraph.insertEdge(from, to));
+		EXPECT_FALSE(digraph.insertEdge(from, to));
+		edges.emplace_back(from, to);
+		expectSameGraph(digraph, loadDigraph(verticesCount, edges, modulus), lengths);
+
+		// back edge of an existing one closes a cycle
+		ASSERT_TRUE(digraph.insertEdge(edges.front().second, edges.front().first));
+		edges.emplace_back(edges.front().second, edges.front().first);
+		expectSameGraph(digraph, loadDigraph(verticesCount, edges, modulus), lengths);
+
+		// and removing that edge of the DAG breaks it again
+		ASSERT_TRUE(digraph.removeEdge(edges.front().first, edges.front().second));
+		EXPECT_FALSE(digraph.removeEdge(edges.front().first, edges.front().second));
+		edges.erase(edges.begin());
+		expectSameGraph(digraph, loadDigraph(verticesCount, edges, modulus), lengths);
+	}
+}
+
+// any edge but loops, so the walks go on at every length (and saturate on dense graphs)
+static Edges randomGraph(size_t verticesCount, double density, uint64_t seed)
+{
+	std::mt19937_64 twister(seed);
+	std::bernoulli_distribution present(density);
+
+	Edges edges;
+	for (size_t i = 0; i < verticesCount; i++)
+	for (size_t j = 0; j < verticesCount; j++)
+	{
+		if (i != j && present(twister))
+			edges.emplace_back(i, j);
+	}
+
+	return edges;
+}
+
+// uncached powers of the adjacency matrix, counts and which pairs they connect. Modular
+// counts can be 0 for connected pairs, so only the boolean power tells those apart
+static std::pair<linear_algebra::CountMatrix, linear_algebra::BitMatrix> adjacencyPowers(size_t verticesCount, const Edges& edges, uint64_t length, uint64_t modulus)
+{
+	linear_algebra::CountMatrix adjacency(verticesCount);
+	linear_algebra::BitMatrix adjacencyBits(verticesCount);
+	for (const auto& [from, to] : edges)
+	{
+		adjacency.set(from, to, 1);
+		adjacencyBits.set(from, to, true);
+	}
+
+	return { linear_algebra::pow(adjacency, length, { modulus }), linear_algebra::pow(adjacencyBits, length) };
+}
+
+// the walks forEachWalk should visit
+static WalkCounts powerWalks(size_t verticesCount, const Edges& edges, uint64_t length, uint64_t modulus)
+{
+	auto [counts, reach] = adjacencyPowers(verticesCount, edges, length, modulus);
+
+	WalkCounts walks;
+	for (size_t i = 0; i < verticesCount; i++)
+	for (size_t j = 0; j < verticesCount; j++)
+	{
+		if (i != j && reach.get(i, j))
+			walks[{ i, j }] = counts.get(i, j);
+	}
+
+	return walks;
+}
+
+TEST(Digraph, WalkCacheMatchesUncachedPowers)
+{
+	const std::pair<size_t, double> shapes[] = { { 24, 0.3 }, { 90, 0.03 } };
+	const std::vector<uint64_t> orders[] = {
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8 },
+		{ 64, 33, 32, 17, 5, 4, 1, 0 },
+		{ 5, 1, 3, 3, 64, 0, 2, 40, 17, 16, 33, 4, 5 }
+	};
+
+	for (const auto& [verticesCount, density] : shapes)
+	for (uint64_t modulus : { 0ull, 13ull })
+	{
+		Edges edges = randomGraph(verticesCount, density, verticesCount);
+
+		std::map<uint64_t, WalkCounts> expected;
+		for (const std::vector<uint64_t>& lengths : orders)
+		for (uint64_t length : lengths)
+		{
+			if (!expected.count(length))
+				expected[length] = powerWalks(verticesCount, edges, length, modulus);
+		}
+
+		// nothing cached, room for a sparse matrix or two (but no dense one) and the default
+		for (size_t budget : { size_t(0), size_t(4096), linear_algebra::DEFAULT_POWER_CACHE_BUDGET })
+		{
+			SCOPED_TRACE(testing::Message() << verticesCount << " vertices, modulus " << modulus << ", budget " << budget);
+
+			Digraph digraph = loadDigraph(verticesCount, edges, modulus);
+			digraph.setWalkCacheBudget(budget);
+
+			for (const std::vector<uint64_t>& lengths : orders)
+			{
+				for (uint64_t length : lengths)
+					EXPECT_EQ(walksOf(digraph, length), expected[length]) << "length " << length;
+			}
+		}
+	}
+}
+
+// the matrix products the profiler counted in its last recording
+static uint64_t recordedMultiplies()
+{
+	std::string path = tempPath("digraph_test_trace.json");
+	profiling::writeChromeTrace(path);
+
+	std::ifstream file(path);
+	nlohmann::json trace = nlohmann::json::parse(file);
+	file.close();
+	std::filesystem::remove(path);
+
+	uint64_t multiplies = 0;
+	for (const nlohmann::json& event : trace["traceEvents"])
+	{
+		if (event["ph"] == "C")
+			multiplies = event["args"]["matrix multiplies"];
+	}
+
+	return multiplies;
+}
+
+TEST(Digraph, UncachedWalksSquareEachRungOnce)
+{
+	if (!profiling::isAvailable())
+		GTEST_SKIP() << "built without DIGRAPH_PROFILING";
+
+	// dense walks take a product of the counts and one of the boolean walk, sparse ones only the first
+	const std::tuple<size_t, double, uint64_t> shapes[] = { { 24, 0.3, 2 }, { 90, 0.03, 1 } };
+
+	for (const auto& [verticesCount, density, productsPerStep] : shapes)
+	{
+		SCOPED_TRACE(testing::Message() << verticesCount << " vertices");
+
+		Digraph digraph = loadDigraph(verticesCount, randomGraph(verticesCount, density, verticesCount));
+		digraph.setWalkCacheBudget(0);
+
+		// 8 rungs, every one of them used: under 8 squarings and 8 steps of the product.
+		// Climbing every rung from A again would take over twice as many
+		profiling::start();
+		digraph.forEachWalk(255, [](size_t, size_t, uint64_t) {});
+		profiling::stop();
+
+		EXPECT_LE(recordedMultiplies(), productsPerStep * 2 * 8);
+	}
+}
+
+TEST(Digraph, WalksFromOneVertexMatchPowerRows)
+{
+	const std::pair<size_t, double> shapes[] = { { 24, 0.3 }, { 90, 0.03 } };
+
+	for (const auto& [verticesCount, density] : shapes)
+	for (uint64_t modulus : { 0ull, 13ull })
+	{
+		SCOPED_TRACE(testing::Message() << verticesCount << " vertices, modulus " << modulus);
+
+		// the last vertex has no edges out of it
+		size_t sink = verticesCount - 1;
+		Edges edges = randomGraph(verticesCount, density, verticesCount + 1);
+		std::erase_if(edges, [&](const std::pair<size_t, size_t>& edge) { return edge.first == sink; });
+
+		Digraph digraph = loadDigraph(verticesCount, edges, modulus);
+
+		// vector products first, then rows of the cached powers. Past the vertex count
+		// the full power gets built either way
+		const uint64_t lengths[] = { 0, 1, 2, 3, 7, verticesCount + 3 };
+		for (bool cached : { false, true })
+		{
+			if (cached)
+			{
+				for (uint64_t length : lengths)
+					digraph.forEachWalk(length, [](size_t, size_t, uint64_t) {});
+			}
+
+			for (uint64_t length : lengths)
+			{
+				auto [counts, reach] = adjacencyPowers(verticesCount, edges, length, modulus);
+
+				for (size_t source : { size_t(0), verticesCount / 2, sink })
+				{
+					std::map<size_t, uint64_t> expected, walks;
+					for (size_t j = 0; j < verticesCount; j++)
+					{
+						if (reach.get(source, j))
+							expected[j] = counts.get(source, j);
+					}
+
+					digraph.forEachWalkFrom(source, length, [&](size_t to, uint64_t count) { walks[to] = count; });
+					EXPECT_EQ(walks, expected) << "from " << source << ", length " << length << (cached ? ", cached" : "");
+
+					for (size_t to = 0; to < verticesCount; to++)
+					{
+						std::optional<uint64_t> count = digraph.countWalksBetween(source, to, length);
+						EXPECT_EQ(count, expected.count(to) ? std::optional(expected[to]) : std::nullopt) << source << " -> " << to << ", length " << length;
+					}
+				}
+			}
+		}
+
+		// nothing leads out of the sink but the walk of no steps
+		std::map<size_t, uint64_t> fromSink;
+		digraph.forEachWalkFrom(sink, 1, [&](size_t to, uint64_t count) { fromSink[to] = count; });
+		EXPECT_TRUE(fromSink.empty());
+		EXPECT_EQ(digraph.countWalksBetween(sink, sink, 0), 1u);
+	}
+}
+
+TEST(Digraph, ReachabilityFile)
+{
+	Digraph digraph = loadDigraph(4, { { 0, 1 }, { 1, 2 }, { 2, 3 } });
+	std::string path = tempPath("digraph_test.reach");
+	std::filesystem::remove(path);
+
+	// built and saved first, read back after
+	EXPECT_FALSE(digraph.useReachabilityFile(path));
+	EXPECT_TRUE(digraph.useReachabilityFile(path));
+	EXPECT_TRUE(loadDigraph(4, { { 0, 1 }, { 1, 2 }, { 2, 3 } }).useReachabilityFile(path));
+
+	// a stale index gets replaced
+	Digraph other = loadDigraph(4, { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 } });
+	EXPECT_FALSE(other.useReachabilityFile(path));
+	EXPECT_TRUE(other.canReach(3, 1));
+	EXPECT_TRUE(other.useReachabilityFile(path));
+
+	// a file that isn't an index survives
+	const std::string unrelated = R"({ "vertices": [ "a" ], "edges": [] })";
+	std::ofstream(path, std::ios::trunc) << unrelated;
+	EXPECT_THROW(digraph.useReachabilityFile(path), std::runtime_error);
+
+	std::ifstream file(path);
+	EXPECT_EQ(std::string(std::istreambuf_iterator<char>(file), {}), unrelated);
+	file.close();
+
+	std::filesystem::remove(path);
+}
+
+static std::string readAll(std::FILE* file)
+{
+	std::string text;
+	char chunk[4096];
+
+	std::rewind(file);
+	for (size_t read; (read = std::fread(chunk, 1, sizeof(chunk), file)) != 0; )
+		text.append(chunk, read);
+
+	return text;
+}
+
+TEST(Digraph, ResultOutput)
+{
+	Digraph digraph = loadDigraph(4, { { 0, 1 }, { 1, 2 }, { 0, 2 }, { 2, 3 } });
+
+	for (bool countsOnly : { false, true })
+	{
+		std::FILE* file = std::tmpfile();
+		ASSERT_NE(file, nullptr);
+
+		digraph.setResultOutput(file, countsOnly);
+		digraph.findAllPathsWithLength(2);
+		digraph.findPathsFrom("v0", 2);
+		digraph.findPathsBetween("v0", "v3", 2);
+		digraph.findPathsBetween("v3", "v0", 2);
+		digraph.findPathsFrom("nobody", 2);
+		digraph.findPathsBetween("v0", "nobody", 2);
+
+		if (countsOnly)
+		{
+			EXPECT_EQ(readAll(file),
+				"3 paths of length 2 were found!\n"
+				"2 paths of length 2 from v0 were found!\n"
+				"v0 is connected to v3 by paths of length 2\n"
+				"v3 is not connected to v0 by paths of length 2\n"
+				"There is no vertex nobody\n"
+				"There is no vertex nobody\n");
+		}
+		else
+		{
+			EXPECT_EQ(readAll(file),
+				"There are 1 paths of length 2 from v0 to v2\n"
+				"There are 1 paths of length 2 from v0 to v3\n"
+				"There are 1 paths of length 2 from v1 to v3\n"
+				"3 paths of length 2 were found!\n"
+				"There are 1 paths of length 2 from v0 to v2\n"
+				"There are 1 paths of length 2 from v0 to v3\n"
+				"2 paths of length 2 from v0 were found!\n"
+				"There are 1 paths of length 2 from v0 to v3\n"
+				"There are no paths of length 2 from v3 to v0\n"
+				"There is no vertex nobody\n"
+				"There is no vertex nobody\n");
+		}
+
+		std::fclose(file);
+	}
+
+	digraph.setResultOutput(stdout);
+}
+
+TEST(Digraph, ResultOutputInChunks)
+{
+	// every pair of a complete graph, a couple of MiB of lines written a chunk at a time
+	const size_t verticesCount = 200;
+	Edges edges = randomGraph(verticesCount, 1.0, 0);
+	Digraph digraph = loadDigraph(verticesCount, edges, 13);
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+
+	digraph.setResultOutput(file);
+	digraph.findAllPathsWithLength(2);
+	digraph.setResultOutput(stdout);
+
+	std::string text = readAll(file);
+	std::fclose(file);
+
+	// 198 walks of two steps between any two vertices
+	size_t pairs = verticesCount * (verticesCount - 1);
+	EXPECT_EQ(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')), pairs + 1);
+	EXPECT_NE(text.find("There are 3 (mod 13) paths of length 2 from v199 to v198\n"), std::string::npos);
+	EXPECT_TRUE(text.ends_with(fmt::format("{} paths of length 2 were found!\n", pairs)));
+}
\ No newline at end of file
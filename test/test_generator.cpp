@@ -0,0 +1,200 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include "Generator.h"
+#include "Components.h"
+#include "ThreadPool.h"
+
+using namespace generator;
+
+static std::vector<graph::Edge> allEdges(const Parameters& params)
+{
+	std::vector<graph::Edge> result, block;
+	for (uint64_t b = 0; b < blockCount(params); b++)
+	{
+		generateBlock(params, b, block);
+		result.insert(result.end(), block.begin(), block.end());
+	}
+
+	return result;
+}
+
+static std::string writeText(const Parameters& params, graph::GraphFormat format)
+{
+	std::ostringstream output;
+	writeGraph(params, format, output);
+	return output.str();
+}
+
+TEST(Generator, SameSeedSameGraphOnAnyThreadCount)
+{
+	Parameters params;
+	params.model = Model::RMat;
+	params.vertices = 1000;
+	params.edges = 3 * BLOCK_EDGES + 123;
+	params.seed = 42;
+
+	linear_algebra::setThreadCount(1);
+	std::string serial = writeText(params, graph::GraphFormat::EdgeList);
+	linear_algebra::setThreadCount(4);
+	std::string parallel = writeText(params, graph::GraphFormat::EdgeList);
+	linear_algebra::setThreadCount(0);
+
+	EXPECT_EQ(serial, parallel);
+	EXPECT_EQ(std::count(serial.begin(), serial.end(), '\n'), static_cast<std::ptrdiff_t>(params.edges));
+
+	params.seed = 43;
+	EXPECT_NE(serial, writeText(params, graph::GraphFormat::EdgeList));
+}
+
+TEST(Generator, EdgesStayInRangeWithoutSelfLoops)
+{
+	for (Model model : { Model::ErdosRenyi, Model::RMat, Model::LayeredDag, Model::PlantedCycles })
+	{
+		Parameters params;
+		params.model = model;
+		params.vertices = 77;
+		params.edges = 5000;
+		params.layers = 5;
+		params.cycles = 4;
+		params.cycleLength = 6;
+
+		std::vector<graph::Edge> edges = allEdges(params);
+		ASSERT_EQ(edges.size(), edgeCount(params));
+
+		for (const graph::Edge& edge : edges)
+		{
+			EXPECT_LT(edge.from, params.vertices);
+			EXPECT_LT(edge.to, params.vertices);
+			EXPECT_NE(edge.from, edge.to);
+		}
+	}
+}
+
+TEST(Generator, LayeredDagIsAcyclic)
+{
+	Parameters params;
+	params.model = Model::LayeredDag;
+	params.vertices = 500;
+	params.edges = 20000;
+	params.layers = 7;
+
+	graph::CSRGraph g = graph::CSRGraph::FromEdges(params.vertices, allEdges(params));
+	EXPECT_TRUE(graph::topologicalSort(g).acyclic);
+
+	// the last layer only has edges coming in
+	for (graph::Vertex v = 500 * 6 / 7; v < 500; v++)
+		EXPECT_TRUE(g.successors(v).empty());
+}
+
+TEST(Generator, PlantedCyclesAreTheOnlyCycles)
+{
+	Parameters params;
+	params.model = Model::PlantedCycles;
+	params.vertices = 300;
+	params.edges = 10000;
+	params.cycles = 5;
+	params.cycleLength = 4;
+
+	graph::CSRGraph g = graph::CSRGraph::FromEdges(params.vertices, allEdges(params));
+	graph::StronglyConnectedComponents scc = graph::stronglyConnectedComponents(g);
+	ASSERT_EQ(scc.getCyclicCount(), params.cycles);
+
+	for (uint32_t c = 0; c < scc.getComponentCount(); c++)
+	{
+		if (!scc.cyclic[c])
+			continue;
+
+		std::vector<graph::Vertex> members(scc.componentMembers(c).begin(), scc.componentMembers(c).end());
+		std::sort(members.begin(), members.end());
+
+		ASSERT_EQ(members.size(), params.cycleLength);
+		EXPECT_EQ(members.front() % params.cycleLength, 0u);
+		EXPECT_EQ(members.back(), members.front() + params.cycleLength - 1);
+	}
+}
+
+TEST(Generator, WritesFormatsTheLoaderReads)
+{
+	Parameters params;
+	params.vertices = 64;
+	params.edges = 400;
+
+	std::vector<graph::Edge> edges = allEdges(params);
+	graph::CSRGraph expected = graph::CSRGraph::FromEdges(params.vertices, edges);
+
+	std::istringstream json(writeText(params, graph::GraphFormat::Json));
+	graph::GraphDescription fromJson = graph::loadJson(json);
+	EXPECT_EQ(fromJson.vertices.size(), params.vertices);
+	EXPECT_EQ(graph::CSRGraph::FromEdges(params.vertices, fromJson.edges).targets().size(), expected.getEdgeCount());
+
+	graph::GraphDescription fromMtx = graph::loadMatrixMarket(writeText(params, graph::GraphFormat::MatrixMarket));
+	ASSERT_EQ(fromMtx.vertices.size(), params.vertices);
+	EXPECT_EQ(graph::CSRGraph::FromEdges(params.vertices, fromMtx.edges).getEdgeCount(), expected.getEdgeCount());
+
+	graph::GraphDescription fromCsv = graph::loadEdgeList(writeText(params, graph::GraphFormat::Csv), ',');
+	EXPECT_EQ(fromCsv.edges.size(), edges.size());
+	for (size_t i = 0; i < edges.size(); i++)
+	{
+		EXPECT_EQ(fromCsv.vertices[fromCsv.edges[i].from], std::to_string(edges[i].from));
+		EXPECT_EQ(fromCsv.vertices[fromCsv.edges[i].to], std::to_string(edges[i].to));
+	}
+}
+
+TEST(Generator, RejectsImpossibleGraphs)
+{
+	Parameters params;
+	params.vertices = 1;
+	EXPECT_THROW(validate(params), std::invalid_argument);
+
+	params.vertices = 10;
+	params.model = Model::LayeredDag;
+	params.layers = 11;
+	EXPECT_THROW(validate(params), std::invalid_argument);
+
+	params.model = Model::PlantedCycles;
+	params.cycles = 4;
+	params.cycleLength = 3;
+	EXPECT_THROW(validate(params), std::invalid_argument);
+
+	params.model = Model::RMat;
+	params.a = 0.9;
+	EXPECT_THROW(validate(params), std::invalid_argument);
+
+	// every cell on the diagonal
+	params.a = 1;
+	params.b = params.c = 0;
+	EXPECT_THROW(validate(params), std::invalid_argument);
+
+	params.a = 0;
+	EXPECT_THROW(validate(params), std::invalid_argument);
+
+	// valid, but next to nothing leaves the diagonal
+	params.b = 1e-12;
+	params.edges = 1;
+	EXPECT_NO_THROW(validate(params));
+
+	std::vector<graph::Edge> block;
+	EXPECT_THROW(generateBlock(params, 0, block), std::runtime_error);
+}
\ No newline at end of file
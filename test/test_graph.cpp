@@ -0,0 +1,353 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <random>
+#include "CSRGraph.h"
+#include "Reachability.h"
+#include "Components.h"
+#include "OnlineOrder.h"
+
+using namespace graph;
+
+static std::mt19937 graphTwister(std::random_device{}());
+
+static void expectValidOrder(const CSRGraph& g, const TopologicalOrder& result)
+{
+	ASSERT_TRUE(result.acyclic);
+	ASSERT_EQ(result.order.size(), g.getVertexCount());
+
+	std::vector<size_t> position(g.getVertexCount(), SIZE_MAX);
+	for (size_t i = 0; i < result.order.size(); i++)
+		position[result.order[i]] = i;
+
+	for (Vertex v = 0; v < g.getVertexCount(); v++)
+	{
+		ASSERT_NE(position[v], SIZE_MAX);
+		for (Vertex w : g.successors(v))
+			ASSERT_LT(position[v], position[w]);
+	}
+}
+
+static void expectValidCycle(const CSRGraph& g, const TopologicalOrder& result)
+{
+	ASSERT_FALSE(result.acyclic);
+	ASSERT_FALSE(result.cycle.empty());
+
+	for (size_t i = 0; i < result.cycle.size(); i++)
+		ASSERT_TRUE(g.hasEdge(result.cycle[i], result.cycle[(i + 1) % result.cycle.size()]));
+}
+
+TEST(CSRGraph, BuildsSortedUniqueAdjacency)
+{
+	CSRGraph g = CSRGraph::FromEdges(5, { { 3, 1 }, { 0, 4 }, { 0, 2 }, { 3, 1 }, { 0, 2 }, { 4, 4 } });
+
+	EXPECT_EQ(g.getVertexCount(), 5u);
+	EXPECT_EQ(g.getEdgeCount(), 4u);
+
+	auto list = g.successors(0);
+	ASSERT_EQ(list.size(), 2u);
+	EXPECT_EQ(list[0], 2u);
+	EXPECT_EQ(list[1], 4u);
+
+	EXPECT_TRUE(g.hasEdge(3, 1));
+	EXPECT_TRUE(g.hasEdge(4, 4));
+	EXPECT_FALSE(g.hasEdge(1, 3));
+	EXPECT_TRUE(g.successors(2).empty());
+
+	EXPECT_THROW(CSRGraph::FromEdges(2, { { 0, 2 } }), std::out_of_range);
+}
+
+TEST(CSRGraph, TopologicalSortOfDag)
+{
+	// random edges always pointing from a lower to a higher label of a shuffled labelling
+	size_t n = 2000;
+	std::vector<Vertex> label(n);
+	std::iota(label.begin(), label.end(), 0);
+	std::shuffle(label.begin(), label.end(), graphTwister);
+
+	std::uniform_int_distribution<Vertex> dist(0, static_cast<Vertex>(n - 1));
+	std::vector<Edge> edges;
+	for (size_t i = 0; i < 10 * n; i++)
+	{
+		Vertex a = dist(graphTwister), b = dist(graphTwister);
+		if (a != b)
+			edges.push_back({ label[std::min(a, b)], label[std::max(a, b)] });
+	}
+
+	CSRGraph g = CSRGraph::FromEdges(n, edges);
+	expectValidOrder(g, topologicalSort(g));
+}
+
+TEST(CSRGraph, FindsCycle)
+{
+	// a cycle hidden behind a DAG prefix, with a sink hanging off of it
+	CSRGraph g = CSRGraph::FromEdges(7, { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 2 }, { 4, 5 }, { 6, 0 } });
+	auto result = topologicalSort(g);
+
+	expectValidCycle(g, result);
+	EXPECT_EQ(result.cycle.size(), 3u);
+
+	CSRGraph selfLoop = CSRGraph::FromEdges(3, { { 0, 1 }, { 1, 1 } });
+	result = topologicalSort(selfLoop);
+	expectValidCycle(selfLoop, result);
+	EXPECT_EQ(result.cycle, std::vector<Vertex>{ 1 });
+}
+
+TEST(CSRGraph, LongChainDoesNotRecurse)
+{
+	size_t n = 1'000'000;
+	std::vector<Edge> edges;
+	for (Vertex v = 0; v + 1 < n; v++)
+		edges.push_back({ v, v + 1 });
+
+	CSRGraph chain = CSRGraph::FromEdges(n, edges);
+	expectValidOrder(chain, topologicalSort(chain));
+
+	edges.push_back({ static_cast<Vertex>(n - 1), 0 });
+	CSRGraph ring = CSRGraph::FromEdges(n, edges);
+	auto result = topologicalSort(ring);
+	expectValidCycle(ring, result);
+	EXPECT_EQ(result.cycle.size(), n);
+}
+
+// every vertex a depth first search gets to from v, v only through a cycle
+static std::vector<bool> searchReachable(const CSRGraph& g, Vertex v)
+{
+	std::vector<bool> seen(g.getVertexCount(), false);
+	std::vector<Vertex> stack(g.successors(v).begin(), g.successors(v).end());
+
+	while (!stack.empty())
+	{
+		Vertex w = stack.back();
+		stack.pop_back();
+
+		if (seen[w])
+			continue;
+
+		seen[w] = true;
+		for (Vertex x : g.successors(w))
+			stack.push_back(x);
+	}
+
+	return seen;
+}
+
+TEST(ReachabilityIndex, MatchesSearch)
+{
+	// 70 vertices fit into one 256-bit chunk per row, 300 take two
+	for (size_t n : { 1, 70, 300 })
+	{
+		std::uniform_int_distribution<Vertex> dist(0, static_cast<Vertex>(n - 1));
+		std::vector<Edge> edges;
+		for (size_t e = 0; e < n + n / 4; e++)
+			edges.push_back({ dist(graphTwister), dist(graphTwister) });
+
+		CSRGraph g = CSRGraph::FromEdges(n, edges);
+		ReachabilityIndex index = ReachabilityIndex::Build(g);
+		ASSERT_EQ(index.getVertexCount(), n);
+
+		for (Vertex v = 0; v < n; v++)
+		{
+			std::vector<bool> expected = searchReachable(g, v);
+			for (Vertex w = 0; w < n; w++)
+				ASSERT_EQ(index.reaches(v, w), expected[w]) << v << " -> " << w << " of " << n;
+		}
+	}
+}
+
+TEST(ReachabilityIndex, CondensedMatchesWarshall)
+{
+	// a few big cycles and many small ones joined by random edges
+	size_t n = 600;
+	std::uniform_int_distribution<Vertex> dist(0, static_cast<Vertex>(n - 1));
+	std::vector<Edge> edges;
+	for (Vertex v = 0; v < n; v++)
+	{
+		if (v % 100 != 99)
+			edges.push_back({ v, v % 7 == 6 ? v - 6 : v + 1 });
+	}
+
+	for (size_t e = 0; e < n / 2; e++)
+		edges.push_back({ dist(graphTwister), dist(graphTwister) });
+
+	CSRGraph g = CSRGraph::FromEdges(n, edges);
+	ReachabilityIndex warshall = ReachabilityIndex::BuildWarshall(g);
+	ReachabilityIndex condensed = ReachabilityIndex::BuildCondensed(g);
+
+	EXPECT_TRUE(std::equal(warshall.bits().begin(), warshall.bits().end(), condensed.bits().begin(), condensed.bits().end()));
+}
+
+TEST(ReachabilityIndex, SelfOnlyThroughCycle)
+{
+	CSRGraph g = CSRGraph::FromEdges(4, { { 0, 1 }, { 1, 2 }, { 2, 1 }, { 3, 3 } });
+	ReachabilityIndex index = ReachabilityIndex::Build(g);
+
+	EXPECT_FALSE(index.reaches(0, 0));
+	EXPECT_TRUE(index.reaches(0, 2));
+	EXPECT_TRUE(index.reaches(1, 1));
+	EXPECT_TRUE(index.reaches(3, 3));
+	EXPECT_FALSE(index.reaches(2, 0));
+	EXPECT_FALSE(index.reaches(3, 0));
+}
+
+TEST(Components, ComponentsAndCycles)
+{
+	// {0, 1, 2} and {4} (a self loop) have cycles, 3 and 5 don't
+	CSRGraph g = CSRGraph::FromEdges(6, { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 3 }, { 3, 4 }, { 4, 4 }, { 5, 0 } });
+	StronglyConnectedComponents components = stronglyConnectedComponents(g);
+
+	ASSERT_EQ(components.getComponentCount(), 4u);
+	EXPECT_EQ(components.getCyclicCount(), 2u);
+	EXPECT_EQ(components.component[0], components.component[1]);
+	EXPECT_EQ(components.component[0], components.component[2]);
+	EXPECT_NE(components.component[3], components.component[4]);
+
+	// every edge goes to the same or an earlier component
+	for (Vertex v = 0; v < 6; v++)
+	{
+		for (Vertex w : g.successors(v))
+			EXPECT_GE(components.component[v], components.component[w]);
+
+		std::span<const Vertex> members = components.componentMembers(components.component[v]);
+		EXPECT_NE(std::find(members.begin(), members.end(), v), members.end());
+	}
+
+	for (uint32_t c = 0; c < components.getComponentCount(); c++)
+	{
+		std::vector<Vertex> cycle = componentCycle(g, components, c);
+		ASSERT_EQ(cycle.empty(), !components.cyclic[c]);
+
+		for (size_t i = 0; i < cycle.size(); i++)
+		{
+			EXPECT_EQ(components.component[cycle[i]], c);
+			EXPECT_TRUE(g.hasEdge(cycle[i], cycle[(i + 1) % cycle.size()]));
+		}
+	}
+
+	CSRGraph dag = condensation(g, components);
+	EXPECT_EQ(dag.getVertexCount(), 4u);
+	EXPECT_EQ(dag.getEdgeCount(), 3u);
+	EXPECT_TRUE(topologicalSort(dag).acyclic);
+}
+
+TEST(Components, LongCycleDoesNotRecurse)
+{
+	// one component deeper than any call stack would allow
+	constexpr Vertex n = 1000000;
+	std::vector<Edge> edges;
+	edges.reserve(n);
+	for (Vertex v = 0; v < n; v++)
+		edges.push_back({ v, (v + 1) % n });
+
+	CSRGraph g = CSRGraph::FromEdges(n, edges);
+	StronglyConnectedComponents components = stronglyConnectedComponents(g);
+
+	ASSERT_EQ(components.getComponentCount(), 1u);
+	EXPECT_EQ(componentCycle(g, components, 0).size(), n);
+}
+
+TEST(CSRGraph, AddsAndRemovesEdges)
+{
+	CSRGraph g = CSRGraph::FromEdges(4, { { 0, 1 }, { 0, 3 }, { 2, 0 } });
+
+	CSRGraph added = g.withEdge(0, 2);
+	EXPECT_EQ(added.getEdgeCount(), 4u);
+	EXPECT_EQ(std::vector<Vertex>(added.successors(0).begin(), added.successors(0).end()), std::vector<Vertex>({ 1, 2, 3 }));
+	EXPECT_TRUE(added.hasEdge(2, 0));
+	EXPECT_EQ(g.getEdgeCount(), 3u);
+
+	CSRGraph removed = added.withoutEdge(0, 1);
+	EXPECT_EQ(std::vector<Vertex>(removed.successors(0).begin(), removed.successors(0).end()), std::vector<Vertex>({ 2, 3 }));
+	EXPECT_TRUE(removed.hasEdge(2, 0));
+
+	// nothing to change
+	EXPECT_EQ(removed.withEdge(2, 0).getEdgeCount(), removed.getEdgeCount());
+	EXPECT_EQ(removed.withoutEdge(1, 0).getEdgeCount(), removed.getEdgeCount());
+	EXPECT_THROW(g.withEdge(0, 4), std::out_of_range);
+}
+
+TEST(OnlineTopologicalOrder, FollowsInsertions)
+{
+	constexpr size_t n = 200;
+	std::uniform_int_distribution<Vertex> dist(0, n - 1);
+
+	CSRGraph g = CSRGraph::FromEdges(n, {});
+	OnlineTopologicalOrder order(topologicalSort(g).order);
+
+	size_t cycles = 0;
+	for (int step = 0; step < 600; step++)
+	{
+		Vertex from = dist(graphTwister);
+		Vertex to = dist(graphTwister);
+		if (g.hasEdge(from, to))
+			continue;
+
+		CSRGraph next = g.withEdge(from, to);
+		std::vector<Vertex> cycle = order.insertEdge(next, from, to);
+		ASSERT_EQ(cycle.empty(), topologicalSort(next).acyclic);
+
+		if (!cycle.empty())
+		{
+			// the cycle goes over the new edge, the graph stays as it was
+			for (size_t i = 0; i < cycle.size(); i++)
+				ASSERT_TRUE(next.hasEdge(cycle[i], cycle[(i + 1) % cycle.size()]));
+
+			cycles++;
+			continue;
+		}
+
+		g = next;
+		for (Vertex v = 0; v < n; v++)
+		{
+			ASSERT_EQ(order.order()[order.position(v)], v);
+			for (Vertex w : g.successors(v))
+				ASSERT_LT(order.position(v), order.position(w));
+		}
+	}
+
+	EXPECT_GT(cycles, 0u);
+}
+
+TEST(ReachabilityIndex, FollowsInsertions)
+{
+	constexpr size_t n = 150;
+	std::uniform_int_distribution<Vertex> dist(0, n - 1);
+
+	CSRGraph g = CSRGraph::FromEdges(n, {});
+	ReachabilityIndex index = ReachabilityIndex::Build(g);
+
+	for (int step = 0; step < 200; step++)
+	{
+		Vertex from = dist(graphTwister);
+		Vertex to = dist(graphTwister);
+
+		g = g.withEdge(from, to);
+		index = index.withEdge(from, to);
+
+		if (step % 20 == 0)
+		{
+			ReachabilityIndex rebuilt = ReachabilityIndex::Build(g);
+			ASSERT_TRUE(std::equal(index.bits().begin(), index.bits().end(), rebuilt.bits().begin(), rebuilt.bits().end())) << "after " << step;
+		}
+	}
+}
\ No newline at end of file
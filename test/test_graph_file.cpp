@@ -0,0 +1,183 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "GraphFile.h"
+
+using namespace graph;
+
+static std::string tempPath(const std::string& name)
+{
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(VertexTable, FindsEveryName)
+{
+	std::vector<std::string> names;
+	for (int i = 0; i < 1000; i++)
+		names.push_back(std::string("v").append(std::to_string(i * 7)));
+
+	VertexTable table = VertexTable::Build(names);
+	ASSERT_EQ(table.size(), names.size());
+
+	for (Vertex v = 0; v < names.size(); v++)
+	{
+		EXPECT_EQ(table.name(v), names[v]);
+		EXPECT_EQ(table.find(names[v]), v);
+	}
+
+	EXPECT_FALSE(table.find("v1").has_value());
+	EXPECT_FALSE(table.find("").has_value());
+	EXPECT_THROW(VertexTable::Build({ "a", "b", "a" }), std::invalid_argument);
+}
+
+TEST(GraphFile, RoundTrip)
+{
+	std::vector<std::string> names = { "A", "B", "", "a longer vertex name" };
+	CSRGraph csr = CSRGraph::FromEdges(4, { { 0, 1 }, { 1, 3 }, { 3, 0 }, { 3, 2 }, { 2, 2 } });
+	std::string path = tempPath("digraph_round_trip.bin");
+
+	saveBinaryGraph(path, VertexTable::Build(names), csr);
+	ASSERT_TRUE(isBinaryGraphFile(path));
+
+	{
+		BinaryGraph loaded = loadBinaryGraph(path);
+		ASSERT_EQ(loaded.graph.getVertexCount(), 4u);
+		ASSERT_EQ(loaded.graph.getEdgeCount(), csr.getEdgeCount());
+
+		for (Vertex v = 0; v < 4; v++)
+		{
+			auto expected = csr.successors(v);
+			auto actual = loaded.graph.successors(v);
+			EXPECT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin(), actual.end()));
+			EXPECT_EQ(loaded.vertices.name(v), names[v]);
+			EXPECT_EQ(loaded.vertices.find(names[v]), v);
+		}
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST(GraphFile, RejectsDamagedFiles)
+{
+	std::string path = tempPath("digraph_damaged.bin");
+	saveBinaryGraph(path, VertexTable::Build({ "x", "y" }), CSRGraph::FromEdges(2, { { 0, 1 } }));
+
+	// cut off the end of the name table
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+	EXPECT_THROW(loadBinaryGraph(path), std::runtime_error);
+
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << R"({ "vertices": [ "x" ] })";
+	}
+
+	EXPECT_FALSE(isBinaryGraphFile(path));
+	EXPECT_THROW(loadBinaryGraph(path), std::runtime_error);
+
+	std::filesystem::remove(path);
+}
+
+// overwrites one value of a saved file at an offset read from its header
+template <typename T>
+static void patchBinaryGraph(const std::string& path, uint64_t BinaryGraphHeader::* section, size_t index, T value)
+{
+	BinaryGraphHeader header;
+	{
+		std::ifstream file(path, std::ios::binary);
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	}
+
+	std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+	file.seekp(static_cast<std::streamoff>(header.*section + index * sizeof(T)));
+	file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+TEST(GraphFile, RejectsInconsistentArrays)
+{
+	std::string path = tempPath("digraph_inconsistent.bin");
+	auto save = [&]()
+	{
+		saveBinaryGraph(path, VertexTable::Build({ "x", "y", "z" }), CSRGraph::FromEdges(3, { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 2, 0 } }));
+		ASSERT_NO_THROW(loadBinaryGraph(path));
+	};
+
+	auto expectDamaged = [&]()
+	{
+		try
+		{
+			loadBinaryGraph(path);
+			FAIL();
+		}
+		catch (const std::runtime_error& e)
+		{
+			EXPECT_STREQ(e.what(), "Binary graph is truncated or damaged");
+		}
+	};
+
+	// a target past the vertices
+	save();
+	patchBinaryGraph<Vertex>(path, &BinaryGraphHeader::targetsAt, 0, 0x7fffffff);
+	expectDamaged();
+
+	// an adjacency list out of order
+	save();
+	patchBinaryGraph<Vertex>(path, &BinaryGraphHeader::targetsAt, 0, 2);
+	expectDamaged();
+
+	// edge offsets going backwards
+	save();
+	patchBinaryGraph<uint64_t>(path, &BinaryGraphHeader::offsetsAt, 1, 4);
+	expectDamaged();
+
+	// name offsets going backwards
+	save();
+	patchBinaryGraph<uint64_t>(path, &BinaryGraphHeader::nameOffsetsAt, 1, 3);
+	expectDamaged();
+
+	std::filesystem::remove(path);
+}
+
+TEST(GraphFile, ReachabilityBelongsToItsGraph)
+{
+	CSRGraph csr = CSRGraph::FromEdges(300, { { 0, 1 }, { 1, 299 }, { 299, 0 }, { 5, 6 } });
+	ReachabilityIndex index = ReachabilityIndex::Build(csr);
+	std::string path = tempPath("digraph_round_trip.reach");
+
+	saveReachability(path, index, csr);
+
+	{
+		std::optional<ReachabilityIndex> loaded = loadReachability(path, csr);
+		ASSERT_TRUE(loaded.has_value());
+		ASSERT_EQ(loaded->getVertexCount(), 300u);
+		EXPECT_TRUE(std::equal(index.bits().begin(), index.bits().end(), loaded->bits().begin(), loaded->bits().end()));
+	}
+
+	// one more edge makes it stale
+	EXPECT_FALSE(loadReachability(path, CSRGraph::FromEdges(300, { { 0, 1 }, { 1, 299 }, { 299, 0 }, { 5, 6 }, { 6, 7 } })).has_value());
+
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+	EXPECT_THROW(loadReachability(path, csr), std::runtime_error);
+
+	std::filesystem::remove(path);
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include "GraphLoader.h"
+
+using namespace graph;
+
+static GraphDescription loadString(const std::string& text)
+{
+	std::istringstream input(text);
+	return loadJson(input);
+}
+
+static std::string loadError(const std::string& text)
+{
+	try
+	{
+		loadString(text);
+	}
+	catch (const std::runtime_error& e)
+	{
+		return e.what();
+	}
+
+	return "";
+}
+
+TEST(GraphLoader, LoadsVerticesAndEdges)
+{
+	GraphDescription graph = loadString(R"({
+		"$comment": "Simple cycle with 3 vertices",
+		"vertices": [ "A", "B", "C" ],
+		"edges": [ { "from": "A", "to": "B" }, { "to": "C", "from": "B" }, { "from": "C", "to": "A" } ]
+	})");
+
+	ASSERT_EQ(graph.vertices, (std::vector<std::string>{ "A", "B", "C" }));
+
+	ASSERT_EQ(graph.edges.size(), 3u);
+	EXPECT_EQ(graph.edges[1].from, 1u);
+	EXPECT_EQ(graph.edges[1].to, 2u);
+	EXPECT_EQ(graph.edges[2].from, 2u);
+	EXPECT_EQ(graph.edges[2].to, 0u);
+}
+
+TEST(GraphLoader, EdgesBeforeVerticesAndUnknownProperties)
+{
+	GraphDescription graph = loadString(R"({
+		"edges": [ { "from": "y", "weight": [ 1, { "x": [] } ], "to": "x" } ],
+		"meta": { "vertices": [ 1, 2 ], "edges": null },
+		"vertices": [ "x", "y" ]
+	})");
+
+	ASSERT_EQ(graph.vertices.size(), 2u);
+	ASSERT_EQ(graph.edges.size(), 1u);
+	EXPECT_EQ(graph.edges[0].from, 1u);
+	EXPECT_EQ(graph.edges[0].to, 0u);
+}
+
+TEST(GraphLoader, ReportsMalformedFiles)
+{
+	EXPECT_EQ(loadError(R"({ "vertices": [ "A" ], )"), "File is not a valid json");
+	EXPECT_EQ(loadError(R"([ "A" ])"), "Vertices or edges properties are missing");
+	EXPECT_EQ(loadError(R"({ "vertices": [ "A" ] })"), "Vertices or edges properties are missing");
+	EXPECT_EQ(loadError(R"({ "vertices": "A", "edges": [] })"), "Vertices or edges should be defined as arrays of properties");
+	EXPECT_EQ(loadError(R"({ "vertices": [ "A" ], "edges": [] })"), "A graph described in file should have at least 2 vertices and 1 edge");
+	EXPECT_EQ(loadError(R"({ "vertices": [ "A" ], "edges": [ { "from": "A" } ] })"), "Missing \"from\" or \"to\" property in edge");
+	EXPECT_EQ(loadError(R"({ "vertices": [ "A" ], "edges": [ { "from": "A", "to": "B" } ] })"), "Nonexistent vertex specified in an edge description");
+	EXPECT_EQ(loadError(R"({ "edges": [ { "from": "A", "to": "B" } ], "vertices": [ "A" ] })"), "Nonexistent vertex specified in an edge description");
+	EXPECT_EQ(loadError(R"({ "vertices": [ "A", "A" ], "edges": [] })"), "Vertex \"A\" is defined more than once");
+}
+
+static std::vector<std::pair<std::string, std::string>> namedEdges(const GraphDescription& graph)
+{
+	std::vector<std::pair<std::string, std::string>> edges;
+	for (const Edge& edge : graph.edges)
+		edges.emplace_back(graph.vertices.at(edge.from), graph.vertices.at(edge.to));
+
+	return edges;
+}
+
+TEST(GraphLoader, EdgeListsWithNames)
+{
+	GraphDescription csv = loadEdgeList("# source,target,weight\nA,B,1.5\r\n \"B\" , C\n\nC,A,2\n", ',');
+	ASSERT_EQ(csv.vertices, (std::vector<std::string>{ "A", "B", "C" }));
+	EXPECT_EQ(namedEdges(csv), (std::vector<std::pair<std::string, std::string>>{ { "A", "B" }, { "B", "C" }, { "C", "A" } }));
+
+	GraphDescription tsv = loadEdgeList("new york\tboston\nboston\t7\n", '\t');
+	ASSERT_EQ(tsv.vertices, (std::vector<std::string>{ "new york", "boston", "7" }));
+	EXPECT_EQ(tsv.edges.size(), 2u);
+}
+
+TEST(GraphLoader, EdgeListsWithSparseIndices)
+{
+	// ids far past the edge count get renumbered instead of making every vertex up to them
+	GraphDescription sparse = loadEdgeList("0 4000000000\n4000000000 17\n", 0);
+	ASSERT_EQ(sparse.vertices, (std::vector<std::string>{ "0", "17", "4000000000" }));
+	EXPECT_EQ(namedEdges(sparse), (std::vector<std::pair<std::string, std::string>>{ { "0", "4000000000" }, { "4000000000", "17" } }));
+
+	GraphDescription largest = loadEdgeList("0 18446744073709551615\n", 0);
+	EXPECT_EQ(largest.vertices, (std::vector<std::string>{ "0", "18446744073709551615" }));
+
+	// a few ids without edges are still kept
+	EXPECT_EQ(loadEdgeList("0 1\n5 9\n", 0).vertices.size(), 10u);
+}
+
+TEST(GraphLoader, EdgeListsWithIndicesInChunks)
+{
+	std::string text = "% generated\n";
+	std::vector<Edge> expected;
+	for (Vertex v = 0; v < 500; v++)
+	{
+		Vertex w = (v * 37 + 11) % 600;
+		text += std::to_string(v) + "  \t" + std::to_string(w) + "\n";
+		expected.push_back({ v, w });
+	}
+
+	// small chunks, so the text is split between many tasks
+	GraphDescription graph = loadEdgeList(text, 0, 64);
+	ASSERT_EQ(graph.vertices.size(), 600u);
+	EXPECT_EQ(graph.vertices[599], "599");
+	ASSERT_EQ(graph.edges.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		EXPECT_EQ(graph.edges[i].from, expected[i].from);
+		EXPECT_EQ(graph.edges[i].to, expected[i].to);
+	}
+
+	// the line number counts lines in every chunk before the failed one
+	text += "600\n";
+	try
+	{
+		loadEdgeList(text, 0, 64);
+		FAIL();
+	}
+	catch (const std::runtime_error& e)
+	{
+		EXPECT_STREQ(e.what(), "Edge should have a source and a target vertex (line 502)");
+	}
+}
+
+TEST(GraphLoader, MatrixMarket)
+{
+	GraphDescription graph = loadMatrixMarket(
+		"%%MatrixMarket matrix coordinate real symmetric\n"
+		"% comment\n"
+		"3 3 4\n"
+		"1 2 0.5\n"
+		"3 3 1\n"
+		"3 1 0\n"
+		"2 3 -2e3\n", 8);
+
+	ASSERT_EQ(graph.vertices, (std::vector<std::string>{ "1", "2", "3" }));
+	EXPECT_EQ(namedEdges(graph), (std::vector<std::pair<std::string, std::string>>{ { "1", "2" }, { "2", "1" }, { "3", "3" }, { "2", "3" }, { "3", "2" } }));
+
+	GraphDescription pattern = loadMatrixMarket("%%MatrixMarket matrix coordinate pattern general\n2 2 1\n2 1\n");
+	EXPECT_EQ(namedEdges(pattern), (std::vector<std::pair<std::string, std::string>>{ { "2", "1" } }));
+
+	EXPECT_THROW(loadMatrixMarket("%%MatrixMarket matrix array real general\n2 2\n1\n0\n0\n1\n"), std::runtime_error);
+	EXPECT_THROW(loadMatrixMarket("%%MatrixMarket matrix coordinate pattern general\n2 3 1\n1 3\n"), std::runtime_error);
+	EXPECT_THROW(loadMatrixMarket("%%MatrixMarket matrix coordinate pattern general\n2 2 2\n1 2\n"), std::runtime_error);
+	EXPECT_THROW(loadMatrixMarket("%%MatrixMarket matrix coordinate pattern general\n2 2 1\n1 3\n"), std::runtime_error);
+}
\ No newline at end of file
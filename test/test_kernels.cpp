@@ -0,0 +1,307 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <array>
+#include "SIMDMatrix.h"
+#include "CountMatrix.h"
+#include "Kernels.h"
+
+namespace kernels = linear_algebra::kernels;
+using SIMDMatrix = linear_algebra::SIMDMatrix;
+using CountMatrix = linear_algebra::CountMatrix;
+
+static std::mt19937_64 kernelTwister(std::random_device{}());
+
+static constexpr kernels::Isa ALL_ISAS[] = { kernels::Isa::Scalar, kernels::Isa::SSE42, kernels::Isa::AVX2, kernels::Isa::AVX512 };
+
+static SIMDMatrix genRandFloatMatrix(size_t rows, size_t cols)
+{
+	SIMDMatrix mat(rows, cols);
+	std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < cols; j++)
+		mat.set(i, j, dist(kernelTwister));
+
+	return mat;
+}
+
+static CountMatrix genRandCounts(size_t rows, size_t cols, uint64_t maxValue)
+{
+	CountMatrix mat(rows, cols);
+	std::uniform_int_distribution<uint64_t> dist(0, maxValue);
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < cols; j++)
+		mat.set(i, j, dist(kernelTwister));
+
+	return mat;
+}
+
+// runs fn once for every ISA this CPU supports, restoring the default afterwards
+template <typename Fn>
+static void forEachSupportedIsa(Fn&& fn)
+{
+	for (kernels::Isa isa : ALL_ISAS)
+	{
+		if (!kernels::isSupported(isa))
+			continue;
+
+		SCOPED_TRACE(kernels::isaName(isa));
+		kernels::selectIsa(isa);
+		fn();
+	}
+
+	kernels::selectIsa(kernels::detectIsa());
+}
+
+template <typename T>
+static linear_algebra::BasicSIMDMatrix<T> genRandTyped(size_t rows, size_t cols)
+{
+	linear_algebra::BasicSIMDMatrix<T> mat(rows, cols);
+	std::uniform_int_distribution<int> dist(std::is_signed_v<T> ? -100 : 0, 100);
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < cols; j++)
+		mat.set(i, j, static_cast<T>(dist(kernelTwister)));
+
+	return mat;
+}
+
+// product, sum and scaled copy of small integers, exact for every element type
+template <typename T>
+static void checkTypedKernels(size_t rows, size_t inner, size_t cols)
+{
+	using Product = typename linear_algebra::ProductOf<T>::type;
+
+	auto lhs = genRandTyped<T>(rows, inner);
+	auto rhs = genRandTyped<T>(inner, cols);
+
+	auto product = lhs * rhs;
+	auto sum = lhs + lhs;
+	auto scaled = lhs * 3;
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < cols; j++)
+	{
+		Product expected = 0;
+		for (size_t k = 0; k < inner; k++)
+			expected += static_cast<Product>(lhs.get(i, k)) * static_cast<Product>(rhs.get(k, j));
+
+		ASSERT_EQ(product.get(i, j), expected) << "at " << i << ", " << j;
+	}
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < inner; j++)
+	{
+		ASSERT_EQ(sum.get(i, j), static_cast<T>(lhs.get(i, j) * 2));
+		ASSERT_EQ(scaled.get(i, j), static_cast<T>(lhs.get(i, j) * 3));
+	}
+}
+
+TEST(Kernels, IsaNames)
+{
+	for (kernels::Isa isa : ALL_ISAS)
+	{
+		kernels::Isa parsed;
+		ASSERT_TRUE(kernels::parseIsa(kernels::isaName(isa), parsed));
+		EXPECT_EQ(parsed, isa);
+	}
+
+	kernels::Isa parsed;
+	EXPECT_FALSE(kernels::parseIsa("neon", parsed));
+	EXPECT_TRUE(kernels::isSupported(kernels::Isa::Scalar));
+	EXPECT_TRUE(kernels::isSupported(kernels::detectIsa()));
+}
+
+TEST(Kernels, FloatKernelsAgree)
+{
+	// odd shapes hit the column tails, an odd inner dimension the k tail of the AVX-512 kernel
+	std::vector<std::array<size_t, 3>> shapes = { { 5, 3, 7 }, { 13, 29, 41 }, { 150, 133, 170 } };
+
+	forEachSupportedIsa([&]()
+	{
+		for (auto [rows, inner, cols] : shapes)
+		{
+			SIMDMatrix lhs = genRandFloatMatrix(rows, inner);
+			SIMDMatrix rhs = genRandFloatMatrix(inner, cols);
+
+			SIMDMatrix simple, packed;
+			linear_algebra::multiplyInto(lhs, rhs, simple, linear_algebra::GemmKernel::Simple);
+			linear_algebra::multiplyInto(lhs, rhs, packed, linear_algebra::GemmKernel::Packed);
+
+			for (size_t i = 0; i < rows; i++)
+			for (size_t j = 0; j < cols; j++)
+			{
+				float expected = 0.0f;
+				for (size_t k = 0; k < inner; k++)
+					expected += lhs.get(i, k) * rhs.get(k, j);
+
+				ASSERT_NEAR(simple.get(i, j), expected, 1e-4f * inner);
+				ASSERT_NEAR(packed.get(i, j), expected, 1e-4f * inner);
+			}
+
+			SIMDMatrix sum = lhs + lhs;
+			SIMDMatrix scaled = lhs * 3;
+			for (size_t i = 0; i < rows; i++)
+			for (size_t j = 0; j < inner; j++)
+			{
+				ASSERT_FLOAT_EQ(sum.get(i, j), lhs.get(i, j) * 2.0f);
+				ASSERT_FLOAT_EQ(scaled.get(i, j), lhs.get(i, j) * 3.0f);
+			}
+		}
+	});
+}
+
+TEST(Kernels, CountKernelsAgree)
+{
+	// small counts, ones past 32 bits and ones that overflow, plus one modulus
+	std::vector<std::pair<uint64_t, linear_algebra::CountArithmetic>> cases = {
+		{ 5, {} }, { 1ull << 34, {} }, { std::numeric_limits<uint64_t>::max() / 3, {} }, { 1000000006, { 1000000007 } }
+	};
+
+	for (auto [maxValue, arithmetic] : cases)
+	{
+		// 7 columns leave a half register at the end of every AVX-512 row
+		CountMatrix lhs = genRandCounts(9, 30, maxValue);
+		CountMatrix rhs = genRandCounts(30, 7, maxValue);
+
+		kernels::selectIsa(kernels::Isa::Scalar);
+		CountMatrix expected;
+		linear_algebra::multiplyInto(lhs, rhs, expected, arithmetic);
+
+		forEachSupportedIsa([&]()
+		{
+			CountMatrix product;
+			linear_algebra::multiplyInto(lhs, rhs, product, arithmetic);
+
+			for (size_t i = 0; i < 9; i++)
+			for (size_t j = 0; j < 7; j++)
+				ASSERT_EQ(product.get(i, j), expected.get(i, j)) << "at " << i << ", " << j;
+		});
+	}
+}
+
+TEST(Kernels, TypedKernelsAgree)
+{
+	// 37 columns leave tails for every column group width, bytes wrap in the sum and the scale
+	forEachSupportedIsa([&]()
+	{
+		checkTypedKernels<double>(9, 23, 37);
+		checkTypedKernels<int32_t>(9, 23, 37);
+		checkTypedKernels<uint8_t>(9, 23, 37);
+		checkTypedKernels<uint64_t>(9, 23, 37);
+	});
+}
+
+TEST(Kernels, OrWordsAgree)
+{
+	// 12 words are one whole AVX-512 register and half of another
+	std::array<uint64_t, 12> src, dst;
+	for (size_t w = 0; w < src.size(); w++)
+	{
+		src[w] = kernelTwister();
+		dst[w] = kernelTwister();
+	}
+
+	forEachSupportedIsa([&]()
+	{
+		std::array<uint64_t, 12> out = dst;
+		kernels::active().orWords(src.data(), out.data(), out.size());
+
+		for (size_t w = 0; w < out.size(); w++)
+			ASSERT_EQ(out[w], src[w] | dst[w]) << "at " << w;
+	});
+}
+
+// count covers 160 bytes for every type: whole registers, then half of an AVX-512 one
+template <typename T>
+static void checkNonZeroScan(const kernels::ElementwiseKernels<T>& kernelTable)
+{
+	constexpr size_t count = 160 / sizeof(T);
+	std::array<T, count> src{};
+	std::array<uint64_t, (count + 63) / 64> mask;
+
+	EXPECT_FALSE(kernelTable.nonZeroMask(src.data(), mask.data(), count));
+	EXPECT_EQ(kernelTable.findNonZero(src.data(), count), count);
+
+	std::bernoulli_distribution sparse(0.05);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (sparse(kernelTwister))
+			src[i] = T(1);
+	}
+	src[count - 1] = std::is_floating_point_v<T> ? std::numeric_limits<T>::quiet_NaN() : T(-1);
+
+	ASSERT_TRUE(kernelTable.nonZeroMask(src.data(), mask.data(), count));
+	size_t first = count;
+	for (size_t i = 0; i < count; i++)
+	{
+		bool expected = i == count - 1 || src[i] != T(0);
+		ASSERT_EQ((mask[i / 64] >> (i % 64)) & 1, expected ? 1u : 0u) << "at " << i;
+		if (expected && first == count)
+			first = i;
+	}
+	EXPECT_EQ(kernelTable.findNonZero(src.data(), count), first);
+}
+
+TEST(Kernels, NonZeroScanAgrees)
+{
+	forEachSupportedIsa([&]()
+	{
+		const kernels::KernelTable& kernelTable = kernels::active();
+		checkNonZeroScan(kernelTable.f32);
+		checkNonZeroScan(kernelTable.f64);
+		checkNonZeroScan(kernelTable.i32);
+		checkNonZeroScan(kernelTable.u8);
+		checkNonZeroScan(kernelTable.u64);
+	});
+}
+
+TEST(Kernels, SaturatingElementwise)
+{
+	constexpr uint64_t big = std::numeric_limits<uint64_t>::max() / 2 + 1;
+
+	forEachSupportedIsa([&]()
+	{
+		CountMatrix counts(3, 5);
+		counts.set(0, 0, big);
+		counts.set(1, 4, 7);
+		counts.set(2, 2, 1ull << 40);
+
+		CountMatrix sum = counts + counts;
+		EXPECT_EQ(sum.get(0, 0), linear_algebra::COUNT_SATURATED);
+		EXPECT_EQ(sum.get(1, 4), 14u);
+
+		CountMatrix scaled = counts * (1ull << 30);
+		EXPECT_EQ(scaled.get(0, 0), linear_algebra::COUNT_SATURATED);
+		EXPECT_EQ(scaled.get(1, 4), 7ull << 30);
+		EXPECT_EQ(scaled.get(2, 2), linear_algebra::COUNT_SATURATED);
+
+		// a scalar past 32 bits goes through the scalar fallback
+		CountMatrix huge = counts * (1ull << 33);
+		EXPECT_EQ(huge.get(1, 4), 7ull << 33);
+		EXPECT_EQ(huge.get(0, 0), linear_algebra::COUNT_SATURATED);
+	});
+}
\ No newline at end of file
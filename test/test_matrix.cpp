@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 #include <random>
 #include "SIMDMatrix.h"
+#include "ThreadPool.h"
 
 static constexpr size_t MATRIX_SIZE_LIMIT = 51;
 using SIMDMatrix = linear_algebra::SIMDMatrix;
@@ -98,6 +99,21 @@ static SIMDMatrix genRandMatrix(size_t rows, size_t cols, float min, float max)
 	return mat;
 }
 
+static SIMDMatrix genRandAdjacencyMatrix(size_t size)
+{
+	SIMDMatrix mat(size);
+	std::bernoulli_distribution dist(0.3);
+
+	for (size_t i = 0; i < size; i++)
+	for (size_t j = 0; j < size; j++)
+	{
+		if (dist(mersenneTwister))
+			mat.set(i, j, 1.0f);
+	}
+
+	return mat;
+}
+
 TEST(SIMDMatrix, IdentityScalarMultiplication)
 {
 	for (size_t size = 2; size <= MATRIX_SIZE_LIMIT; size++)
@@ -209,4 +225,203 @@ TEST(SIMDMatrix, ScalarMultiplication)
 		for (size_t c = 0; c < res.getColCount(); c++)
 			EXPECT_NEAR(res.get(r, c), resCmp.get(r, c), 5e-3);
 	}
+}
+
+TEST(SIMDMatrix, MultiplyInto)
+{
+	for (size_t i = 2; i <= MATRIX_SIZE_LIMIT; i++)
+	{
+		SIMDMatrix mat1 = genRandMatrix(i, i, 0.0f, 10.0f);
+		SIMDMatrix mat2 = genRandMatrix(i, i, 0.0f, 10.0f);
+		SIMDMatrix resCmp = naiveMultiplication(mat1, mat2);
+
+		// run twice into the same output so stale contents would show up
+		SIMDMatrix res(i);
+		linear_algebra::multiplyInto(mat2, mat1, res);
+		linear_algebra::multiplyInto(mat1, mat2, res);
+
+		for (size_t r = 0; r < res.getRowCount(); r++)
+		for (size_t c = 0; c < res.getColCount(); c++)
+			EXPECT_NEAR(res.get(r, c), resCmp.get(r, c), 5e-3);
+	}
+
+	SIMDMatrix mat = SIMDMatrix::Identity(4);
+	EXPECT_THROW(linear_algebra::multiplyInto(mat, mat, mat), std::invalid_argument);
+}
+
+TEST(SIMDMatrix, MultiplyAddInto)
+{
+	for (auto kernel : { linear_algebra::GemmKernel::Simple, linear_algebra::GemmKernel::Packed })
+	for (size_t i = 3; i <= MATRIX_SIZE_LIMIT; i += 8)
+	{
+		SIMDMatrix mat1 = genRandMatrix(i, i + 5, 0.0f, 1.0f);
+		SIMDMatrix mat2 = genRandMatrix(i + 5, i + 2, 0.0f, 1.0f);
+		SIMDMatrix acc = genRandMatrix(i, i + 2, 0.0f, 1.0f);
+		SIMDMatrix resCmp = naiveAddition(naiveMultiplication(mat1, mat2), acc);
+
+		linear_algebra::multiplyAddInto(mat1, mat2, acc, kernel);
+
+		for (size_t r = 0; r < acc.getRowCount(); r++)
+		for (size_t c = 0; c < acc.getColCount(); c++)
+			EXPECT_NEAR(acc.get(r, c), resCmp.get(r, c), 1e-3 * i);
+	}
+
+	SIMDMatrix mat = SIMDMatrix::Identity(4);
+	SIMDMatrix wrongShape(4, 5);
+	EXPECT_THROW(linear_algebra::multiplyAddInto(mat, mat, wrongShape), std::invalid_argument);
+}
+
+TEST(SIMDMatrix, InPlaceOperators)
+{
+	// more rows than one in-place block, so *= has to stitch several of them together
+	SIMDMatrix mat1 = genRandMatrix(600, 40, 0.0f, 1.0f);
+	SIMDMatrix mat2 = genRandMatrix(40, 40, 0.0f, 1.0f);
+	SIMDMatrix mat3 = genRandMatrix(600, 40, 0.0f, 1.0f);
+
+	SIMDMatrix productCmp = naiveMultiplication(mat1, mat2);
+	SIMDMatrix sumCmp = naiveAddition(productCmp, mat3);
+
+	mat1 *= mat2;
+	for (size_t r = 0; r < mat1.getRowCount(); r++)
+	for (size_t c = 0; c < mat1.getColCount(); c++)
+		ASSERT_NEAR(mat1.get(r, c), productCmp.get(r, c), 1e-3 * 40);
+
+	mat1 += mat3;
+	for (size_t r = 0; r < mat1.getRowCount(); r++)
+	for (size_t c = 0; c < mat1.getColCount(); c++)
+		ASSERT_NEAR(mat1.get(r, c), sumCmp.get(r, c), 1e-3 * 40);
+
+	SIMDMatrix square = genRandMatrix(9, 9, 0.0f, 1.0f);
+	SIMDMatrix squareCmp = naiveMultiplication(square, square);
+	square *= square;
+	for (size_t r = 0; r < 9; r++)
+	for (size_t c = 0; c < 9; c++)
+		EXPECT_NEAR(square.get(r, c), squareCmp.get(r, c), 1e-3 * 9);
+
+	EXPECT_THROW(mat1 *= mat1, std::invalid_argument);
+}
+
+TEST(SIMDMatrix, Power)
+{
+	for (size_t size = 2; size <= MATRIX_SIZE_LIMIT; size += 7)
+	{
+		SIMDMatrix mat = genRandAdjacencyMatrix(size);
+		SIMDMatrix resCmp = SIMDMatrix::Identity(size);
+
+		for (uint64_t p = 0; p <= 6; p++)
+		{
+			SIMDMatrix res = linear_algebra::pow(mat, p);
+
+			for (size_t r = 0; r < size; r++)
+			for (size_t c = 0; c < size; c++)
+				EXPECT_FLOAT_EQ(res.get(r, c), resCmp.get(r, c));
+
+			resCmp = naiveMultiplication(resCmp, mat);
+		}
+	}
+}
+
+TEST(SIMDMatrix, PackedMultiplication)
+{
+	auto check = [](size_t rows, size_t inner, size_t cols)
+	{
+		SIMDMatrix mat1 = genRandMatrix(rows, inner, 0.0f, 1.0f);
+		SIMDMatrix mat2 = genRandMatrix(inner, cols, 0.0f, 1.0f);
+
+		SIMDMatrix res;
+		linear_algebra::multiplyInto(mat1, mat2, res, linear_algebra::GemmKernel::Packed);
+		SIMDMatrix resCmp = naiveMultiplication(mat1, mat2);
+
+		ASSERT_EQ(res.getRowCount(), rows);
+		ASSERT_EQ(res.getColCount(), cols);
+
+		for (size_t r = 0; r < rows; r++)
+		for (size_t c = 0; c < cols; c++)
+			EXPECT_NEAR(res.get(r, c), resCmp.get(r, c), 1e-3 * inner);
+	};
+
+	for (size_t i = 1; i <= MATRIX_SIZE_LIMIT; i += 5)
+	for (size_t j = 1; j <= MATRIX_SIZE_LIMIT; j += 5)
+		check(i, j, MATRIX_SIZE_LIMIT + 1 - i);
+
+	// crosses the MC and KC block boundaries
+	check(301, 270, 133);
+}
+
+TEST(SIMDMatrix, StrassenMultiplication)
+{
+	// a low cutoff takes a few levels of recursion, odd shapes leave strips to peel off
+	size_t previousCutoff = linear_algebra::getStrassenCutoff();
+	linear_algebra::setStrassenCutoff(16);
+
+	auto check = [](size_t rows, size_t inner, size_t cols)
+	{
+		SIMDMatrix mat1 = genRandMatrix(rows, inner, 0.0f, 1.0f);
+		SIMDMatrix mat2 = genRandMatrix(inner, cols, 0.0f, 1.0f);
+
+		SIMDMatrix res;
+		linear_algebra::multiplyInto(mat1, mat2, res, linear_algebra::GemmKernel::Strassen);
+		SIMDMatrix resCmp = naiveMultiplication(mat1, mat2);
+
+		for (size_t r = 0; r < rows; r++)
+		for (size_t c = 0; c < cols; c++)
+			EXPECT_NEAR(res.get(r, c), resCmp.get(r, c), 1e-3 * inner);
+
+		// wrapping integers come out exactly as the classic product
+		linear_algebra::BasicSIMDMatrix<int32_t> int1(rows, inner), int2(inner, cols);
+		std::uniform_int_distribution<int32_t> dist(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+		for (size_t r = 0; r < rows; r++)
+		for (size_t c = 0; c < inner; c++)
+			int1.set(r, c, dist(mersenneTwister));
+		for (size_t r = 0; r < inner; r++)
+		for (size_t c = 0; c < cols; c++)
+			int2.set(r, c, dist(mersenneTwister));
+
+		linear_algebra::BasicSIMDMatrix<int32_t> strassen, classic;
+		linear_algebra::multiplyInto(int1, int2, strassen);
+		linear_algebra::multiplyInto(int1, int2, classic, linear_algebra::GemmKernel::Simple);
+
+		for (size_t r = 0; r < rows; r++)
+		for (size_t c = 0; c < cols; c++)
+			ASSERT_EQ(strassen.get(r, c), classic.get(r, c)) << "at " << r << ", " << c;
+	};
+
+	check(64, 64, 64);
+	check(150, 133, 141);
+	check(37, 200, 90);
+
+	linear_algebra::setStrassenCutoff(previousCutoff);
+}
+
+TEST(SIMDMatrix, ParallelOperations)
+{
+	linear_algebra::setThreadCount(4);
+
+	for (auto kernel : { linear_algebra::GemmKernel::Simple, linear_algebra::GemmKernel::Packed })
+	{
+		SIMDMatrix mat1 = genRandMatrix(203, 190, 0.0f, 1.0f);
+		SIMDMatrix mat2 = genRandMatrix(190, 345, 0.0f, 1.0f);
+
+		SIMDMatrix res;
+		linear_algebra::multiplyInto(mat1, mat2, res, kernel);
+		SIMDMatrix resCmp = naiveMultiplication(mat1, mat2);
+
+		for (size_t r = 0; r < res.getRowCount(); r++)
+		for (size_t c = 0; c < res.getColCount(); c++)
+			EXPECT_NEAR(res.get(r, c), resCmp.get(r, c), 1e-3 * 190);
+	}
+
+	SIMDMatrix mat1 = genRandMatrix(700, 600, 0.0f, 10.0f);
+	SIMDMatrix mat2 = genRandMatrix(700, 600, 0.0f, 10.0f);
+	SIMDMatrix sum = mat1 + mat2;
+	SIMDMatrix scaled = mat1 * 3.0f;
+
+	for (size_t r = 0; r < mat1.getRowCount(); r++)
+	for (size_t c = 0; c < mat1.getColCount(); c++)
+	{
+		EXPECT_FLOAT_EQ(sum.get(r, c), mat1.get(r, c) + mat2.get(r, c));
+		EXPECT_FLOAT_EQ(scaled.get(r, c), mat1.get(r, c) * 3.0f);
+	}
+
+	linear_algebra::setThreadCount(0);
 }
\ No newline at end of file
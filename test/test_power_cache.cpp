@@ -0,0 +1,89 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include "PowerCache.h"
+
+using namespace linear_algebra;
+
+TEST(PowerCache, FindsExactAndLowerPowers)
+{
+	PowerCache<int> cache;
+	cache.insert(1, std::make_shared<const int>(1), 8);
+	cache.insert(4, std::make_shared<const int>(4), 8);
+	cache.insert(0, std::make_shared<const int>(0), 8);
+
+	EXPECT_EQ(*cache.find(4), 4);
+	EXPECT_EQ(cache.find(3), nullptr);
+
+	uint64_t found = 0;
+	EXPECT_EQ(*cache.findBelow(3, found), 1);
+	EXPECT_EQ(found, 1u);
+	EXPECT_EQ(*cache.findBelow(100, found), 4);
+	EXPECT_EQ(found, 4u);
+
+	// the identity is no base for anything
+	PowerCache<int> identityOnly;
+	identityOnly.insert(0, std::make_shared<const int>(0), 8);
+	EXPECT_EQ(identityOnly.findBelow(5, found), nullptr);
+}
+
+TEST(PowerCache, EvictsLeastRecentlyUsed)
+{
+	PowerCache<int> cache(300);
+	for (uint64_t exponent = 1; exponent <= 3; exponent++)
+		cache.insert(exponent, std::make_shared<const int>(static_cast<int>(exponent)), 100);
+
+	// 1 becomes the most recently used, so 2 goes first
+	ASSERT_NE(cache.find(1), nullptr);
+	cache.insert(4, std::make_shared<const int>(4), 100);
+
+	EXPECT_EQ(cache.find(2), nullptr);
+	EXPECT_NE(cache.find(1), nullptr);
+	EXPECT_NE(cache.find(3), nullptr);
+	EXPECT_EQ(cache.getBytes(), 300u);
+
+	// too big to keep at all
+	cache.insert(5, std::make_shared<const int>(5), 301);
+	EXPECT_EQ(cache.find(5), nullptr);
+	EXPECT_EQ(cache.getEntryCount(), 3u);
+
+	// an evicted power stays valid for whoever holds it
+	std::shared_ptr<const int> held = cache.find(4);
+	cache.setBudget(0);
+	EXPECT_EQ(cache.getEntryCount(), 0u);
+	EXPECT_EQ(*held, 4);
+}
+
+TEST(PowerCache, ListsAndErasesExponents)
+{
+	PowerCache<int> cache;
+	for (uint64_t exponent : { 8, 1, 3 })
+		cache.insert(exponent, std::make_shared<const int>(static_cast<int>(exponent)), 8);
+
+	EXPECT_EQ(cache.exponents(), std::vector<uint64_t>({ 1, 3, 8 }));
+
+	cache.erase(3);
+	cache.erase(5);
+	EXPECT_EQ(cache.exponents(), std::vector<uint64_t>({ 1, 8 }));
+	EXPECT_EQ(cache.getBytes(), 16u);
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include "Profiler.h"
+#include "SIMDMatrix.h"
+
+using namespace linear_algebra;
+
+TEST(Profiler, CountsProductsAndTimesThem)
+{
+	if (!profiling::isAvailable())
+		GTEST_SKIP() << "built without DIGRAPH_PROFILING";
+
+	profiling::start();
+
+	SIMDMatrix lhs(40, 24), rhs(24, 40);
+	SIMDMatrix product = lhs * rhs;
+	SIMDMatrix sum = product + product;
+	profiling::stop();
+
+	std::string summary = profiling::summary();
+	EXPECT_NE(summary.find("gemm"), std::string::npos);
+	EXPECT_NE(summary.find("matrix multiplies"), std::string::npos);
+	EXPECT_NE(summary.find("peak resident matrix bytes"), std::string::npos);
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "digraph_test_trace.json";
+	profiling::writeChromeTrace(path.string());
+
+	std::ifstream file(path);
+	nlohmann::json trace = nlohmann::json::parse(file);
+	file.close();
+	std::filesystem::remove(path);
+
+	size_t gemms = 0;
+	for (const nlohmann::json& event : trace["traceEvents"])
+	{
+		if (event["ph"] == "X" && event["name"] == "gemm")
+			gemms++;
+
+		if (event["ph"] == "C")
+		{
+			EXPECT_EQ(event["args"]["matrix multiplies"], 1u);
+			EXPECT_GE(event["args"]["flops"], 2u * 40 * 24 * 40);
+			EXPECT_GT(event["args"]["matrix bytes allocated"], 0u);
+		}
+	}
+
+	EXPECT_EQ(gemms, 1u);
+}
+
+TEST(Profiler, NestedScopesCountTowardsTheirParents)
+{
+	if (!profiling::isAvailable())
+		GTEST_SKIP() << "built without DIGRAPH_PROFILING";
+
+	profiling::start();
+
+	SIMDMatrix mat(30, 30);
+	SIMDMatrix cube = linear_algebra::pow(mat, 3);
+	profiling::stop();
+
+	// "pow" holds both of its products, so it comes first (the longest total)
+	std::string summary = profiling::summary();
+	size_t powLine = summary.find("\npow ");
+	size_t gemmLine = summary.find("\ngemm ");
+	ASSERT_NE(powLine, std::string::npos);
+	ASSERT_NE(gemmLine, std::string::npos);
+	EXPECT_LT(powLine, gemmLine);
+}
\ No newline at end of file
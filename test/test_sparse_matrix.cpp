@@ -0,0 +1,140 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <random>
+#include "SparseMatrix.h"
+#include "ThreadPool.h"
+
+using SparseMatrix = linear_algebra::SparseMatrix;
+using SIMDMatrix = linear_algebra::SIMDMatrix;
+
+static std::mt19937 sparseTwister(std::random_device{}());
+
+static SIMDMatrix genRandSparseDense(size_t rows, size_t cols, double density)
+{
+	SIMDMatrix mat(rows, cols);
+	std::bernoulli_distribution present(density);
+	std::uniform_int_distribution<int> value(1, 4);
+
+	for (size_t i = 0; i < rows; i++)
+	for (size_t j = 0; j < cols; j++)
+	{
+		if (present(sparseTwister))
+			mat.set(i, j, static_cast<float>(value(sparseTwister)));
+	}
+
+	return mat;
+}
+
+static void expectEqual(const SparseMatrix& sparse, const SIMDMatrix& dense)
+{
+	ASSERT_EQ(sparse.getRowCount(), dense.getRowCount());
+	ASSERT_EQ(sparse.getColCount(), dense.getColCount());
+
+	size_t nonZero = 0;
+	for (size_t r = 0; r < dense.getRowCount(); r++)
+	for (size_t c = 0; c < dense.getColCount(); c++)
+	{
+		ASSERT_FLOAT_EQ(sparse.get(r, c), dense.get(r, c)) << "at " << r << ", " << c;
+		nonZero += dense.get(r, c) != 0.0f;
+	}
+
+	EXPECT_EQ(sparse.getNonZeroCount(), nonZero);
+}
+
+TEST(SparseMatrix, DenseRoundTrip)
+{
+	SIMDMatrix dense = genRandSparseDense(37, 81, 0.1);
+	SparseMatrix sparse = SparseMatrix::FromDense(dense);
+
+	expectEqual(sparse, dense);
+	expectEqual(SparseMatrix::FromDense(sparse.toDense()), dense);
+
+	size_t visited = 0;
+	sparse.forEachNonZero([&](size_t r, size_t c, float v)
+	{
+		EXPECT_FLOAT_EQ(dense.get(r, c), v);
+		visited++;
+	});
+	EXPECT_EQ(visited, sparse.getNonZeroCount());
+}
+
+TEST(SparseMatrix, Multiplication)
+{
+	for (size_t i = 1; i <= 60; i += 7)
+	for (size_t j = 1; j <= 60; j += 11)
+	for (double density : { 0.02, 0.2, 0.9 })
+	{
+		SIMDMatrix dense1 = genRandSparseDense(i, j, density);
+		SIMDMatrix dense2 = genRandSparseDense(j, 70 - i, density);
+
+		expectEqual(SparseMatrix::FromDense(dense1) * SparseMatrix::FromDense(dense2), dense1 * dense2);
+	}
+}
+
+TEST(SparseMatrix, ParallelMultiplication)
+{
+	linear_algebra::setThreadCount(4);
+
+	SIMDMatrix dense = genRandSparseDense(1500, 1500, 0.03);
+	SparseMatrix sparse = SparseMatrix::FromDense(dense);
+
+	expectEqual(sparse * sparse, dense * dense);
+
+	linear_algebra::setThreadCount(0);
+}
+
+TEST(SparseMatrix, VectorMultiplication)
+{
+	SIMDMatrix dense = genRandSparseDense(50, 23, 0.2);
+	SparseMatrix sparse = SparseMatrix::FromDense(dense);
+
+	std::vector<float> x(23), y(50);
+	std::iota(x.begin(), x.end(), 1.0f);
+	linear_algebra::multiplyInto(sparse, x, y);
+
+	for (size_t r = 0; r < 50; r++)
+	{
+		float expected = 0.0f;
+		for (size_t c = 0; c < 23; c++)
+			expected += dense.get(r, c) * x[c];
+
+		EXPECT_FLOAT_EQ(y[r], expected);
+	}
+}
+
+TEST(SparseMatrix, Power)
+{
+	SIMDMatrix dense(40);
+	std::bernoulli_distribution edge(0.05);
+	for (size_t i = 0; i < 40; i++)
+	for (size_t j = 0; j < 40; j++)
+	{
+		if (edge(sparseTwister))
+			dense.set(i, j, 1.0f);
+	}
+
+	SparseMatrix sparse = SparseMatrix::FromDense(dense);
+	for (uint64_t p = 0; p <= 9; p++)
+		expectEqual(linear_algebra::pow(sparse, p), linear_algebra::pow(dense, p));
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+//	MIT License
+//	
+//	Copyright(c) 2026 Jakub Bczyk
+//	
+//	Permission is hereby granted, free of charge, to any person obtaining a copy
+//	of this software and associated documentation files(the "Software"), to deal
+//	in the Software without restriction, including without limitation the rights
+//	to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+//	copies of the Software, and to permit persons to whom the Software is
+//	furnished to do so, subject to the following conditions :
+//	
+//	The above copyright notice and this permission notice shall be included in all
+//	copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+//	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//	SOFTWARE.
+
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+
+using ThreadPool = linear_algebra::ThreadPool;
+
+TEST(ThreadPool, VisitsEveryIndexOnce)
+{
+	ThreadPool pool(4);
+
+	for (size_t count : { 0, 1, 3, 4, 17, 1000, 100000 })
+	{
+		std::vector<std::atomic<uint32_t>> visits(count);
+		pool.parallelFor(count, [&](size_t i) { visits[i]++; });
+
+		for (size_t i = 0; i < count; i++)
+			ASSERT_EQ(visits[i].load(), 1u);
+	}
+}
+
+TEST(ThreadPool, UnevenTasksGetStolen)
+{
+	ThreadPool pool(4);
+	std::atomic<size_t> sum = 0;
+
+	// all the heavy indices land in the first slot, the other threads have to steal them
+	pool.parallelFor(64, [&](size_t i)
+	{
+		if (i < 16)
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		sum += i;
+	});
+
+	EXPECT_EQ(sum.load(), 64u * 63u / 2u);
+}
+
+TEST(ThreadPool, NestedCallsRunSerially)
+{
+	ThreadPool pool(3);
+	std::atomic<size_t> calls = 0;
+
+	pool.parallelFor(8, [&](size_t)
+	{
+		pool.parallelFor(8, [&](size_t) { calls++; });
+	});
+
+	EXPECT_EQ(calls.load(), 64u);
+}
+
+TEST(ThreadPool, RethrowsTaskException)
+{
+	ThreadPool pool(4);
+	EXPECT_THROW(pool.parallelFor(100, [](size_t i)
+	{
+		if (i == 57)
+			throw std::runtime_error("task failed");
+	}), std::runtime_error);
+
+	// pool stays usable afterwards
+	std::atomic<size_t> calls = 0;
+	pool.parallelFor(10, [&](size_t) { calls++; });
+	EXPECT_EQ(calls.load(), 10u);
+}
\ No newline at end of file